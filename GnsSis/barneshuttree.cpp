@@ -0,0 +1,530 @@
+#include "barneshuttree.h"
+#include "simdsincos.h"
+
+#include <QtConcurrent/QtConcurrentMap>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace {
+
+// eksen başına 21 bit: 63 bitlik Morton kodu, en fazla 21 seviye
+const int maxLevel = 21;
+// üst üç seviye 8^3 = 512 kovaya ayrılır; her kova ayrı iş parçacığında sıralanıp kurulur
+const int topLevels = 3;
+const int bucketCount = 1 << (3 * topLevels);
+const int chunkSize = 4096;
+// kuvvet hesabında iş parçacığı başına yaprak sayısı (~4096 cisim)
+const int leafChunkSize = 256;
+// yığın: her seviyede en çok 7 kardeş bekler
+const int stackSize = 8 * (maxLevel + 2);
+
+quint64 spreadBits(quint64 v)
+{
+    // 21 biti üçer bit aralıkla yay
+    v &= 0x1fffff;
+    v = (v | v << 32) & 0x1f00000000ffffULL;
+    v = (v | v << 16) & 0x1f0000ff0000ffULL;
+    v = (v | v << 8) & 0x100f00f00f00f00fULL;
+    v = (v | v << 4) & 0x10c30c30c30c30c3ULL;
+    v = (v | v << 2) & 0x1249249249249249ULL;
+    return v;
+}
+
+// level seviyesindeki sekizde bir: bit 2 = x, bit 1 = y, bit 0 = z
+int octant(quint64 code, int level)
+{
+    return int(code >> (60 - 3 * level)) & 7;
+}
+
+void childCenter(int octant, float quarter, float &x, float &y, float &z)
+{
+    x += (octant & 4) ? quarter : -quarter;
+    y += (octant & 2) ? quarter : -quarter;
+    z += (octant & 1) ? quarter : -quarter;
+}
+
+// Bir cismin etkileşim listesinden aldığı ivme (G çarpılmadan). Cismin kendisi listede
+// olabilir: d = 0 iken katkı sıfırdır (softening 0 ise bölme maskelenir).
+void sumScalar(float px, float py, float pz, const float *x, const float *y, const float *z, const float *m,
+               int count, float softening2, float &sumX, float &sumY, float &sumZ)
+{
+    for (int j = 0; j < count; ++j)
+    {
+        const float dx = x[j] - px, dy = y[j] - py, dz = z[j] - pz;
+        const float distance2 = dx * dx + dy * dy + dz * dz + softening2;
+        const float inverse = distance2 > 0.0f ? 1.0f / std::sqrt(distance2) : 0.0f;
+        const float strength = m[j] * inverse * inverse * inverse;
+        sumX += strength * dx;
+        sumY += strength * dy;
+        sumZ += strength * dz;
+    }
+}
+
+#if defined(GNSSIS_SIMD_X86)
+float horizontalSum(__m128 v)
+{
+    v = _mm_add_ps(v, _mm_movehl_ps(v, v));
+    v = _mm_add_ss(v, _mm_shuffle_ps(v, v, 1));
+    return _mm_cvtss_f32(v);
+}
+
+void sumSse(float px, float py, float pz, const float *x, const float *y, const float *z, const float *m,
+            int count, float softening2, float &sumX, float &sumY, float &sumZ)
+{
+    const __m128 bx = _mm_set1_ps(px), by = _mm_set1_ps(py), bz = _mm_set1_ps(pz);
+    const __m128 eps2 = _mm_set1_ps(softening2), one = _mm_set1_ps(1.0f), zero = _mm_setzero_ps();
+    __m128 accX = zero, accY = zero, accZ = zero;
+    int j = 0;
+    for (; j + 4 <= count; j += 4)
+    {
+        const __m128 dx = _mm_sub_ps(_mm_loadu_ps(x + j), bx);
+        const __m128 dy = _mm_sub_ps(_mm_loadu_ps(y + j), by);
+        const __m128 dz = _mm_sub_ps(_mm_loadu_ps(z + j), bz);
+        const __m128 distance2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)),
+                                            _mm_add_ps(_mm_mul_ps(dz, dz), eps2));
+        const __m128 inverse = _mm_and_ps(_mm_div_ps(one, _mm_sqrt_ps(distance2)), _mm_cmpgt_ps(distance2, zero));
+        const __m128 strength = _mm_mul_ps(_mm_loadu_ps(m + j), _mm_mul_ps(inverse, _mm_mul_ps(inverse, inverse)));
+        accX = _mm_add_ps(accX, _mm_mul_ps(strength, dx));
+        accY = _mm_add_ps(accY, _mm_mul_ps(strength, dy));
+        accZ = _mm_add_ps(accZ, _mm_mul_ps(strength, dz));
+    }
+    sumX += horizontalSum(accX);
+    sumY += horizontalSum(accY);
+    sumZ += horizontalSum(accZ);
+    sumScalar(px, py, pz, x + j, y + j, z + j, m + j, count - j, softening2, sumX, sumY, sumZ);
+}
+
+GNSSIS_TARGET_AVX2
+void sumAvx2(float px, float py, float pz, const float *x, const float *y, const float *z, const float *m,
+             int count, float softening2, float &sumX, float &sumY, float &sumZ)
+{
+    const __m256 bx = _mm256_set1_ps(px), by = _mm256_set1_ps(py), bz = _mm256_set1_ps(pz);
+    const __m256 eps2 = _mm256_set1_ps(softening2), one = _mm256_set1_ps(1.0f), zero = _mm256_setzero_ps();
+    __m256 accX = zero, accY = zero, accZ = zero;
+    int j = 0;
+    for (; j + 8 <= count; j += 8)
+    {
+        const __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(x + j), bx);
+        const __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(y + j), by);
+        const __m256 dz = _mm256_sub_ps(_mm256_loadu_ps(z + j), bz);
+        const __m256 distance2 = _mm256_fmadd_ps(dx, dx, _mm256_fmadd_ps(dy, dy, _mm256_fmadd_ps(dz, dz, eps2)));
+        const __m256 inverse = _mm256_and_ps(_mm256_div_ps(one, _mm256_sqrt_ps(distance2)),
+                                             _mm256_cmp_ps(distance2, zero, _CMP_GT_OQ));
+        const __m256 strength = _mm256_mul_ps(_mm256_loadu_ps(m + j),
+                                              _mm256_mul_ps(inverse, _mm256_mul_ps(inverse, inverse)));
+        accX = _mm256_fmadd_ps(strength, dx, accX);
+        accY = _mm256_fmadd_ps(strength, dy, accY);
+        accZ = _mm256_fmadd_ps(strength, dz, accZ);
+    }
+    sumX += horizontalSum(_mm_add_ps(_mm256_castps256_ps128(accX), _mm256_extractf128_ps(accX, 1)));
+    sumY += horizontalSum(_mm_add_ps(_mm256_castps256_ps128(accY), _mm256_extractf128_ps(accY, 1)));
+    sumZ += horizontalSum(_mm_add_ps(_mm256_castps256_ps128(accZ), _mm256_extractf128_ps(accZ, 1)));
+    sumScalar(px, py, pz, x + j, y + j, z + j, m + j, count - j, softening2, sumX, sumY, sumZ);
+}
+#endif
+
+#if defined(GNSSIS_SIMD_NEON)
+void sumNeon(float px, float py, float pz, const float *x, const float *y, const float *z, const float *m,
+             int count, float softening2, float &sumX, float &sumY, float &sumZ)
+{
+    const float32x4_t bx = vdupq_n_f32(px), by = vdupq_n_f32(py), bz = vdupq_n_f32(pz);
+    const float32x4_t eps2 = vdupq_n_f32(softening2), one = vdupq_n_f32(1.0f), zero = vdupq_n_f32(0.0f);
+    float32x4_t accX = zero, accY = zero, accZ = zero;
+    int j = 0;
+    for (; j + 4 <= count; j += 4)
+    {
+        const float32x4_t dx = vsubq_f32(vld1q_f32(x + j), bx);
+        const float32x4_t dy = vsubq_f32(vld1q_f32(y + j), by);
+        const float32x4_t dz = vsubq_f32(vld1q_f32(z + j), bz);
+        const float32x4_t distance2 = vfmaq_f32(vfmaq_f32(vfmaq_f32(eps2, dz, dz), dy, dy), dx, dx);
+        const uint32x4_t nonZero = vcgtq_f32(distance2, zero);
+        const float32x4_t inverse = vreinterpretq_f32_u32(
+            vandq_u32(vreinterpretq_u32_f32(vdivq_f32(one, vsqrtq_f32(distance2))), nonZero));
+        const float32x4_t strength = vmulq_f32(vld1q_f32(m + j), vmulq_f32(inverse, vmulq_f32(inverse, inverse)));
+        accX = vfmaq_f32(accX, strength, dx);
+        accY = vfmaq_f32(accY, strength, dy);
+        accZ = vfmaq_f32(accZ, strength, dz);
+    }
+    sumX += vaddvq_f32(accX);
+    sumY += vaddvq_f32(accY);
+    sumZ += vaddvq_f32(accZ);
+    sumScalar(px, py, pz, x + j, y + j, z + j, m + j, count - j, softening2, sumX, sumY, sumZ);
+}
+#endif
+
+std::vector<std::pair<int, int>> splitRanges(int count)
+{
+    std::vector<std::pair<int, int>> result;
+    for (int begin = 0; begin < count; begin += chunkSize)
+        result.emplace_back(begin, qMin(begin + chunkSize, count));
+    return result;
+}
+
+}
+
+void BarnesHutTree::build(const float *x, const float *y, const float *z, const float *mass, int count)
+{
+    nodes.clear();
+    leaves.clear();
+    rootIndex = -1;
+    keys.resize(count);
+    unsortedKeys.resize(count);
+    order.resize(count);
+    sortedX.resize(count);
+    sortedY.resize(count);
+    sortedZ.resize(count);
+    sortedMass.resize(count);
+    if (count == 0)
+        return;
+
+    // kök küp: tüm cisimleri içeren en küçük eksen hizalı küp
+    float minX = x[0], minY = y[0], minZ = z[0], maxX = x[0], maxY = y[0], maxZ = z[0];
+    for (int i = 1; i < count; ++i)
+    {
+        minX = qMin(minX, x[i]);
+        minY = qMin(minY, y[i]);
+        minZ = qMin(minZ, z[i]);
+        maxX = qMax(maxX, x[i]);
+        maxY = qMax(maxY, y[i]);
+        maxZ = qMax(maxZ, z[i]);
+    }
+    rootX = 0.5f * (minX + maxX);
+    rootY = 0.5f * (minY + maxY);
+    rootZ = 0.5f * (minZ + maxZ);
+    rootSize = qMax(qMax(maxX - minX, maxY - minY), maxZ - minZ) * 1.0001f;
+    if (rootSize <= 0.0f)
+        rootSize = 1.0f;
+
+    // Morton kodları
+    ranges = splitRanges(count);
+    const float cellScale = float(1 << maxLevel) / rootSize;
+    const float originX = rootX - 0.5f * rootSize, originY = rootY - 0.5f * rootSize, originZ = rootZ - 0.5f * rootSize;
+    QtConcurrent::blockingMap(ranges, [&](const std::pair<int, int> &range) {
+        const int last = (1 << maxLevel) - 1;
+        for (int i = range.first; i < range.second; ++i)
+        {
+            const quint64 qx = quint64(qBound(0, int((x[i] - originX) * cellScale), last));
+            const quint64 qy = quint64(qBound(0, int((y[i] - originY) * cellScale), last));
+            const quint64 qz = quint64(qBound(0, int((z[i] - originZ) * cellScale), last));
+            unsortedKeys[i] = { spreadBits(qx) << 2 | spreadBits(qy) << 1 | spreadBits(qz), i };
+        }
+    });
+
+    // üst 9 bite göre kovalara dağıt, her kovayı ayrı sırala
+    bucketStart.assign(bucketCount + 1, 0);
+    for (int i = 0; i < count; ++i)
+        ++bucketStart[int(unsortedKeys[i].first >> (63 - 3 * topLevels)) + 1];
+    std::partial_sum(bucketStart.begin(), bucketStart.end(), bucketStart.begin());
+    std::vector<int> next(bucketStart.begin(), bucketStart.end() - 1);
+    for (int i = 0; i < count; ++i)
+        keys[next[int(unsortedKeys[i].first >> (63 - 3 * topLevels))]++] = unsortedKeys[i];
+
+    std::vector<int> buckets(bucketCount);
+    std::iota(buckets.begin(), buckets.end(), 0);
+    QtConcurrent::blockingMap(buckets, [this](int bucket) {
+        std::sort(keys.begin() + bucketStart[bucket], keys.begin() + bucketStart[bucket + 1]);
+    });
+
+    QtConcurrent::blockingMap(ranges, [&](const std::pair<int, int> &range) {
+        for (int k = range.first; k < range.second; ++k)
+        {
+            const int i = keys[k].second;
+            order[k] = i;
+            sortedX[k] = x[i];
+            sortedY[k] = y[i];
+            sortedZ[k] = z[i];
+            sortedMass[k] = mass[i];
+        }
+    });
+
+    // kova alt ağaçları
+    bucketNodes.resize(bucketCount);
+    bucketRoot.assign(bucketCount, -1);
+    QtConcurrent::blockingMap(buckets, [this](int bucket) {
+        std::vector<Node> &subtree = bucketNodes[bucket];
+        subtree.clear();
+        if (bucketStart[bucket] == bucketStart[bucket + 1])
+            return;
+
+        float centerX = rootX, centerY = rootY, centerZ = rootZ;
+        for (int level = 0; level < topLevels; ++level)
+        {
+            const int cellOctant = (bucket >> (3 * (topLevels - 1 - level))) & 7;
+            childCenter(cellOctant, rootSize / float(4 << level), centerX, centerY, centerZ);
+        }
+        bucketRoot[bucket] = buildSubtree(subtree, bucketStart[bucket], bucketStart[bucket + 1], topLevels,
+                                          centerX, centerY, centerZ);
+    });
+
+    // alt ağaçları tek diziye taşı, çocuk indislerini kaydır
+    std::vector<int> bucketOffset(bucketCount + 1, 0);
+    for (int bucket = 0; bucket < bucketCount; ++bucket)
+        bucketOffset[bucket + 1] = bucketOffset[bucket] + int(bucketNodes[bucket].size());
+    nodes.resize(bucketOffset[bucketCount]);
+    QtConcurrent::blockingMap(buckets, [&](int bucket) {
+        const int offset = bucketOffset[bucket];
+        std::copy(bucketNodes[bucket].begin(), bucketNodes[bucket].end(), nodes.begin() + offset);
+        for (int n = offset; n < bucketOffset[bucket + 1]; ++n)
+        {
+            for (int &child : nodes[n].children)
+            {
+                if (child >= 0)
+                    child += offset;
+            }
+        }
+        if (bucketRoot[bucket] >= 0)
+            bucketRoot[bucket] += offset;
+    });
+
+    // üst seviyeler kovaların köklerine bağlanır; kök dizinin sonundadır
+    rootIndex = buildTop(0, count, 0, 0, rootX, rootY, rootZ);
+
+    // alt ağaçlar sırayla birleştirildiği için yapraklar zaten sıralı aralıklara göre dizili
+    leaves.clear();
+    for (int n = 0; n < int(nodes.size()); ++n)
+    {
+        if (nodes[n].bodyCount > 0)
+            leaves.push_back(n);
+    }
+}
+
+int BarnesHutTree::buildSubtree(std::vector<Node> &subtree, int begin, int end, int level,
+                                float centerX, float centerY, float centerZ) const
+{
+    const int index = int(subtree.size());
+    subtree.emplace_back();
+
+    Node node;
+    std::fill(std::begin(node.children), std::end(node.children), -1);
+    node.size = rootSize / float(1 << level);
+    node.firstBody = 0;
+    node.bodyCount = 0;
+
+    if (end - begin <= leafCapacity || level >= maxLevel)
+    {
+        node.firstBody = begin;
+        node.bodyCount = end - begin;
+    }
+    else
+    {
+        // aralık sıralı olduğu için her sekizde bir ardışık bir alt aralıktır
+        int first = begin;
+        for (int c = 0; c < 8 && first < end; ++c)
+        {
+            const int last = int(std::partition_point(keys.begin() + first, keys.begin() + end,
+                                                      [level, c](const std::pair<quint64, int> &key) {
+                                                          return octant(key.first, level) <= c;
+                                                      }) - keys.begin());
+            if (last > first)
+            {
+                float childX = centerX, childY = centerY, childZ = centerZ;
+                childCenter(c, 0.25f * node.size, childX, childY, childZ);
+                node.children[c] = buildSubtree(subtree, first, last, level + 1, childX, childY, childZ);
+            }
+            first = last;
+        }
+    }
+
+    finishNode(node, subtree, centerX, centerY, centerZ);
+    subtree[index] = node;
+    return index;
+}
+
+int BarnesHutTree::buildTop(int begin, int end, int level, int cell, float centerX, float centerY, float centerZ)
+{
+    if (begin == end)
+        return -1;
+    if (level == topLevels)
+        return bucketRoot[cell];
+
+    Node node;
+    std::fill(std::begin(node.children), std::end(node.children), -1);
+    node.size = rootSize / float(1 << level);
+    node.firstBody = 0;
+    node.bodyCount = 0;
+
+    // bir alt seviyedeki hücre, kovaların ardışık bir bloğudur
+    const int bucketsPerChild = 1 << (3 * (topLevels - level - 1));
+    for (int c = 0; c < 8; ++c)
+    {
+        const int child = cell * 8 + c;
+        float childX = centerX, childY = centerY, childZ = centerZ;
+        childCenter(c, 0.25f * node.size, childX, childY, childZ);
+        node.children[c] = buildTop(bucketStart[child * bucketsPerChild], bucketStart[(child + 1) * bucketsPerChild],
+                                    level + 1, child, childX, childY, childZ);
+    }
+
+    finishNode(node, nodes, centerX, centerY, centerZ);
+    nodes.push_back(node);
+    return int(nodes.size()) - 1;
+}
+
+void BarnesHutTree::finishNode(Node &node, const std::vector<Node> &pool, float centerX, float centerY, float centerZ) const
+{
+    double mass = 0.0, sumX = 0.0, sumY = 0.0, sumZ = 0.0;
+    if (node.bodyCount > 0)
+    {
+        for (int k = node.firstBody; k < node.firstBody + node.bodyCount; ++k)
+        {
+            mass += sortedMass[k];
+            sumX += double(sortedMass[k]) * sortedX[k];
+            sumY += double(sortedMass[k]) * sortedY[k];
+            sumZ += double(sortedMass[k]) * sortedZ[k];
+        }
+    }
+    else
+    {
+        for (int child : node.children)
+        {
+            if (child < 0)
+                continue;
+            const Node &c = pool[child];
+            mass += c.mass;
+            sumX += double(c.mass) * c.massX;
+            sumY += double(c.mass) * c.massY;
+            sumZ += double(c.mass) * c.massZ;
+        }
+    }
+
+    node.mass = float(mass);
+    if (mass > 0.0)
+    {
+        node.massX = float(sumX / mass);
+        node.massY = float(sumY / mass);
+        node.massZ = float(sumZ / mass);
+    }
+    else
+    {
+        node.massX = centerX;
+        node.massY = centerY;
+        node.massZ = centerZ;
+    }
+
+    const float dx = node.massX - centerX, dy = node.massY - centerY, dz = node.massZ - centerZ;
+    node.offset = std::sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+void BarnesHutTree::accelerations(float theta, float gravity, float softening, float *ax, float *ay, float *az) const
+{
+    static const SimdMath::Variant variant = SimdMath::best();
+    accelerations(variant, theta, gravity, softening, ax, ay, az);
+}
+
+void BarnesHutTree::accelerations(SimdMath::Variant variant, float theta, float gravity, float softening,
+                                  float *ax, float *ay, float *az) const
+{
+    if (!SimdMath::isSupported(variant))
+        variant = SimdMath::Scalar;
+    if (rootIndex < 0)
+        return;
+
+    // Kabul ölçütü |d| > size / theta + offset. theta <= 2/sqrt(3) iken cismin kendi hücresi
+    // hiçbir zaman tek kütle sayılmaz (kendi kendini çekmez); daha büyük değerler kırpılır.
+    theta = qBound(0.0f, theta, 1.15f);
+    const float openingFactor = theta > 0.0f ? 1.0f / theta : std::numeric_limits<float>::infinity();
+
+    std::vector<std::pair<int, int>> chunks;
+    for (int begin = 0; begin < int(leaves.size()); begin += leafChunkSize)
+        chunks.emplace_back(begin, qMin(begin + leafChunkSize, int(leaves.size())));
+    QtConcurrent::blockingMap(chunks, [&](const std::pair<int, int> &range) {
+        accelerateLeaves(variant, range.first, range.second, openingFactor, gravity, softening, ax, ay, az);
+    });
+}
+
+void BarnesHutTree::accelerateLeaves(SimdMath::Variant variant, int beginLeaf, int endLeaf, float openingFactor,
+                                     float gravity, float softening, float *ax, float *ay, float *az) const
+{
+    typedef void (*SumFunction)(float, float, float, const float *, const float *, const float *, const float *,
+                                int, float, float &, float &, float &);
+    SumFunction sum = sumScalar;
+#if defined(GNSSIS_SIMD_X86)
+    if (variant == SimdMath::Avx2)
+        sum = sumAvx2;
+    else if (variant == SimdMath::Sse)
+        sum = sumSse;
+#endif
+#if defined(GNSSIS_SIMD_NEON)
+    if (variant == SimdMath::Neon)
+        sum = sumNeon;
+#endif
+
+    const float softening2 = softening * softening;
+    int stack[stackSize];
+    // etkileşim listesi: kabul edilen düğümlerin kütle merkezleri ve açılan yaprakların cisimleri
+    std::vector<float> listX, listY, listZ, listMass;
+
+    // Ağaç her cisim için değil yaprak başına bir kez gezilir: ölçüt, düğümün yapraktaki
+    // cisimleri saran kutuya en yakın uzaklığıyla sınanır, liste yapraktaki tüm cisimlerce paylaşılır.
+    for (int l = beginLeaf; l < endLeaf; ++l)
+    {
+        const Node &group = nodes[leaves[l]];
+        const int first = group.firstBody, last = group.firstBody + group.bodyCount;
+        float minX = sortedX[first], minY = sortedY[first], minZ = sortedZ[first];
+        float maxX = minX, maxY = minY, maxZ = minZ;
+        for (int k = first + 1; k < last; ++k)
+        {
+            minX = qMin(minX, sortedX[k]);
+            minY = qMin(minY, sortedY[k]);
+            minZ = qMin(minZ, sortedZ[k]);
+            maxX = qMax(maxX, sortedX[k]);
+            maxY = qMax(maxY, sortedY[k]);
+            maxZ = qMax(maxZ, sortedZ[k]);
+        }
+
+        listX.clear();
+        listY.clear();
+        listZ.clear();
+        listMass.clear();
+
+        int top = 0;
+        stack[top++] = rootIndex;
+        while (top > 0)
+        {
+            const Node &node = nodes[stack[--top]];
+            const float dx = qMax(0.0f, qMax(minX - node.massX, node.massX - maxX));
+            const float dy = qMax(0.0f, qMax(minY - node.massY, node.massY - maxY));
+            const float dz = qMax(0.0f, qMax(minZ - node.massZ, node.massZ - maxZ));
+            const float open = node.size * openingFactor + node.offset;
+
+            if (open * open < dx * dx + dy * dy + dz * dz)
+            {
+                listX.push_back(node.massX);
+                listY.push_back(node.massY);
+                listZ.push_back(node.massZ);
+                listMass.push_back(node.mass);
+            }
+            else if (node.bodyCount > 0)
+            {
+                listX.insert(listX.end(), sortedX.begin() + node.firstBody, sortedX.begin() + node.firstBody + node.bodyCount);
+                listY.insert(listY.end(), sortedY.begin() + node.firstBody, sortedY.begin() + node.firstBody + node.bodyCount);
+                listZ.insert(listZ.end(), sortedZ.begin() + node.firstBody, sortedZ.begin() + node.firstBody + node.bodyCount);
+                listMass.insert(listMass.end(), sortedMass.begin() + node.firstBody,
+                                sortedMass.begin() + node.firstBody + node.bodyCount);
+            }
+            else
+            {
+                for (int child : node.children)
+                {
+                    if (child >= 0)
+                        stack[top++] = child;
+                }
+            }
+        }
+
+        const int listSize = int(listMass.size());
+        for (int k = first; k < last; ++k)
+        {
+            float sumX = 0.0f, sumY = 0.0f, sumZ = 0.0f;
+            sum(sortedX[k], sortedY[k], sortedZ[k], listX.data(), listY.data(), listZ.data(), listMass.data(),
+                listSize, softening2, sumX, sumY, sumZ);
+
+            const int i = order[k];
+            ax[i] = gravity * sumX;
+            ay[i] = gravity * sumY;
+            az[i] = gravity * sumZ;
+        }
+    }
+}
@@ -0,0 +1,71 @@
+#ifndef BARNESHUTTREE_H
+#define BARNESHUTTREE_H
+
+#include <QtGlobal>
+
+#include "simdmath.h"
+
+#include <utility>
+#include <vector>
+
+// Barnes–Hut sekizli ağacı (octree). Cisimler Morton (Z-sırası) koduna göre sıralanır;
+// her düğüm sıralı dizide ardışık bir aralığı kapsar. Kurulum ve kuvvet hesabı
+// QtConcurrent ile çekirdeklere dağıtılır: üstteki üç seviyenin 512 hücresi ayrı ayrı
+// sıralanıp kendi alt ağaçlarına kurulur, sonra tek dizide birleştirilir. Kuvvet hesabında
+// ağaç yaprak başına bir kez gezilir; çıkan etkileşim listesi SIMD ile toplanır.
+class BarnesHutTree
+{
+public:
+    struct Node {
+        float massX, massY, massZ;  // kütle merkezi
+        float mass;
+        float size;                 // hücre kenarı
+        float offset;               // kütle merkezinin hücre merkezine uzaklığı
+        int children[8];            // -1: boş sekizde bir
+        int firstBody, bodyCount;   // yaprakta sıralı cisim aralığı, iç düğümde 0
+    };
+
+    // yaprak bu sayıdan fazla cisim tutarsa bölünür
+    static const int leafCapacity = 16;
+
+    void build(const float *x, const float *y, const float *z, const float *mass, int count);
+
+    // İvmeler a = G * m * d / (|d|^2 + softening^2)^(3/2).
+    // theta (açılma açısı) hücre kenarı / uzaklık oranıdır: altında kalan hücre tek kütle
+    // sayılır. 0 doğrudan toplamdır (O(N^2)), büyüdükçe hızlanır ve hata artar.
+    void accelerations(float theta, float gravity, float softening, float *ax, float *ay, float *az) const;
+    // etkileşim toplamı belirli bir sürümle (karşılaştırma için)
+    void accelerations(SimdMath::Variant variant, float theta, float gravity, float softening,
+                       float *ax, float *ay, float *az) const;
+
+    int nodeCount() const { return int(nodes.size()); }
+    int bodyCount() const { return int(order.size()); }
+    const Node &root() const { return nodes[rootIndex]; }
+
+private:
+    int buildSubtree(std::vector<Node> &subtree, int begin, int end, int level, float centerX, float centerY,
+                     float centerZ) const;
+    int buildTop(int begin, int end, int level, int cell, float centerX, float centerY, float centerZ);
+    void finishNode(Node &node, const std::vector<Node> &pool, float centerX, float centerY, float centerZ) const;
+    // [beginLeaf, endLeaf) yapraklarındaki cisimlerin ivmeleri
+    void accelerateLeaves(SimdMath::Variant variant, int beginLeaf, int endLeaf, float openingFactor, float gravity,
+                          float softening, float *ax, float *ay, float *az) const;
+
+    std::vector<Node> nodes;
+    std::vector<int> leaves;    // yaprak düğümler, sıralı dizideki yerlerine göre
+    int rootIndex = -1;
+    float rootX = 0.0f, rootY = 0.0f, rootZ = 0.0f, rootSize = 0.0f;
+
+    // Morton sırası: sortedX[k] = x[order[k]]
+    std::vector<std::pair<quint64, int>> keys, unsortedKeys;
+    std::vector<int> order;
+    std::vector<float> sortedX, sortedY, sortedZ, sortedMass;
+
+    // üst seviye hücre başına sıralı aralık ve kurulan alt ağacın kökü
+    std::vector<int> bucketStart;
+    std::vector<int> bucketRoot;
+    std::vector<std::vector<Node>> bucketNodes;
+    std::vector<std::pair<int, int>> ranges;
+};
+
+#endif // BARNESHUTTREE_H
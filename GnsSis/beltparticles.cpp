@@ -0,0 +1,201 @@
+#include "beltparticles.h"
+#include "bodystore.h"
+
+#include <QDebug>
+#include <QRandomGenerator>
+#include <QtConcurrent/QtConcurrentMap>
+#include <QtMath>
+
+#include <cmath>
+#include <cstring>
+
+#ifndef GL_PROGRAM_POINT_SIZE
+#define GL_PROGRAM_POINT_SIZE 0x8642
+#endif
+
+namespace {
+
+// compute shader'daki local_size_x
+const int groupSize = 256;
+// üretim blokları; her blok kendi seed'iyle, sonuç iş parçacığı sayısından bağımsız
+const int chunkSize = 65536;
+
+}
+
+void BeltParticles::addBelt(const Shape &shape, int count, quint32 seed)
+{
+    count = qBound(0, count, maxParticles - particleCount);
+    if (count == 0)
+        return;
+    belts.push_back({ particleCount, count, shape, seed });
+    particleCount += count;
+}
+
+void BeltParticles::generate(const Belt &belt, int begin, int end, Orbit *orbits, float *states) const
+{
+    const Shape &shape = belt.shape;
+    QRandomGenerator random(belt.seed + quint32(begin / chunkSize));
+    for (int i = begin; i < end; ++i)
+    {
+        // düğüm, enberi ve başlangıç anomalisi dağıtılır (bkz. QOpenGLPanel::buildSolarSystem)
+        OrbitalElements orbit;
+        orbit.semiMajorAxis = shape.innerRadius + (shape.outerRadius - shape.innerRadius) * float(random.generateDouble());
+        orbit.eccentricity = shape.maxEccentricity * float(random.generateDouble());
+        orbit.inclination = shape.maxInclination * float(random.generateDouble());
+        orbit.ascendingNode = 360.0f * float(random.generateDouble());
+        orbit.periapsisArgument = 360.0f * float(random.generateDouble());
+        orbit.meanAnomaly = 360.0f * float(random.generateDouble());
+        const float size = shape.minSize + (shape.maxSize - shape.minSize) * float(random.generateDouble());
+
+        // Kepler'in üçüncü yasası: n ~ a^-1.5
+        const float ratio = shape.innerRadius / orbit.semiMajorAxis;
+        const float rate = qDegreesToRadians(shape.innerMeanMotion) * ratio * std::sqrt(ratio);
+        const float minor = orbit.semiMajorAxis * std::sqrt(1.0f - orbit.eccentricity * orbit.eccentricity);
+
+        QVector3D majorAxis, minorAxis;
+        BodyStore::orbitAxes(orbit, majorAxis, minorAxis);
+        majorAxis *= orbit.semiMajorAxis;
+        minorAxis *= minor;
+
+        Orbit &out = orbits[i - belt.first];
+        out.majorAxis[0] = majorAxis.x();
+        out.majorAxis[1] = majorAxis.y();
+        out.majorAxis[2] = majorAxis.z();
+        out.majorAxis[3] = orbit.eccentricity;
+        out.minorAxis[0] = minorAxis.x();
+        out.minorAxis[1] = minorAxis.y();
+        out.minorAxis[2] = minorAxis.z();
+        out.minorAxis[3] = rate;
+
+        // t = 0 anındaki ortalama anomali; shader zamanla birlikte bir tura indirger
+        float *state = states + 2 * size_t(i - belt.first);
+        state[0] = qDegreesToRadians(orbit.meanAnomaly) - float(M_PI);
+        state[1] = size;
+    }
+}
+
+bool BeltParticles::initialize(QOpenGLExtraFunctions *ef, ShaderCache &shaders)
+{
+    release(ef);
+    if (particleCount == 0)
+        return false;
+
+    computeProgram = shaders.build(ef, { { GL_COMPUTE_SHADER, ":beltparticles.comp" } });
+    drawProgram = shaders.build(ef, { { GL_VERTEX_SHADER, ":beltparticles.vert" },
+                                      { GL_FRAGMENT_SHADER, ":beltparticles.frag" } });
+    if (computeProgram == 0 || drawProgram == 0)
+    {
+        release(ef);
+        return false;
+    }
+
+    countID = ef->glGetUniformLocation(computeProgram, "count");
+    timeID = ef->glGetUniformLocation(computeProgram, "time");
+    centerID = ef->glGetUniformLocation(drawProgram, "center");
+    sizeScaleID = ef->glGetUniformLocation(drawProgram, "sizeScale");
+    colorID = ef->glGetUniformLocation(drawProgram, "color");
+    centerViewID = ef->glGetUniformLocation(drawProgram, "centerView");
+
+    ef->glGenBuffers(1, &orbitBuffer);
+    ef->glGenBuffers(1, &stateBuffer);
+    ef->glGenBuffers(1, &positionBuffer);
+    // çekirdek profilde çizim için bir VAO bağlı olmalı; hiçbir özniteliği yok
+    ef->glGenVertexArrays(1, &emptyVAO);
+
+    // Kuşaklar sırayla üretilip yüklenir, böylece CPU'da en fazla bir kuşağın kopyası durur.
+    // Tamponlar önce tüm parçacıklara göre ayrılır.
+    ef->glBindBuffer(GL_SHADER_STORAGE_BUFFER, orbitBuffer);
+    ef->glBufferData(GL_SHADER_STORAGE_BUFFER, GLsizeiptr(particleCount) * GLsizeiptr(sizeof(Orbit)), nullptr, GL_STATIC_DRAW);
+    ef->glBindBuffer(GL_SHADER_STORAGE_BUFFER, stateBuffer);
+    ef->glBufferData(GL_SHADER_STORAGE_BUFFER, GLsizeiptr(particleCount) * 2 * GLsizeiptr(sizeof(float)), nullptr, GL_STATIC_DRAW);
+    ef->glBindBuffer(GL_SHADER_STORAGE_BUFFER, positionBuffer);
+    ef->glBufferData(GL_SHADER_STORAGE_BUFFER, GLsizeiptr(particleCount) * 4 * GLsizeiptr(sizeof(float)), nullptr, GL_DYNAMIC_COPY);
+
+    for (const Belt &belt : belts)
+    {
+        std::vector<Orbit> orbits(belt.count);
+        std::vector<float> states(2 * size_t(belt.count));
+        std::vector<std::pair<int, int>> ranges;
+        for (int begin = belt.first; begin < belt.first + belt.count; begin += chunkSize)
+            ranges.emplace_back(begin, qMin(begin + chunkSize, belt.first + belt.count));
+        QtConcurrent::blockingMap(ranges, [&](const std::pair<int, int> &range) {
+            generate(belt, range.first, range.second, orbits.data(), states.data());
+        });
+
+        ef->glBindBuffer(GL_SHADER_STORAGE_BUFFER, orbitBuffer);
+        ef->glBufferSubData(GL_SHADER_STORAGE_BUFFER, GLintptr(belt.first) * GLintptr(sizeof(Orbit)),
+                            GLsizeiptr(belt.count) * GLsizeiptr(sizeof(Orbit)), orbits.data());
+        ef->glBindBuffer(GL_SHADER_STORAGE_BUFFER, stateBuffer);
+        ef->glBufferSubData(GL_SHADER_STORAGE_BUFFER, GLintptr(belt.first) * 2 * GLintptr(sizeof(float)),
+                            GLsizeiptr(states.size() * sizeof(float)), states.data());
+    }
+    ef->glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    // ilk karede konum tamponu dolu olsun
+    update(ef, 0.0);
+    return true;
+}
+
+void BeltParticles::release(QOpenGLExtraFunctions *ef)
+{
+    const GLuint buffers[] = { orbitBuffer, stateBuffer, positionBuffer };
+    for (GLuint buffer : buffers)
+    {
+        if (buffer != 0)
+            ef->glDeleteBuffers(1, &buffer);
+    }
+    if (emptyVAO != 0)
+        ef->glDeleteVertexArrays(1, &emptyVAO);
+    if (computeProgram != 0)
+        ef->glDeleteProgram(computeProgram);
+    if (drawProgram != 0)
+        ef->glDeleteProgram(drawProgram);
+    orbitBuffer = stateBuffer = positionBuffer = 0;
+    emptyVAO = 0;
+    computeProgram = drawProgram = 0;
+}
+
+void BeltParticles::update(QOpenGLExtraFunctions *ef, double time)
+{
+    if (!isReady())
+        return;
+
+    // glUniform1d ES uyumlu işlev tablosunda yok; double iki 32 bitlik yarı olarak gider
+    // ve shader'da packDouble2x32 ile birebir geri kurulur
+    quint64 bits;
+    std::memcpy(&bits, &time, sizeof(bits));
+
+    ef->glUseProgram(computeProgram);
+    ef->glUniform1ui(countID, GLuint(particleCount));
+    ef->glUniform2ui(timeID, GLuint(bits & 0xffffffffu), GLuint(bits >> 32));
+    ef->glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, orbitBuffer);
+    ef->glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, stateBuffer);
+    ef->glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, positionBuffer);
+    ef->glDispatchCompute(GLuint((particleCount + groupSize - 1) / groupSize), 1, 1);
+
+    // çizim köşe shader'ı konumları SSBO'dan okur
+    ef->glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+}
+
+void BeltParticles::draw(QOpenGLExtraFunctions *ef, const FrameUniforms &frame, const QVector3D &center, float sizeScale)
+{
+    if (!isReady())
+        return;
+
+    ef->glEnable(GL_PROGRAM_POINT_SIZE);
+    ef->glUseProgram(drawProgram);
+    // görüş ve izdüşüm matrisleri Frame bloğunda; burada yalnızca kuşağa özgü değerler
+    const QVector3D centerView = frame.view().map(center);
+    ef->glUniform3f(centerID, center.x(), center.y(), center.z());
+    ef->glUniform3f(centerViewID, centerView.x(), centerView.y(), centerView.z());
+    ef->glUniform1f(sizeScaleID, sizeScale);
+    ef->glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, positionBuffer);
+
+    // gl_VertexID, first'ten başlar; her kuşak kendi rengiyle tek çağrı
+    ef->glBindVertexArray(emptyVAO);
+    for (const Belt &belt : belts)
+    {
+        ef->glUniform3f(colorID, belt.shape.color.x(), belt.shape.color.y(), belt.shape.color.z());
+        ef->glDrawArrays(GL_POINTS, belt.first, belt.count);
+    }
+}
@@ -0,0 +1,20 @@
+#version 430
+// Nokta içinde küre görünümü (impostor): daire dışı atılır, normal gl_PointCoord'dan
+
+in vec3 lightDirection;
+
+out vec4 fragColor;
+
+uniform vec3 color;
+
+void main() {
+   vec2 p = gl_PointCoord * 2.0 - 1.0;
+   p.y = -p.y;
+   float r2 = dot(p, p);
+   if (r2 > 1.0)
+      discard;
+
+   vec3 normal = vec3(p, sqrt(1.0 - r2));
+   float diffuse = max(dot(normal, lightDirection), 0.0);
+   fragColor = vec4(color * (0.15 + 0.85 * diffuse), 1.0);
+}
@@ -0,0 +1,77 @@
+#ifndef BELTPARTICLES_H
+#define BELTPARTICLES_H
+
+#include "frameuniforms.h"
+#include "shadercache.h"
+
+#include <QMatrix4x4>
+#include <QOpenGLExtraFunctions>
+#include <QString>
+#include <QVector3D>
+
+#include <vector>
+
+// Asteroit ve Kuiper kuşağı gibi milyonlarca küçük cisim. Her parçacığın yörüngesi bir
+// kez CPU'da üretilip shader storage buffer'lara (SSBO) yüklenir ve CPU kopyası silinir;
+// sonrasında parçacıkların konumu her karede simülasyon zamanından bir compute shader ile
+// hesaplanır (beltparticles.comp); durum biriktirilmez, zamanda atlamak ek iş getirmez.
+// Parçacıklar köşe tamponu olmadan, yarıçapı kadar noktalar olarak küre görünümüyle
+// (impostor) çizilir. BodyStore'dan bağımsızdır; parçacıklar birbirini ve
+// gezegenleri çekmez, güneşin çevresinde sabit Kepler elipslerinde dolanır.
+// OpenGL 4.3 (compute shader) gerekir; Mesa llvmpipe'ta da çalışır.
+class BeltParticles
+{
+public:
+    // yarı büyük eksen aralığı, en büyük basıklık ve eğim (derece), iç kenardaki ortalama
+    // hareket (derece/adım; dışa doğru a^-1.5 ile azalır), yarıçap aralığı ve renk
+    struct Shape {
+        float innerRadius, outerRadius;
+        float maxEccentricity, maxInclination;
+        float innerMeanMotion;
+        float minSize, maxSize;
+        QVector3D color;
+    };
+
+    // tek dispatch'in en fazla iş grubu (65535) * grup boyu (256)
+    static const int maxParticles = 65535 * 256;
+
+    // initialize'dan önce çağrılır; aynı seed aynı kuşağı üretir
+    void addBelt(const Shape &shape, int count, quint32 seed);
+    // programları kurar (önbellekten ya da derleyerek), tamponları ayırıp yükler; bağlam current olmalı
+    bool initialize(QOpenGLExtraFunctions *ef, ShaderCache &shaders);
+    void release(QOpenGLExtraFunctions *ef);
+    bool isReady() const { return computeProgram != 0; }
+
+    // konumları t = time (adım) anına göre kurar
+    void update(QOpenGLExtraFunctions *ef, double time);
+    // kamera frame'in Frame bloğundan okunur (update edilmiş ve bağlı olmalı); center: kuşakların
+    // dolandığı cisim, sizeScale geometriye uygulanan ek ölçek (scaleMatrix)
+    void draw(QOpenGLExtraFunctions *ef, const FrameUniforms &frame, const QVector3D &center, float sizeScale);
+
+    int size() const { return particleCount; }
+    int beltCount() const { return int(belts.size()); }
+
+private:
+    // beltparticles.comp ile aynı düzen (std430)
+    struct Orbit {
+        float majorAxis[4];     // a * enberi yönü, e
+        float minorAxis[4];     // b * hareket yönü, adım başına ortalama anomali (radyan)
+    };
+    struct Belt {
+        int first, count;
+        Shape shape;
+        quint32 seed;
+    };
+
+    void generate(const Belt &belt, int begin, int end, Orbit *orbits, float *states) const;
+
+    std::vector<Belt> belts;
+    int particleCount = 0;
+
+    GLuint orbitBuffer = 0, stateBuffer = 0, positionBuffer = 0;
+    GLuint computeProgram = 0, drawProgram = 0, emptyVAO = 0;
+    GLint countID = -1, timeID = -1;
+    GLint centerID = -1, centerViewID = -1, sizeScaleID = -1, colorID = -1;
+};
+
+#endif // BELTPARTICLES_H
@@ -0,0 +1,32 @@
+#version 430
+// Köşe tamponu yok: parçacık gl_VertexID ile konum tamponundan okunur ve ekrana
+// yarıçapı kadar büyük bir nokta (point sprite) olarak çizilir
+
+layout(std430, binding = 2) readonly buffer Positions {
+   vec4 positions[];
+};
+
+// kare başına bir kez yüklenen kamera verisi (FrameUniforms)
+layout(std140, binding = 0) uniform Frame {
+   mat4 viewMatrix;          // cameraMatrix * translateMatrix
+   mat4 projectionMatrix;
+   mat4 viewProjectionMatrix;
+   float pixelScale;         // 0.5 * yükseklik * P[1][1]: birim uzaklıktaki birim yarıçapın piksel boyu
+};
+
+uniform vec3 center;         // kuşağın dolandığı cisim (güneş), dünya koordinatında
+uniform vec3 centerView;     // aynı nokta görüş uzayında; ışık yönü için
+uniform float sizeScale;     // scaleMatrix'in geometriye uyguladığı ölçek
+
+out vec3 lightDirection;     // görüş uzayında, parçacıktan güneşe
+
+void main() {
+   vec4 particle = positions[gl_VertexID];
+   vec4 view = viewMatrix * vec4(center + particle.xyz, 1.0);
+   gl_Position = projectionMatrix * view;
+
+   // en az bir piksel: uzaktaki parçacıklar kaybolmaz
+   float depth = max(-view.z, 1.0e-3);
+   gl_PointSize = clamp(2.0 * particle.w * sizeScale * pixelScale / depth, 1.0, 64.0);
+   lightDirection = normalize(centerView - view.xyz);
+}
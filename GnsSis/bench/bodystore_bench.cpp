@@ -0,0 +1,58 @@
+// BodyStore::update() maliyetini farklı cisim sayılarında ölçer.
+#include "../bodystore.h"
+
+#include <QElapsedTimer>
+
+#include <cstdio>
+#include <cstdlib>
+
+static void fillBodies(BodyStore &bodies, int count)
+{
+    bodies.clear();
+    bodies.reserve(count);
+
+    // güneş + her cismin dört uydusu olan bir ağaç; ebeveyn her zaman önce gelir
+    bodies.addBody(-1, 0.0f, 0.0f, 0.5f, 5.0f, 0, 0, 0);
+    for (int i = 1; i < count; ++i)
+    {
+        int parent = (i - 1) / 4;
+        float radius = 2.0f + float(i % 97);
+        float orbitSpeed = 0.05f + float(i % 13) * 0.1f;
+        bodies.addBody(parent, radius, orbitSpeed, 0.5f, 0.6f, 0, 0, i % 2);
+    }
+}
+
+static void runBenchmark(int count)
+{
+    BodyStore bodies;
+    fillBodies(bodies, count);
+    bodies.update();
+
+    // her ölçüm toplam ~4M cisim güncellemesi
+    const int iterations = qMax(3, 4000000 / count);
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < iterations; ++i)
+        bodies.update();
+    qint64 ns = timer.nsecsElapsed();
+
+    double nsPerUpdate = double(ns) / iterations;
+    std::printf("%9d bodies: %12.3f us/update %9.2f ns/body\n",
+                count, nsPerUpdate / 1000.0, nsPerUpdate / count);
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc > 1)
+    {
+        for (int i = 1; i < argc; ++i)
+            runBenchmark(qMax(1, std::atoi(argv[i])));
+        return 0;
+    }
+
+    runBenchmark(25);
+    runBenchmark(10000);
+    runBenchmark(1000000);
+    return 0;
+}
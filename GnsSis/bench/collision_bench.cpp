@@ -0,0 +1,179 @@
+// Çarpışma sınamasını pencere açmadan ölçer: dairesel yörüngelerde dönen bir kuşak ya da
+// halka her adımda bir önceki konumundan süpürülür ve CollisionDetector'a verilir.
+// Sonuç, küçük sahnelerde tüm çiftlerin (O(N^2)) doğrudan sınanmasıyla karşılaştırılır.
+// Kullanım: CollisionBench [--count N] [--steps N] [--model belt|rings] [--margin M]
+//                       [--verify N] [--threads N]
+#include "../collisiondetector.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <QThreadPool>
+#include <QtMath>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+// sahnedeki ölçekle aynı G (bkz. QOpenGLPanel::initNBody)
+static const float gravity = 3.046f;
+
+struct Ring {
+    std::vector<float> orbit, angle, rate, height, radius;
+    std::vector<float> startX, startY, startZ, endX, endY, endZ;
+
+    int size() const { return int(orbit.size()); }
+
+    void place(std::vector<float> &x, std::vector<float> &y, std::vector<float> &z) const
+    {
+        for (int i = 0; i < size(); ++i)
+        {
+            x[i] = orbit[i] * std::cos(angle[i]);
+            y[i] = height[i];
+            z[i] = orbit[i] * std::sin(angle[i]);
+        }
+    }
+
+    void advance()
+    {
+        startX.swap(endX);
+        startY.swap(endY);
+        startZ.swap(endZ);
+        for (int i = 0; i < size(); ++i)
+            angle[i] += rate[i];
+        place(endX, endY, endZ);
+    }
+};
+
+static void fillRing(Ring &ring, const QString &model, int count)
+{
+    // güneş + kuşak 38..46 birim ya da Satürn + halkalar 2.4..4.5 birim
+    QRandomGenerator random(2024);
+    const bool rings = model == "rings";
+    const float inner = rings ? 2.4f : 38.0f, outer = rings ? 4.5f : 46.0f;
+    const float thickness = rings ? 0.01f : 2.0f;
+    const float smallest = rings ? 0.0005f : 0.005f, largest = rings ? 0.002f : 0.02f;
+    const float centralGm = gravity * (rings ? 0.008f : 1.0f);
+
+    ring.orbit.assign(1, 0.0f);
+    ring.angle.assign(1, 0.0f);
+    ring.rate.assign(1, 0.0f);
+    ring.height.assign(1, 0.0f);
+    ring.radius.assign(1, rings ? 2.0f : 5.0f);
+    for (int i = 1; i < count; ++i)
+    {
+        const float orbit = inner + (outer - inner) * float(random.generateDouble());
+        ring.orbit.push_back(orbit);
+        ring.angle.push_back(float(2.0 * M_PI * random.generateDouble()));
+        ring.rate.push_back(std::sqrt(centralGm / (orbit * orbit * orbit)));
+        ring.height.push_back(thickness * float(random.generateDouble() - 0.5));
+        ring.radius.push_back(smallest + (largest - smallest) * float(random.generateDouble()));
+    }
+
+    for (std::vector<float> *v : { &ring.startX, &ring.startY, &ring.startZ, &ring.endX, &ring.endY, &ring.endZ })
+        v->resize(count);
+    ring.place(ring.endX, ring.endY, ring.endZ);
+    ring.advance();
+}
+
+// CollisionDetector::testPair ile aynı hesap: doğrusal göreli hareketin en yakın anı
+static int bruteForce(const Ring &ring, float margin)
+{
+    int pairs = 0;
+    const int count = ring.size();
+    for (int i = 0; i < count; ++i)
+    {
+        for (int j = i + 1; j < count; ++j)
+        {
+            const float dx = ring.startX[j] - ring.startX[i];
+            const float dy = ring.startY[j] - ring.startY[i];
+            const float dz = ring.startZ[j] - ring.startZ[i];
+            const float mx = (ring.endX[j] - ring.startX[j]) - (ring.endX[i] - ring.startX[i]);
+            const float my = (ring.endY[j] - ring.startY[j]) - (ring.endY[i] - ring.startY[i]);
+            const float mz = (ring.endZ[j] - ring.startZ[j]) - (ring.endZ[i] - ring.startZ[i]);
+            const float moved = mx * mx + my * my + mz * mz;
+            const float t = moved > 0.0f ? qBound(0.0f, -(dx * mx + dy * my + dz * mz) / moved, 1.0f) : 0.0f;
+            const float cx = dx + t * mx, cy = dy + t * my, cz = dz + t * mz;
+            if (std::sqrt(cx * cx + cy * cy + cz * cz) - (ring.radius[i] + ring.radius[j]) < margin)
+                ++pairs;
+        }
+    }
+    return pairs;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Runs swept-sphere collision detection headless and reports timings");
+    parser.addHelpOption();
+    QCommandLineOption countOption("count", "Number of bodies.", "count", "100000");
+    QCommandLineOption stepsOption("steps", "Measured steps.", "count", "50");
+    QCommandLineOption modelOption("model", "belt or rings.", "model", "belt");
+    QCommandLineOption marginOption("margin", "Close approach distance between surfaces.", "distance", "0.01");
+    QCommandLineOption verifyOption("verify", "Check against all pairs up to this many bodies (0: skip).", "count", "20000");
+    QCommandLineOption threadsOption("threads", "Thread pool size (default: all cores).", "count");
+    parser.addOption(countOption);
+    parser.addOption(stepsOption);
+    parser.addOption(modelOption);
+    parser.addOption(marginOption);
+    parser.addOption(verifyOption);
+    parser.addOption(threadsOption);
+    parser.process(app);
+
+    const int count = qMax(2, parser.value(countOption).toInt());
+    const int steps = qMax(1, parser.value(stepsOption).toInt());
+    const QString model = parser.value(modelOption);
+    if (parser.isSet(threadsOption))
+        QThreadPool::globalInstance()->setMaxThreadCount(qMax(1, parser.value(threadsOption).toInt()));
+
+    Ring ring;
+    fillRing(ring, model, count);
+    CollisionDetector detector;
+    detector.setApproachMargin(parser.value(marginOption).toFloat());
+
+    std::printf("%d bodies, %s, %d pool threads, margin %g, %d steps\n", count, qPrintable(model),
+                QThreadPool::globalInstance()->maxThreadCount(), detector.margin(), steps);
+
+    // ilk çağrı tamponları ayırır; ölçüme girmez
+    detector.detect(ring.startX.data(), ring.startY.data(), ring.startZ.data(),
+                    ring.endX.data(), ring.endY.data(), ring.endZ.data(), ring.radius.data(), count);
+    if (count <= parser.value(verifyOption).toInt())
+    {
+        const int expected = bruteForce(ring, detector.margin());
+        const int reported = int(detector.contacts().size());
+        std::printf("  all pairs: %d, detector: %d %s\n", expected, reported, expected == reported ? "ok" : "MISMATCH");
+        if (expected != reported)
+            return 1;
+    }
+
+    std::vector<double> samples;
+    qint64 contacts = 0, overlaps = 0;
+    for (int step = 0; step < steps; ++step)
+    {
+        ring.advance();
+        contacts += detector.detect(ring.startX.data(), ring.startY.data(), ring.startZ.data(),
+                                    ring.endX.data(), ring.endY.data(), ring.endZ.data(), ring.radius.data(), count);
+        overlaps += detector.overlapCount();
+        samples.push_back(detector.detectNsecs() / 1.0e6);
+    }
+    std::sort(samples.begin(), samples.end());
+    double mean = 0.0;
+    for (double sample : samples)
+        mean += sample;
+    mean /= double(samples.size());
+
+    std::printf("  detect: mean %.3f ms p50 %.3f max %.3f  %.2f M bodies/s\n",
+                mean, samples[samples.size() / 2], samples.back(), count / mean / 1.0e3);
+    std::printf("  per step: %.1f contacts, %.1f overlapping  cell %g, %d levels\n",
+                double(contacts) / steps, double(overlaps) / steps, detector.cellSize(), detector.occupiedLevels());
+
+    const CollisionDetector::Contact closest = detector.closestApproach();
+    if (closest.first >= 0)
+        std::printf("  closest: %d-%d separation %g at t %.2f\n", closest.first, closest.second,
+                    closest.separation, closest.time);
+    return 0;
+}
@@ -0,0 +1,171 @@
+// Chebyshev konum tablosunu (Ephemeris) ölçer: sahneye benzer eliptik yörüngeler gün ve km
+// biriminde parçalara oturtulup dosyaya yazılır, dosya belleğe eşlenerek açılır. Doğruluk
+// Kepler çözümüne göre, süreler ardışık kareler (parça önbelleği tutar), rastgele anlar
+// (her çağrıda parça değişir) ve çizim için toplu değerlendirme olarak raporlanır.
+// Kullanım: EphemerisBench [--planets N] [--coefficients N] [--segments N] [--ticks T] [--output dosya]
+#include "../bodystore.h"
+#include "../ephemeris.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QRandomGenerator>
+#include <QTemporaryDir>
+#include <QtMath>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+// DE dosyaları gibi gün ve km; sahnede Dünya a = 25 birim, n = 0.8 derece/adım
+static const double earthDistanceKm = 1.495978707e8;
+static const Ephemeris::Units units = { 2451545.0, 450.0 / 365.25, 25.0 / earthDistanceKm };
+
+static void buildBodies(BodyStore &bodies, int planets)
+{
+    QRandomGenerator random(2024);
+    bodies.addBody(-1, 0.0f, 0.0f, 0.5f, 5.0f, 0, 0, 0);
+    for (int p = 0; p < planets; ++p)
+    {
+        // Merkür'den Neptün'e kadar, n ~ a^-1.5
+        const float a = 10.0f * std::pow(1.6f, float(p));
+        const OrbitalElements orbit = { a, float(random.bounded(0.2)), float(random.bounded(7.0)),
+                                        float(random.bounded(360.0)), float(random.bounded(360.0)),
+                                        float(random.bounded(360.0)), 0.0f, 0.8f * std::pow(25.0f / a, 1.5f) };
+        const int planet = bodies.addBody(0, orbit, 2.0f, 0.5f, 0, 0, 0);
+        // her gezegene bir uydu; kısa dönemli seriler
+        const OrbitalElements moon = { 1.5f, 0.05f, 5.0f, 0.0f, 0.0f, float(random.bounded(360.0)), 0.0f, 10.0f };
+        bodies.addBody(planet, moon, 0.0f, 0.1f, 0, 0, 0);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Fits Kepler orbits into a Chebyshev ephemeris file and measures lookups");
+    parser.addHelpOption();
+    QCommandLineOption planetsOption("planets", "Planets, each with one moon.", "count", "8");
+    QCommandLineOption coefficientsOption("coefficients", "Chebyshev coefficients per coordinate.", "count", "12");
+    QCommandLineOption segmentsOption("segments", "Segments per orbital period.", "count", "8");
+    QCommandLineOption ticksOption("ticks", "Covered simulation time.", "ticks", "100000");
+    QCommandLineOption outputOption("output", "Keep the ephemeris file (GNSSIS_EPHEMERIS).", "file");
+    parser.addOption(planetsOption);
+    parser.addOption(coefficientsOption);
+    parser.addOption(segmentsOption);
+    parser.addOption(ticksOption);
+    parser.addOption(outputOption);
+    parser.process(app);
+
+    const int planets = qMax(1, parser.value(planetsOption).toInt());
+    const int coefficients = qMax(2, parser.value(coefficientsOption).toInt());
+    const int segmentsPerOrbit = qMax(1, parser.value(segmentsOption).toInt());
+    const double coveredTicks = qMax(1.0, parser.value(ticksOption).toDouble());
+
+    BodyStore bodies;
+    buildBodies(bodies, planets);
+    const int count = bodies.size();
+
+    // ebeveyne göre Kepler konumu, dosya biriminde
+    auto kepler = [&bodies](int body, double ticks) {
+        QVector3D position, velocity;
+        bodies.setTime(ticks);
+        bodies.orbitState(body, 0.0f, position, velocity);
+        return position;
+    };
+
+    QElapsedTimer timer;
+    timer.start();
+    std::vector<Ephemeris::Series> series;
+    for (int body = 1; body < count; ++body)
+    {
+        Ephemeris::Series s;
+        s.target = body;
+        s.center = bodies.parent[body];
+        s.coefficientCount = coefficients;
+        s.start = units.epoch;
+        s.length = 360.0 / double(bodies.orbitRate[body]) / segmentsPerOrbit / units.ticksPerUnit;
+        const int segments = int(std::ceil(coveredTicks / units.ticksPerUnit / s.length));
+        s.coefficients.resize(size_t(segments) * 3 * size_t(coefficients));
+        for (int segment = 0; segment < segments; ++segment)
+        {
+            Ephemeris::fit([&](double time, double position[3]) {
+                const QVector3D p = kepler(body, (time - units.epoch) * units.ticksPerUnit);
+                position[0] = p.x() / units.lengthScale;
+                position[1] = p.y() / units.lengthScale;
+                position[2] = p.z() / units.lengthScale;
+            }, s.start + s.length * segment, s.length, coefficients,
+               s.coefficients.data() + size_t(segment) * 3 * size_t(coefficients));
+        }
+        series.push_back(std::move(s));
+    }
+
+    QTemporaryDir directory;
+    const QString path = parser.isSet(outputOption) ? parser.value(outputOption) : directory.filePath("bench.eph");
+    if (!Ephemeris::write(path, units, series))
+    {
+        std::fprintf(stderr, "cannot write %s\n", qPrintable(path));
+        return 1;
+    }
+    const double fitMs = timer.nsecsElapsed() / 1.0e6;
+
+    timer.restart();
+    Ephemeris ephemeris;
+    if (!ephemeris.open(path))
+    {
+        std::fprintf(stderr, "cannot open %s\n", qPrintable(path));
+        return 1;
+    }
+    const double openUs = timer.nsecsElapsed() / 1.0e3;
+    std::printf("%d series, %d coefficients, %d segments per orbit, %.0f ticks: %.1f KB\n",
+                ephemeris.seriesCount(), coefficients, segmentsPerOrbit, coveredTicks,
+                QFileInfo(path).size() / 1024.0);
+    std::printf("  fit + write %.1f ms, open (map) %.1f us\n", fitMs, openUs);
+
+    // Kepler çözümüne göre en büyük hata, yarı büyük eksene oranla
+    QRandomGenerator random(7);
+    double worst = 0.0;
+    for (int sample = 0; sample < 2000; ++sample)
+    {
+        const double ticks = random.bounded(coveredTicks);
+        for (int s = 0; s < ephemeris.seriesCount(); ++s)
+        {
+            const int body = ephemeris.target(s);
+            const float error = (ephemeris.position(s, ticks) - kepler(body, ticks)).length();
+            worst = qMax(worst, double(error / bodies.orbitRadius[body]));
+        }
+    }
+    std::printf("  max error vs Kepler: %.2e of the semi-major axis\n", worst);
+
+    // ardışık kareler: 60 Hz, gerçek zaman; tüm seriler
+    const int frames = 100000;
+    volatile float sink = 0.0f;
+    timer.restart();
+    for (int frame = 0; frame < frames; ++frame)
+        for (int s = 0; s < ephemeris.seriesCount(); ++s)
+            sink += ephemeris.position(s, frame * 1.0).x();
+    const double sequentialNs = double(timer.nsecsElapsed()) / frames / ephemeris.seriesCount();
+
+    std::vector<double> times(frames);
+    for (double &time : times)
+        time = random.bounded(coveredTicks);
+    timer.restart();
+    for (int frame = 0; frame < frames; ++frame)
+        sink += ephemeris.position(frame % ephemeris.seriesCount(), times[frame]).x();
+    const double randomNs = double(timer.nsecsElapsed()) / frames;
+
+    // yörünge çizimi: sıralı anlar, komşular çoğunlukla aynı parçada
+    std::sort(times.begin(), times.end());
+    std::vector<float> x(frames), y(frames), z(frames);
+    timer.restart();
+    ephemeris.positions(0, times.data(), frames, x.data(), y.data(), z.data());
+    const double batchNs = double(timer.nsecsElapsed()) / frames;
+    sink += x[frames / 2];
+
+    std::printf("  lookup: sequential %.1f ns, random %.1f ns, batch %.1f ns per time\n",
+                sequentialNs, randomNs, batchNs);
+    return 0;
+}
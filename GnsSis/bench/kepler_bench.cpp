@@ -0,0 +1,122 @@
+// Kepler denklemi çözücüsünü ve eliptik yörüngeli BodyStore güncellemesini ölçer.
+// Çözücü sürümleri çift duyarlıklı, yakınsayana kadar çözülmüş bir referansla karşılaştırılır;
+// BodyStore tek iş parçacığıyla ve tüm çekirdeklerle ayrı ayrı ölçülür.
+// Kullanım: KeplerBench [cisim sayısı ...]   (varsayılan 1000000)
+#include "../bodystore.h"
+#include "../keplersolver.h"
+
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <QThreadPool>
+#include <QtMath>
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+// ns/çağrı; her ölçüm toplam ~20M cisim
+template <typename Function>
+static double measure(int count, Function function)
+{
+    const int iterations = qMax(5, 20000000 / count);
+    function();
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < iterations; ++i)
+        function();
+    return double(timer.nsecsElapsed()) / iterations;
+}
+
+static void runSolver(int count)
+{
+    QRandomGenerator random(2024);
+    std::vector<float> meanAnomaly(count), eccentricity(count);
+    for (int i = 0; i < count; ++i)
+    {
+        meanAnomaly[i] = float(random.bounded(40000.0) - 20000.0);
+        eccentricity[i] = float(random.bounded(0.99));
+    }
+
+    // referans: çift duyarlık, sabit ve bol adım sayısı
+    std::vector<double> referenceCos(count), referenceSin(count);
+    for (int i = 0; i < count; ++i)
+    {
+        const double m = std::remainder(double(meanAnomaly[i]), 360.0) * M_PI / 180.0;
+        const double e = eccentricity[i];
+        double anomaly = m < 0.0 ? m - 0.85 * e : m + 0.85 * e;
+        for (int step = 0; step < 50; ++step)
+            anomaly -= (anomaly - e * std::sin(anomaly) - m) / (1.0 - e * std::cos(anomaly));
+        referenceCos[i] = std::cos(anomaly);
+        referenceSin[i] = std::sin(anomaly);
+    }
+
+    std::printf("%d orbits, 0 <= e < 0.99\n", count);
+    std::vector<float> cosE(count), sinE(count);
+    for (int v = SimdMath::Scalar; v <= SimdMath::Neon; ++v)
+    {
+        const SimdMath::Variant variant = SimdMath::Variant(v);
+        if (!SimdMath::isSupported(variant))
+            continue;
+
+        const double ns = measure(count, [&]() {
+            KeplerSolver::solve(variant, meanAnomaly.data(), eccentricity.data(), count, cosE.data(), sinE.data());
+        });
+        double maxError = 0.0;
+        for (int i = 0; i < count; ++i)
+            maxError = qMax(maxError, qMax(std::abs(cosE[i] - referenceCos[i]), std::abs(sinE[i] - referenceSin[i])));
+        std::printf("  solver %-8s %10.3f ms %8.2f ns/body  max error %g\n",
+                    SimdMath::name(variant), ns / 1.0e6, ns / count, maxError);
+    }
+}
+
+static void runBodyStore(int count)
+{
+    // güneş + kuşak: her cisim güneşe bağlı, eliptik ve eğik yörünge
+    QRandomGenerator random(2024);
+    BodyStore bodies;
+    bodies.reserve(count);
+    bodies.addBody(-1, 0.0f, 0.0f, 0.5f, 5.0f, 0, 0, 0);
+    for (int i = 1; i < count; ++i)
+    {
+        OrbitalElements orbit;
+        orbit.semiMajorAxis = 38.0f + float(random.bounded(8.0));
+        orbit.eccentricity = float(random.bounded(0.3));
+        orbit.inclination = float(random.bounded(20.0));
+        orbit.ascendingNode = float(random.bounded(360.0));
+        orbit.periapsisArgument = float(random.bounded(360.0));
+        orbit.meanAnomaly = float(random.bounded(360.0));
+        orbit.epoch = 0.0f;
+        orbit.meanMotion = 0.2f + float(random.bounded(0.4));
+        bodies.addBody(0, orbit, 0.5f, 0.1f, 0, 0, 0);
+    }
+
+    QThreadPool *pool = QThreadPool::globalInstance();
+    const int threads = pool->maxThreadCount();
+
+    pool->setMaxThreadCount(1);
+    const double singleNs = measure(count, [&bodies]() { bodies.update(); });
+    pool->setMaxThreadCount(threads);
+    const double parallelNs = measure(count, [&bodies]() { bodies.update(); });
+
+    std::printf("  BodyStore::update 1 pool thread  %10.3f ms %8.2f ns/body\n", singleNs / 1.0e6, singleNs / count);
+    std::printf("  BodyStore::update %d pool threads %10.3f ms %8.2f ns/body %6.1fx\n",
+                threads, parallelNs / 1.0e6, parallelNs / count, singleNs / parallelNs);
+}
+
+int main(int argc, char *argv[])
+{
+    std::vector<int> counts;
+    for (int i = 1; i < argc; ++i)
+        counts.push_back(qMax(1, std::atoi(argv[i])));
+    if (counts.empty())
+        counts.push_back(1000000);
+
+    for (int count : counts)
+    {
+        runSolver(count);
+        runBodyStore(count);
+    }
+    return 0;
+}
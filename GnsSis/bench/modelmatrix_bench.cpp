@@ -0,0 +1,112 @@
+// Model matrisi kurulumunu ölçer: cisim başına QMatrix4x4 çarpımları (referans yol)
+// ile BodyStore'un toplu yolu ve ModelMatrixKernel'in skaler ve SIMD sürümleri karşılaştırılır.
+// Kullanım: ModelMatrixBench [cisim sayısı ...]   (varsayılan 100000)
+#include "../bodystore.h"
+#include "../modelmatrixkernel.h"
+
+#include <QElapsedTimer>
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+static void fillBodies(BodyStore &bodies, int count)
+{
+    bodies.clear();
+    bodies.reserve(count);
+
+    // bodystore_bench ile aynı ağaç: güneş + her cismin dört uydusu
+    bodies.addBody(-1, 0.0f, 0.0f, 0.5f, 5.0f, 0, 0, 0);
+    for (int i = 1; i < count; ++i)
+    {
+        int parent = (i - 1) / 4;
+        float radius = 2.0f + float(i % 97);
+        float orbitSpeed = 0.05f + float(i % 13) * 0.1f;
+        bodies.addBody(parent, radius, orbitSpeed, 0.5f, 0.6f, 0, 0, i % 2);
+    }
+    // açılar sıfırdan başlarsa sin/cos kolay bölgede kalır; birkaç bin adım ilerlet
+    bodies.advance(5000.0f);
+}
+
+// ns/çağrı; her ölçüm toplam ~20M cisim
+template <typename Function>
+static double measure(int count, Function function)
+{
+    const int iterations = qMax(5, 20000000 / count);
+    function();
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < iterations; ++i)
+        function();
+    return double(timer.nsecsElapsed()) / iterations;
+}
+
+static float maxDifference(const std::vector<float> &a, const std::vector<float> &b)
+{
+    float difference = 0.0f;
+    for (size_t i = 0; i < a.size(); ++i)
+        difference = qMax(difference, std::abs(a[i] - b[i]));
+    return difference;
+}
+
+static void runBenchmark(int count)
+{
+    BodyStore bodies;
+    fillBodies(bodies, count);
+
+    std::printf("%d bodies\n", count);
+
+    // ara değerlemeli kare: alpha < 1
+    bodies.setMatrixKernel(false);
+    const double referenceNs = measure(count, [&bodies]() { bodies.updateMatrices(0.5f); });
+    const std::vector<float> reference = bodies.modelData;
+    std::printf("  %-22s %10.3f ms %8.2f ns/body\n", "QMatrix4x4 per body", referenceNs / 1.0e6, referenceNs / count);
+
+    bodies.setMatrixKernel(true);
+    const double storeNs = measure(count, [&bodies]() { bodies.updateMatrices(0.5f); });
+    std::printf("  %-22s %10.3f ms %8.2f ns/body %6.1fx  max diff %g\n", "BodyStore + kernel",
+                storeNs / 1.0e6, storeNs / count, referenceNs / storeNs, maxDifference(reference, bodies.modelData));
+
+    // yalnızca çekirdek: aynı dönüş açıları, BodyStore'un bulduğu dünya konumları
+    std::vector<float> spinAngle(bodies.spinAngle), x(count), y(count), z(count);
+    for (int i = 0; i < count; ++i)
+    {
+        const QVector3D position = bodies.position(i);
+        x[i] = position.x();
+        y[i] = position.y();
+        z[i] = position.z();
+    }
+    std::vector<float> scalar(16 * size_t(count)), out(16 * size_t(count));
+    ModelMatrixKernel::compose(SimdMath::Scalar, spinAngle.data(), bodies.scale.data(), x.data(), y.data(), z.data(),
+                               count, scalar.data());
+
+    for (int v = SimdMath::Scalar; v <= SimdMath::Neon; ++v)
+    {
+        const SimdMath::Variant variant = SimdMath::Variant(v);
+        if (!SimdMath::isSupported(variant))
+            continue;
+
+        const double ns = measure(count, [&]() {
+            ModelMatrixKernel::compose(variant, spinAngle.data(), bodies.scale.data(), x.data(), y.data(), z.data(),
+                                       count, out.data());
+        });
+        const QByteArray label = QByteArray("kernel ") + SimdMath::name(variant);
+        std::printf("  %-22s %10.3f ms %8.2f ns/body %6.1fx  max diff %g\n", label.constData(),
+                    ns / 1.0e6, ns / count, referenceNs / ns, maxDifference(scalar, out));
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc > 1)
+    {
+        for (int i = 1; i < argc; ++i)
+            runBenchmark(qMax(1, std::atoi(argv[i])));
+        return 0;
+    }
+
+    runBenchmark(100000);
+    return 0;
+}
@@ -0,0 +1,178 @@
+// Barnes–Hut N-body adımını pencere açmadan ölçer: ağaç kurulumu, kuvvet hesabı ve
+// tüm adım süresi, verilen her açılma açısı için ayrı. Doğruluk, rastgele seçilen
+// cisimlerde doğrudan toplama (O(N^2)) göre göreli ivme hatasıyla raporlanır.
+// Kullanım: NBodyBench [--count N] [--steps N] [--theta 0.3,0.5,0.7,1.0] [--model belt|rings|cluster]
+//                   [--sample N] [--threads N]
+#include "../nbodysimulation.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <QThreadPool>
+#include <QtMath>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+// sahnedeki ölçekle aynı: güneş kütlesi 1, G Dünya yörüngesinden (bkz. QOpenGLPanel::initNBody)
+static const float gravity = 3.046f;
+static const float softening = 0.05f;
+
+static void fillSimulation(NBodySimulation &simulation, const QString &model, int count)
+{
+    QRandomGenerator random(2024);
+    simulation.clear();
+    simulation.reserve(count);
+
+    if (model == "cluster")
+    {
+        // Plummer küresi: eşit kütleli yıldızlar, başlangıçta durgun (çöküş)
+        for (int i = 0; i < count; ++i)
+        {
+            const double u = qMax(1.0e-6, random.generateDouble());
+            const float radius = 10.0f / float(std::sqrt(std::pow(u, -2.0 / 3.0) - 1.0));
+            const float cosTheta = float(2.0 * random.generateDouble() - 1.0);
+            const float phi = float(2.0 * M_PI * random.generateDouble());
+            const float sinTheta = std::sqrt(1.0f - cosTheta * cosTheta);
+            const QVector3D position(radius * sinTheta * std::cos(phi), radius * cosTheta, radius * sinTheta * std::sin(phi));
+            simulation.addBody(position, QVector3D(), 1.0f / float(count));
+        }
+        return;
+    }
+
+    // güneş + ince disk: kuşak 38..46 birim (sahnedeki kuşak), halkalar 2.4..4.5 birim
+    const bool rings = model == "rings";
+    const float inner = rings ? 2.4f : 38.0f, outer = rings ? 4.5f : 46.0f;
+    const float thickness = rings ? 0.01f : 2.0f;
+    // halkalarda merkez Satürn (sahnedeki kütlesi 1e-3 * 2^3)
+    simulation.addBody(QVector3D(), QVector3D(), rings ? 0.008f : 1.0f);
+    const float centralGm = gravity * simulation.mass[0];
+    for (int i = 1; i < count; ++i)
+    {
+        const float radius = inner + (outer - inner) * float(random.generateDouble());
+        const float angle = float(2.0 * M_PI * random.generateDouble());
+        const float height = thickness * float(random.generateDouble() - 0.5);
+        const float speed = std::sqrt(centralGm / radius);
+        simulation.addBody(QVector3D(radius * std::cos(angle), height, radius * std::sin(angle)),
+                           QVector3D(-speed * std::sin(angle), 0.0f, speed * std::cos(angle)),
+                           1.0e-4f / float(count));
+    }
+}
+
+// rastgele cisimlerde Barnes–Hut ivmesinin doğrudan toplamdan göreli farkı (ortalama ve en büyük)
+static void measureError(const NBodySimulation &simulation, float theta, int sample, double &meanError, double &maxError)
+{
+    const int count = simulation.size();
+    std::vector<float> ax(count), ay(count), az(count);
+    BarnesHutTree tree;
+    tree.build(simulation.x.data(), simulation.y.data(), simulation.z.data(), simulation.mass.data(), count);
+    tree.accelerations(theta, gravity, softening, ax.data(), ay.data(), az.data());
+
+    QRandomGenerator random(7);
+    meanError = 0.0;
+    maxError = 0.0;
+    sample = qMin(sample, count);
+    for (int s = 0; s < sample; ++s)
+    {
+        const int i = random.bounded(count);
+        double sumX = 0.0, sumY = 0.0, sumZ = 0.0;
+        for (int j = 0; j < count; ++j)
+        {
+            if (j == i)
+                continue;
+            const double dx = simulation.x[j] - simulation.x[i];
+            const double dy = simulation.y[j] - simulation.y[i];
+            const double dz = simulation.z[j] - simulation.z[i];
+            const double r2 = dx * dx + dy * dy + dz * dz + double(softening) * softening;
+            const double strength = simulation.mass[j] / (r2 * std::sqrt(r2));
+            sumX += strength * dx;
+            sumY += strength * dy;
+            sumZ += strength * dz;
+        }
+        sumX *= gravity;
+        sumY *= gravity;
+        sumZ *= gravity;
+
+        const double reference = std::sqrt(sumX * sumX + sumY * sumY + sumZ * sumZ);
+        const double difference = std::sqrt((ax[i] - sumX) * (ax[i] - sumX) + (ay[i] - sumY) * (ay[i] - sumY)
+                                            + (az[i] - sumZ) * (az[i] - sumZ));
+        const double error = reference > 0.0 ? difference / reference : difference;
+        meanError += error;
+        maxError = qMax(maxError, error);
+    }
+    if (sample > 0)
+        meanError /= sample;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Steps a Barnes-Hut N-body simulation headless and reports timings");
+    parser.addHelpOption();
+    QCommandLineOption countOption("count", "Number of bodies.", "count", "1000000");
+    QCommandLineOption stepsOption("steps", "Measured steps per opening angle.", "count", "5");
+    QCommandLineOption thetaOption("theta", "Comma separated opening angles.", "list", "0.3,0.5,0.7,1.0");
+    QCommandLineOption modelOption("model", "belt, rings or cluster.", "model", "belt");
+    QCommandLineOption sampleOption("sample", "Bodies checked against direct summation (0: skip).", "count", "256");
+    QCommandLineOption threadsOption("threads", "Thread pool size (default: all cores).", "count");
+    parser.addOption(countOption);
+    parser.addOption(stepsOption);
+    parser.addOption(thetaOption);
+    parser.addOption(modelOption);
+    parser.addOption(sampleOption);
+    parser.addOption(threadsOption);
+    parser.process(app);
+
+    const int count = qMax(2, parser.value(countOption).toInt());
+    const int steps = qMax(1, parser.value(stepsOption).toInt());
+    const int sample = qMax(0, parser.value(sampleOption).toInt());
+    const QString model = parser.value(modelOption);
+    if (parser.isSet(threadsOption))
+        QThreadPool::globalInstance()->setMaxThreadCount(qMax(1, parser.value(threadsOption).toInt()));
+
+    std::printf("%d bodies, %s, %d pool threads, %s interaction kernel, %d steps per theta\n", count,
+                qPrintable(model), QThreadPool::globalInstance()->maxThreadCount(),
+                SimdMath::name(SimdMath::best()), steps);
+
+    for (const QString &value : parser.value(thetaOption).split(',', Qt::SkipEmptyParts))
+    {
+        const float theta = value.toFloat();
+        NBodySimulation simulation;
+        fillSimulation(simulation, model, count);
+        simulation.setTheta(theta);
+        simulation.setGravity(gravity);
+        simulation.setSoftening(softening);
+        simulation.setTimeStep(1.0f);
+
+        double meanError = 0.0, maxError = 0.0;
+        if (sample > 0)
+            measureError(simulation, theta, sample, meanError, maxError);
+
+        // ilk adım başlangıç ivmelerini de hesaplar; ölçüme girmez
+        simulation.step();
+
+        double buildMs = 0.0, forceMs = 0.0, stepMs = 0.0;
+        QElapsedTimer timer;
+        for (int step = 0; step < steps; ++step)
+        {
+            timer.start();
+            simulation.step();
+            stepMs += timer.nsecsElapsed() / 1.0e6;
+            buildMs += simulation.buildNsecs() / 1.0e6;
+            forceMs += simulation.forceNsecs() / 1.0e6;
+        }
+
+        std::printf("  theta %.2f: step %9.2f ms (build %8.2f, forces %9.2f)  %6.2f M bodies/s  %d nodes",
+                    theta, stepMs / steps, buildMs / steps, forceMs / steps,
+                    count / (stepMs / steps) / 1.0e3, simulation.tree().nodeCount());
+        if (sample > 0)
+            std::printf("  error mean %.2e max %.2e", meanError, maxError);
+        std::printf("\n");
+    }
+    return 0;
+}
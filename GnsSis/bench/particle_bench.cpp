@@ -0,0 +1,173 @@
+// Kuşak parçacıklarını pencere açmadan (QOffscreenSurface + FBO) her karenin zamanına kurup çizer; compute
+// (update) ve çizim (draw) geçişleri ayrı ayrı GPU zamanlayıcısıyla ölçülür ve milisaniyede
+// işlenen parçacık sayısı olarak raporlanır. Zamanlayıcı yoksa glFinish ile duvar saati.
+// Kullanım: ParticleBench [--asteroids N] [--kuiper N] [--frames N] [--size 1280x720] [--json]
+// Ekransız makinelerde Mesa llvmpipe ile: QT_QPA_PLATFORM=offscreen LIBGL_ALWAYS_SOFTWARE=1 ParticleBench
+#include "../beltparticles.h"
+
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QGuiApplication>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QOffscreenSurface>
+#include <QOpenGLContext>
+#include <QtOpenGL/QOpenGLFramebufferObject>
+#include <QtOpenGL/QOpenGLTimerQuery>
+
+#include <cstdio>
+
+int main(int argc, char *argv[])
+{
+    // OpenGLKamera ile aynı bağlam
+    QSurfaceFormat format;
+    format.setDepthBufferSize(24);
+    format.setStencilBufferSize(8);
+    format.setVersion(4,3);
+    format.setProfile(QSurfaceFormat::CoreProfile);
+    QSurfaceFormat::setDefaultFormat(format);
+
+    QGuiApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Advances and draws belt particles offscreen and reports particles per millisecond");
+    parser.addHelpOption();
+    QCommandLineOption asteroidsOption("asteroids", "Particles in the asteroid belt.", "count", "1000000");
+    QCommandLineOption kuiperOption("kuiper", "Particles in the Kuiper belt.", "count", "0");
+    QCommandLineOption framesOption("frames", "Number of measured frames.", "count", "20");
+    QCommandLineOption sizeOption("size", "Framebuffer size.", "WxH", "1280x720");
+    QCommandLineOption jsonOption("json", "Print the results as JSON.");
+    parser.addOption(asteroidsOption);
+    parser.addOption(kuiperOption);
+    parser.addOption(framesOption);
+    parser.addOption(sizeOption);
+    parser.addOption(jsonOption);
+    parser.process(app);
+
+    const int frames = qMax(1, parser.value(framesOption).toInt());
+    const QStringList sizeParts = parser.value(sizeOption).split('x');
+    const QSize size(sizeParts.value(0).toInt(), sizeParts.value(1).toInt());
+    if (size.isEmpty())
+    {
+        std::fprintf(stderr, "invalid --size %s\n", qPrintable(parser.value(sizeOption)));
+        return 1;
+    }
+
+    QOffscreenSurface surface;
+    surface.setFormat(format);
+    surface.create();
+
+    QOpenGLContext context;
+    context.setFormat(format);
+    if (!context.create() || !context.makeCurrent(&surface))
+    {
+        std::fprintf(stderr, "cannot create an OpenGL %d.%d context\n", format.majorVersion(), format.minorVersion());
+        return 1;
+    }
+
+    QOpenGLFramebufferObjectFormat fboFormat;
+    fboFormat.setAttachment(QOpenGLFramebufferObject::CombinedDepthStencil);
+    QOpenGLFramebufferObject fbo(size, fboFormat);
+    fbo.bind();
+
+    QOpenGLExtraFunctions *ef = context.extraFunctions();
+    ef->glViewport(0, 0, size.width(), size.height());
+    ef->glEnable(GL_DEPTH_TEST);
+
+    // QOpenGLPanel::initBeltParticles ile aynı kuşaklar
+    BeltParticles particles;
+    particles.addBelt({ 38.0f, 46.0f, 0.2f, 10.0f, 0.5f, 0.03f, 0.12f, QVector3D(0.55f, 0.5f, 0.45f) },
+                      parser.value(asteroidsOption).toInt(), 2024);
+    particles.addBelt({ 90.0f, 120.0f, 0.15f, 20.0f, 0.06f, 0.05f, 0.15f, QVector3D(0.6f, 0.65f, 0.75f) },
+                      parser.value(kuiperOption).toInt(), 1992);
+
+    QElapsedTimer timer;
+    timer.start();
+    ShaderCache shaders;
+    if (!particles.initialize(ef, shaders))
+    {
+        std::fprintf(stderr, "cannot initialize belt particles\n");
+        return 1;
+    }
+    ef->glFinish();
+    const double uploadMs = timer.nsecsElapsed() / 1.0e6;
+
+    // QOpenGLPanel'in başlangıç kamerası
+    QMatrix4x4 translate, camera, projection;
+    camera.lookAt(QVector3D(20.0f, 50.0f, 80.0f), QVector3D(0.0f, 0.0f, 0.0f), QVector3D(0.0f, 1.0f, 0.0f));
+    projection.perspective(110.0f, float(size.width()) / float(size.height()), 0.1f, 500.0f);
+    const float pixelScale = 0.5f * float(size.height()) * projection(1, 1);
+    // kamera sabit; Frame bloğu bir kez yüklenir
+    FrameUniforms frameUniforms;
+    frameUniforms.create(ef);
+    frameUniforms.update(ef, camera * translate, projection, pixelScale);
+
+    QOpenGLTimerQuery updateTimer, drawTimer;
+    const bool hasGpuTimer = updateTimer.create() && drawTimer.create();
+
+    double updateMs = 0.0, drawMs = 0.0;
+    for (int frame = 0; frame <= frames; ++frame)
+    {
+        ef->glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        // ilk kare ısınma; ölçüme girmez
+        double update = 0.0, draw = 0.0;
+        if (hasGpuTimer)
+        {
+            updateTimer.begin();
+            particles.update(ef, frame + 0.5);
+            updateTimer.end();
+            drawTimer.begin();
+            particles.draw(ef, frameUniforms, QVector3D(), 1.0f);
+            drawTimer.end();
+            update = updateTimer.waitForResult() / 1.0e6;
+            draw = drawTimer.waitForResult() / 1.0e6;
+        }
+        else
+        {
+            timer.restart();
+            particles.update(ef, frame + 0.5);
+            ef->glFinish();
+            update = timer.nsecsElapsed() / 1.0e6;
+            timer.restart();
+            particles.draw(ef, frameUniforms, QVector3D(), 1.0f);
+            ef->glFinish();
+            draw = timer.nsecsElapsed() / 1.0e6;
+        }
+        if (frame > 0)
+        {
+            updateMs += update;
+            drawMs += draw;
+        }
+    }
+    updateMs /= frames;
+    drawMs /= frames;
+
+    const int count = particles.size();
+    const QString renderer = QString::fromLatin1(reinterpret_cast<const char *>(ef->glGetString(GL_RENDERER)));
+    if (parser.isSet(jsonOption))
+    {
+        QJsonObject result;
+        result.insert("renderer", renderer);
+        result.insert("particles", count);
+        result.insert("width", size.width());
+        result.insert("height", size.height());
+        result.insert("frames", frames);
+        result.insert("gpuTimer", hasGpuTimer);
+        result.insert("uploadMs", uploadMs);
+        result.insert("updateMs", updateMs);
+        result.insert("drawMs", drawMs);
+        result.insert("updateParticlesPerMs", count / updateMs);
+        result.insert("drawParticlesPerMs", count / drawMs);
+        std::printf("%s", QJsonDocument(result).toJson(QJsonDocument::Indented).constData());
+    }
+    else
+    {
+        std::printf("renderer: %s, %d particles, %dx%d, %d frames, %s\n", qPrintable(renderer), count,
+                    size.width(), size.height(), frames, hasGpuTimer ? "GPU timer" : "glFinish wall clock");
+        std::printf("generate + upload: %.2f ms\n", uploadMs);
+        std::printf("update: %9.3f ms %12.0f particles/ms\n", updateMs, count / updateMs);
+        std::printf("draw:   %9.3f ms %12.0f particles/ms\n", drawMs, count / drawMs);
+    }
+    return 0;
+}
@@ -0,0 +1,305 @@
+// OpenGLKamera sahnesini pencere açmadan (QOffscreenSurface + FBO) çizer ve
+// kare sürelerini ölçer. Çizim QOpenGLPanel'in kendi initializeGL/paintGL'i ile yapılır.
+// Kullanım: RenderBench [--frames N] [--warmup N] [--size 1280x720] [--belt N] [--no-lod] [--no-state-cache]
+//                    [--render-path perbody|instanced|procedural] [--simulation kepler|nbody] [--theta T]
+//                    [--inline-simulation] [--profile] [--trace dosya.json]
+//                    [--collisions flag|bounce|merge] [--belt-particles N] [--kuiper-particles N] [--json]
+// Ekransız makinelerde Mesa llvmpipe ile: QT_QPA_PLATFORM=offscreen LIBGL_ALWAYS_SOFTWARE=1 RenderBench
+#include "../qopenglpanel.h"
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QOffscreenSurface>
+#include <QOpenGLContext>
+#include <QtOpenGL/QOpenGLFramebufferObject>
+#include <QtOpenGL/QOpenGLTimerQuery>
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+struct FrameStats {
+    double mean, p50, p95, p99, max;
+};
+
+static FrameStats summarize(std::vector<double> samples)
+{
+    FrameStats stats = { 0.0, 0.0, 0.0, 0.0, 0.0 };
+    if (samples.empty())
+        return stats;
+
+    std::sort(samples.begin(), samples.end());
+    for (double sample : samples)
+        stats.mean += sample;
+    stats.mean /= double(samples.size());
+
+    // en yakın sıra yöntemi
+    auto percentile = [&samples](double p) {
+        size_t rank = size_t(p / 100.0 * double(samples.size()) + 0.5);
+        return samples[qBound<size_t>(1, rank, samples.size()) - 1];
+    };
+    stats.p50 = percentile(50.0);
+    stats.p95 = percentile(95.0);
+    stats.p99 = percentile(99.0);
+    stats.max = samples.back();
+    return stats;
+}
+
+static QJsonObject toJson(const FrameStats &stats)
+{
+    QJsonObject object;
+    object.insert("mean", stats.mean);
+    object.insert("p50", stats.p50);
+    object.insert("p95", stats.p95);
+    object.insert("p99", stats.p99);
+    object.insert("max", stats.max);
+    return object;
+}
+
+int main(int argc, char *argv[])
+{
+    // OpenGLKamera ile aynı bağlam
+    QSurfaceFormat format;
+    format.setDepthBufferSize(24);
+    format.setStencilBufferSize(8);
+    format.setVersion(4,3);
+    format.setProfile(QSurfaceFormat::CoreProfile);
+    QSurfaceFormat::setDefaultFormat(format);
+
+    QApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Renders the solar system offscreen and reports frame times");
+    parser.addHelpOption();
+    QCommandLineOption framesOption("frames", "Number of measured frames.", "count", "500");
+    QCommandLineOption warmupOption("warmup", "Frames rendered before measuring.", "count", "30");
+    QCommandLineOption sizeOption("size", "Framebuffer size.", "WxH", "1280x720");
+    QCommandLineOption beltOption("belt", "Extra small bodies added to the scene.", "count", "0");
+    QCommandLineOption noLodOption("no-lod", "Draw every body with the fixed 64x64/32x32 spheres.");
+    QCommandLineOption noStateCacheOption("no-state-cache", "Send every bind and uniform write, even when redundant.");
+    QCommandLineOption pathOption("render-path", "perbody, instanced or procedural.", "path", "instanced");
+    QCommandLineOption simulationOption("simulation", "kepler or nbody.", "mode", "kepler");
+    QCommandLineOption inlineSimulationOption("inline-simulation", "Step the simulation inside paintGL instead of its thread.");
+    QCommandLineOption thetaOption("theta", "Barnes-Hut opening angle in nbody mode.", "theta", "0.5");
+    QCommandLineOption collisionsOption("collisions", "Check bounding spheres every step: flag, bounce or merge.", "response");
+    QCommandLineOption beltParticlesOption("belt-particles", "GPU particles in the asteroid belt.", "count", "0");
+    QCommandLineOption kuiperParticlesOption("kuiper-particles", "GPU particles in the Kuiper belt.", "count", "0");
+    QCommandLineOption profileOption("profile", "Report profiler zones per frame instead of the whole-frame GPU timer.");
+    QCommandLineOption traceOption("trace", "Write the measured frames as Chrome trace JSON (implies --profile).", "file");
+    QCommandLineOption jsonOption("json", "Print the results as JSON.");
+    parser.addOption(framesOption);
+    parser.addOption(warmupOption);
+    parser.addOption(sizeOption);
+    parser.addOption(beltOption);
+    parser.addOption(noLodOption);
+    parser.addOption(noStateCacheOption);
+    parser.addOption(pathOption);
+    parser.addOption(simulationOption);
+    parser.addOption(thetaOption);
+    parser.addOption(inlineSimulationOption);
+    parser.addOption(collisionsOption);
+    parser.addOption(beltParticlesOption);
+    parser.addOption(kuiperParticlesOption);
+    parser.addOption(profileOption);
+    parser.addOption(traceOption);
+    parser.addOption(jsonOption);
+    parser.process(app);
+
+    const int frames = qMax(1, parser.value(framesOption).toInt());
+    const int warmup = qMax(0, parser.value(warmupOption).toInt());
+    const QStringList sizeParts = parser.value(sizeOption).split('x');
+    const QSize size(sizeParts.value(0).toInt(), sizeParts.value(1).toInt());
+    if (size.isEmpty())
+    {
+        std::fprintf(stderr, "invalid --size %s\n", qPrintable(parser.value(sizeOption)));
+        return 1;
+    }
+
+    QOffscreenSurface surface;
+    surface.setFormat(format);
+    surface.create();
+
+    QOpenGLContext context;
+    context.setFormat(format);
+    if (!context.create() || !context.makeCurrent(&surface))
+    {
+        std::fprintf(stderr, "cannot create an OpenGL %d.%d context\n", format.majorVersion(), format.minorVersion());
+        return 1;
+    }
+
+    QOpenGLFramebufferObjectFormat fboFormat;
+    fboFormat.setAttachment(QOpenGLFramebufferObject::CombinedDepthStencil);
+    QOpenGLFramebufferObject fbo(size, fboFormat);
+    fbo.bind();
+
+    QOpenGLFunctions *f = context.functions();
+    f->glViewport(0, 0, size.width(), size.height());
+
+    // panel hiç gösterilmez; yalnızca sahne kodu için kullanılır
+    QOpenGLPanel panel;
+    panel.resize(size);
+    panel.setBeltBodyCount(parser.value(beltOption).toInt());
+    panel.setBeltParticleCount(parser.value(beltParticlesOption).toInt(), parser.value(kuiperParticlesOption).toInt());
+    if (parser.isSet(noLodOption))
+        panel.setLevelOfDetail(false);
+    if (parser.isSet(noStateCacheOption))
+        panel.setStateCache(false);
+    const QString pathName = parser.value(pathOption);
+    panel.setRenderPath(pathName == "perbody" ? QOpenGLPanel::PerBodyPath
+                        : pathName == "procedural" ? QOpenGLPanel::ProceduralPath : QOpenGLPanel::InstancedPath);
+    const QString simulationName = parser.value(simulationOption);
+    if (simulationName == "nbody")
+    {
+        panel.setSimulationMode(QOpenGLPanel::NBodyMode);
+        panel.setNBodyTheta(parser.value(thetaOption).toFloat());
+    }
+    if (parser.isSet(inlineSimulationOption))
+        panel.setSimulationThread(false);
+    // sahne doğrulaması: iç içe başlayan ya da ölçüm boyunca çakışan cisimler raporlanır
+    const QString collisionName = parser.value(collisionsOption);
+    if (parser.isSet(collisionsOption))
+        panel.setCollisionDetection(true, collisionName == "bounce" ? CollisionDetector::Bounce
+                                    : collisionName == "merge" ? CollisionDetector::Merge : CollisionDetector::Flag);
+
+    // profilci varsayılan olarak kapalı; ölçülen kareler izlenir (ısınma kareleri 0..warmup-1)
+    const bool profiling = parser.isSet(profileOption) || parser.isSet(traceOption);
+    FrameProfiler &profiler = panel.frameProfiler();
+    profiler.setEnabled(profiling);
+    profiler.setHistorySize(frames);
+    if (parser.isSet(traceOption))
+        profiler.captureTrace(parser.value(traceOption), warmup, warmup + frames - 1);
+
+    QElapsedTimer timer;
+    timer.start();
+    panel.initializeGL();
+    panel.resizeGL(size.width(), size.height());
+    f->glFinish();
+    const double initMs = timer.nsecsElapsed() / 1.0e6;
+
+    timer.restart();
+    panel.finishTextureLoading();
+    f->glFinish();
+    const double texturesMs = timer.nsecsElapsed() / 1.0e6;
+
+    // panel gösterilmediği için saat duraklatılmış kalırdı; adımlar ısınmadan itibaren sayılır
+    panel.startSimulation();
+    for (int i = 0; i < warmup; ++i)
+        panel.paintGL();
+    f->glFinish();
+
+    // GL_TIME_ELAPSED sorguları iç içe olamaz; profilci açıkken GPU süreleri onun bölgelerinden gelir
+    QOpenGLTimerQuery gpuTimer;
+    const bool hasGpuTimer = !profiling && gpuTimer.create();
+
+    std::vector<double> cpuMs, gpuMs;
+    cpuMs.reserve(frames);
+    gpuMs.reserve(frames);
+    for (int i = 0; i < frames; ++i)
+    {
+        if (hasGpuTimer)
+            gpuTimer.begin();
+
+        timer.restart();
+        panel.paintGL();
+        cpuMs.push_back(timer.nsecsElapsed() / 1.0e6);
+
+        // sonucu beklemek sonraki karenin CPU süresine yansımaz, ölçüm paintGL çağrısını kapsar
+        if (hasGpuTimer)
+        {
+            gpuTimer.end();
+            gpuMs.push_back(gpuTimer.waitForResult() / 1.0e6);
+        }
+    }
+
+    // çarpışma sayaçları iş parçacığında güncellenir; okumadan önce durdurulur
+    const bool simulationThread = panel.simulationThreadRunning();
+    profiler.flush();
+    const std::vector<std::pair<QString, double>> zones = profiler.averages(frames);
+    const double stepMs = panel.simulationStepMs();
+    panel.finishSimulation();
+
+    const FrameStats cpu = summarize(cpuMs);
+    const FrameStats gpu = summarize(gpuMs);
+    const QString renderer = QString::fromLatin1(reinterpret_cast<const char *>(f->glGetString(GL_RENDERER)));
+
+    if (parser.isSet(jsonOption))
+    {
+        QJsonObject result;
+        result.insert("renderer", renderer);
+        result.insert("renderPath", pathName);
+        result.insert("simulation", simulationName);
+        result.insert("simulationThread", simulationThread);
+        result.insert("simulationStepMs", stepMs);
+        result.insert("width", size.width());
+        result.insert("height", size.height());
+        result.insert("frames", frames);
+        result.insert("warmup", warmup);
+        result.insert("initMs", initMs);
+        result.insert("texturesMs", texturesMs);
+        result.insert("verticesPerFrame", panel.drawnVertices());
+        result.insert("fullDetailVerticesPerFrame", panel.fullDetailVertices());
+        result.insert("drawnBodies", panel.drawnBodies());
+        result.insert("culledBodies", panel.culledBodies());
+        result.insert("glCallsPerFrame", panel.glCalls());
+        result.insert("glCallsWithoutStateCache", panel.glCalls() + panel.skippedGlCalls());
+        result.insert("beltParticles", panel.beltParticles().size());
+        if (parser.isSet(collisionsOption))
+        {
+            QJsonObject collisions;
+            collisions.insert("response", collisionName);
+            collisions.insert("tests", panel.collisionTests());
+            collisions.insert("overlaps", double(panel.totalOverlaps()));
+            collisions.insert("resolved", double(panel.resolvedCollisions()));
+            collisions.insert("lastDetectMs", panel.collisionDetector().detectNsecs() / 1.0e6);
+            result.insert("collisions", collisions);
+        }
+        result.insert("cpuFrameMs", toJson(cpu));
+        if (hasGpuTimer)
+            result.insert("gpuFrameMs", toJson(gpu));
+        if (profiling)
+        {
+            QJsonObject zoneMs;
+            for (const auto &zone : zones)
+                zoneMs.insert(zone.first, zone.second);
+            result.insert("zonesMs", zoneMs);
+        }
+        std::printf("%s", QJsonDocument(result).toJson(QJsonDocument::Indented).constData());
+    }
+    else
+    {
+        std::printf("renderer: %s, %s path, %s simulation, %dx%d, %d frames\n", qPrintable(renderer),
+                    qPrintable(pathName), qPrintable(simulationName), size.width(), size.height(), frames);
+        std::printf("init: %.2f ms, textures: %.2f ms\n", initMs, texturesMs);
+        std::printf("simulation step: %.3f ms (%s)\n", stepMs, simulationThread ? "own thread" : "inside paintGL");
+        std::printf("vertices per frame: %lld (%lld without LOD)\n",
+                    (long long)panel.drawnVertices(), (long long)panel.fullDetailVertices());
+        std::printf("bodies drawn: %d, culled: %d\n", panel.drawnBodies(), panel.culledBodies());
+        std::printf("GL calls per frame: %d (%d without state cache)\n", panel.glCalls(),
+                    panel.glCalls() + panel.skippedGlCalls());
+        if (panel.beltParticles().size() > 0)
+            std::printf("belt particles: %d\n", panel.beltParticles().size());
+        if (parser.isSet(collisionsOption))
+            std::printf("collisions (%s): %d tests, %lld overlaps, %lld resolved, last detect %.3f ms\n",
+                        qPrintable(collisionName), panel.collisionTests(), (long long)panel.totalOverlaps(),
+                        (long long)panel.resolvedCollisions(), panel.collisionDetector().detectNsecs() / 1.0e6);
+        std::printf("cpu frame ms: mean %.3f p50 %.3f p95 %.3f p99 %.3f max %.3f\n",
+                    cpu.mean, cpu.p50, cpu.p95, cpu.p99, cpu.max);
+        if (hasGpuTimer)
+            std::printf("gpu frame ms: mean %.3f p50 %.3f p95 %.3f p99 %.3f max %.3f\n",
+                        gpu.mean, gpu.p50, gpu.p95, gpu.p99, gpu.max);
+        else if (!profiling)
+            std::printf("gpu frame ms: timer queries unavailable\n");
+        if (profiling)
+        {
+            std::printf("zones (ms per frame, %lld GPU frames dropped):\n", (long long)profiler.droppedGpuFrames());
+            for (const auto &zone : zones)
+                std::printf("  %-26s %8.3f\n", qPrintable(zone.first), zone.second);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,531 @@
+#include "bodystore.h"
+#include "keplersolver.h"
+#include "modelmatrixkernel.h"
+
+#include <QtConcurrent/QtConcurrentMap>
+#include <QtMath>
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// blok başına ara diziler yığında tutulur ve L1 önbelleğe sığar
+const int blockSize = 256;
+// bu sayının altında iş parçacığı başlatmanın maliyeti kazançtan büyük
+const int parallelThreshold = 32768;
+const int chunkSize = 16384;
+
+// phase + rate * t double'da hesaplanıp [-180, 180] aralığına indirgenir; sonuç t ne kadar
+// büyük olursa olsun aynı duyarlıktadır ve yalnızca t'ye bağlıdır (adımların birikmesine değil).
+// 360 * k tam gösterilir ve yakın iki sayının farkı kesindir; hata yalnızca rate * t çarpımından gelir.
+inline float angleAt(float phase, float rate, double time)
+{
+    const double degrees = double(phase) + double(rate) * time;
+    return float(degrees - 360.0 * std::floor(degrees * (1.0 / 360.0) + 0.5));
+}
+
+}
+
+int BodyStore::addBody(int parentIndex, const OrbitalElements &orbit, float spinSpeed,
+                       float scaleMultp, GLuint textureID, GLint layer, int meshID)
+{
+    Q_ASSERT(parentIndex < size());
+
+    orbitRadius.push_back(0.0f);
+    eccentricity.push_back(0.0f);
+    semiMinorAxis.push_back(0.0f);
+    majorAxisX.push_back(0.0f);
+    majorAxisY.push_back(0.0f);
+    majorAxisZ.push_back(0.0f);
+    minorAxisX.push_back(0.0f);
+    minorAxisY.push_back(0.0f);
+    minorAxisZ.push_back(0.0f);
+    orbitRate.push_back(0.0f);
+    spinRate.push_back(spinSpeed);
+    scale.push_back(scaleMultp);
+    parent.push_back(parentIndex);
+    texture.push_back(textureID);
+    textureLayer.push_back(layer);
+    mesh.push_back(meshID);
+
+    orbitPhase.push_back(0.0f);
+    spinPhase.push_back(0.0f);
+    orbitAngle.push_back(0.0f);
+    spinAngle.push_back(angleAt(0.0f, spinSpeed, simulationTime));
+    localMatrix.emplace_back();
+    orbitMatrix.emplace_back();
+    modelMatrix.emplace_back();
+    dirty.push_back(1);
+    worldChanged.push_back(1);
+    placedExternally.push_back(0);
+    modelData.resize(modelData.size() + 16, 0.0f);
+    systemRadius.push_back(scaleMultp);
+    systemVisible.push_back(1);
+    visible.push_back(1);
+
+    setOrbit(size() - 1, orbit);
+    return size() - 1;
+}
+
+int BodyStore::addBody(int parentIndex, float radius, float orbitSpeed, float spinSpeed,
+                       float scaleMultp, GLuint textureID, GLint layer, int meshID)
+{
+    const OrbitalElements orbit = { qAbs(radius), 0.0f, 0.0f, 0.0f, 0.0f, radius < 0.0f ? 180.0f : 0.0f, 0.0f, orbitSpeed };
+    return addBody(parentIndex, orbit, spinSpeed, scaleMultp, textureID, layer, meshID);
+}
+
+void BodyStore::setOrbit(int index, const OrbitalElements &orbit)
+{
+    Q_ASSERT(orbit.eccentricity >= 0.0f && orbit.eccentricity < 1.0f);
+
+    const float e = qBound(0.0f, orbit.eccentricity, 0.99f);
+    orbitRadius[index] = orbit.semiMajorAxis;
+    eccentricity[index] = e;
+    semiMinorAxis[index] = orbit.semiMajorAxis * std::sqrt(1.0f - e * e);
+    orbitRate[index] = orbit.meanMotion;
+    orbitPhase[index] = orbit.meanAnomaly - orbit.meanMotion * orbit.epoch;
+    orbitAngle[index] = angleAt(orbitPhase[index], orbitRate[index], simulationTime);
+
+    QVector3D majorAxis, minorAxis;
+    orbitAxes(orbit, majorAxis, minorAxis);
+    majorAxisX[index] = majorAxis.x();
+    majorAxisY[index] = majorAxis.y();
+    majorAxisZ[index] = majorAxis.z();
+    minorAxisX[index] = minorAxis.x();
+    minorAxisY[index] = minorAxis.y();
+    minorAxisZ[index] = minorAxis.z();
+
+    dirty[index] = 1;
+}
+
+void BodyStore::orbitAxes(const OrbitalElements &orbit, QVector3D &majorAxis, QVector3D &minorAxis)
+{
+    // yörünge düzleminden ekliptiğe: Rz(Ω) * Rx(i) * Rz(ω); sahne (x, y, z) = ekliptik (x, z, -y)
+    const float cosNode = std::cos(qDegreesToRadians(orbit.ascendingNode));
+    const float sinNode = std::sin(qDegreesToRadians(orbit.ascendingNode));
+    const float cosInclination = std::cos(qDegreesToRadians(orbit.inclination));
+    const float sinInclination = std::sin(qDegreesToRadians(orbit.inclination));
+    const float cosPeriapsis = std::cos(qDegreesToRadians(orbit.periapsisArgument));
+    const float sinPeriapsis = std::sin(qDegreesToRadians(orbit.periapsisArgument));
+
+    majorAxis = QVector3D(cosNode * cosPeriapsis - sinNode * sinPeriapsis * cosInclination,
+                          sinPeriapsis * sinInclination,
+                          -(sinNode * cosPeriapsis + cosNode * sinPeriapsis * cosInclination));
+    minorAxis = QVector3D(-cosNode * sinPeriapsis - sinNode * cosPeriapsis * cosInclination,
+                          cosPeriapsis * sinInclination,
+                          -(-sinNode * sinPeriapsis + cosNode * cosPeriapsis * cosInclination));
+}
+
+void BodyStore::reserve(int count)
+{
+    orbitRadius.reserve(count);
+    eccentricity.reserve(count);
+    semiMinorAxis.reserve(count);
+    majorAxisX.reserve(count);
+    majorAxisY.reserve(count);
+    majorAxisZ.reserve(count);
+    minorAxisX.reserve(count);
+    minorAxisY.reserve(count);
+    minorAxisZ.reserve(count);
+    orbitRate.reserve(count);
+    spinRate.reserve(count);
+    scale.reserve(count);
+    parent.reserve(count);
+    texture.reserve(count);
+    textureLayer.reserve(count);
+    mesh.reserve(count);
+    orbitPhase.reserve(count);
+    spinPhase.reserve(count);
+    orbitAngle.reserve(count);
+    spinAngle.reserve(count);
+    localMatrix.reserve(count);
+    orbitMatrix.reserve(count);
+    modelMatrix.reserve(count);
+    dirty.reserve(count);
+    worldChanged.reserve(count);
+    placedExternally.reserve(count);
+    modelData.reserve(16 * size_t(count));
+    systemRadius.reserve(count);
+    systemVisible.reserve(count);
+    visible.reserve(count);
+}
+
+void BodyStore::clear()
+{
+    orbitRadius.clear();
+    eccentricity.clear();
+    semiMinorAxis.clear();
+    majorAxisX.clear();
+    majorAxisY.clear();
+    majorAxisZ.clear();
+    minorAxisX.clear();
+    minorAxisY.clear();
+    minorAxisZ.clear();
+    orbitRate.clear();
+    spinRate.clear();
+    scale.clear();
+    parent.clear();
+    texture.clear();
+    textureLayer.clear();
+    mesh.clear();
+    orbitPhase.clear();
+    spinPhase.clear();
+    orbitAngle.clear();
+    spinAngle.clear();
+    localMatrix.clear();
+    orbitMatrix.clear();
+    modelMatrix.clear();
+    dirty.clear();
+    worldChanged.clear();
+    placedExternally.clear();
+    modelData.clear();
+    systemRadius.clear();
+    systemVisible.clear();
+    visible.clear();
+}
+
+void BodyStore::setTime(double ticks)
+{
+    simulationTime = ticks;
+    const int count = size();
+    for (int i = 0; i < count; ++i)
+    {
+        orbitAngle[i] = angleAt(orbitPhase[i], orbitRate[i], ticks);
+        spinAngle[i] = angleAt(spinPhase[i], spinRate[i], ticks);
+    }
+}
+
+void BodyStore::advance(double ticks)
+{
+    setTime(simulationTime + ticks);
+}
+
+void BodyStore::setMatrixKernel(bool enabled)
+{
+    useKernel = enabled;
+    // referans yolun önbelleğe aldığı matrisler bu arada güncellenmemiş olabilir
+    std::fill(dirty.begin(), dirty.end(), 1);
+}
+
+int BodyStore::updateMatrices(float alpha)
+{
+    // alpha = 1 son adımın açısı, alpha = 0 bir önceki adımın açısı
+    const float back = alpha - 1.0f;
+    if (useKernel)
+        return updateMatricesKernel(back);
+
+    const int count = size();
+    int updated = 0;
+    for (int i = 0; i < count; ++i)
+    {
+        // dönen cismin açısı her karede değişir; duran cisim yalnızca işaretlenince
+        const bool localChanged = dirty[i] || orbitRate[i] != 0.0f;
+        // ebeveyn bu döngüde zaten güncellendi (parent[i] < i)
+        const bool parentChanged = parent[i] >= 0 && worldChanged[parent[i]];
+        worldChanged[i] = localChanged || parentChanged;
+
+        if (localChanged)
+        {
+            localMatrix[i].setToIdentity();
+            localMatrix[i].translate(orbitOffset(i, orbitAngle[i] + orbitRate[i] * back));
+        }
+        if (worldChanged[i])
+        {
+            orbitMatrix[i] = parent[i] >= 0 ? orbitMatrix[parent[i]] * localMatrix[i] : localMatrix[i];
+            ++updated;
+        }
+        if (worldChanged[i] || spinRate[i] != 0.0f || dirty[i])
+        {
+            modelMatrix[i] = orbitMatrix[i] * rotationY(spinAngle[i] + spinRate[i] * back, 0.0f, scale[i]);
+            std::copy(modelMatrix[i].constData(), modelMatrix[i].constData() + 16, modelData.begin() + 16 * size_t(i));
+        }
+        dirty[i] = 0;
+    }
+    return updated;
+}
+
+QVector3D BodyStore::orbitOffset(int index, float meanAnomaly) const
+{
+    float cosE, sinE;
+    KeplerSolver::solve(SimdMath::Scalar, &meanAnomaly, &eccentricity[index], 1, &cosE, &sinE);
+
+    // yörünge düzleminde odak (ebeveyn) merkezli konum
+    const float x = orbitRadius[index] * (cosE - eccentricity[index]);
+    const float y = semiMinorAxis[index] * sinE;
+    return QVector3D(x * majorAxisX[index] + y * minorAxisX[index],
+                     x * majorAxisY[index] + y * minorAxisY[index],
+                     x * majorAxisZ[index] + y * minorAxisZ[index]);
+}
+
+int BodyStore::updateMatricesKernel(float back)
+{
+    const int count = size();
+
+    // referans yoldaki yayılma: yörüngesi dönen ya da işaretlenen cismin ve tüm alt ağacının
+    // konumu değişir. Çekirdek blok bütün olarak çalışır; içinde konumu değişen ya da kendi
+    // ekseni etrafında dönen cisim olmayan bloklar atlanır
+    blockUpdated.resize((count + blockSize - 1) / blockSize);
+    // char yazmaları her şeyle örtüşebilir; diziler yerel göstericilerden okunur
+    const int *parents = parent.data();
+    const float *orbitRates = orbitRate.data(), *spinRates = spinRate.data();
+    const char *dirtyFlags = dirty.data();
+    char *changedFlags = worldChanged.data();
+    int updated = 0;
+    for (int first = 0; first < count; first += blockSize)
+    {
+        const int end = qMin(first + blockSize, count);
+        // cismin kendi değişikliği (vektörleşir); sahnede neredeyse her cisim yörüngede döner
+        char allChanged = 1, anyChanged = 0;
+        for (int i = first; i < end; ++i)
+        {
+            const char changed = dirtyFlags[i] | char(orbitRates[i] != 0.0f);
+            changedFlags[i] = changed;
+            allChanged &= changed;
+            anyChanged |= changed | char(spinRates[i] != 0.0f);
+            updated += changed;
+        }
+        // duran cisimler ebeveynleri değiştiyse taşınır
+        if (!allChanged)
+        {
+            for (int i = first; i < end; ++i)
+            {
+                if (!changedFlags[i] && parents[i] >= 0 && changedFlags[parents[i]])
+                {
+                    changedFlags[i] = 1;
+                    anyChanged = 1;
+                    ++updated;
+                }
+            }
+        }
+        blockUpdated[first / blockSize] = anyChanged;
+    }
+
+    // her cismin matrisi ebeveynine göre konumla yazılır...
+    if (count >= parallelThreshold)
+    {
+        ranges.clear();
+        for (int begin = 0; begin < count; begin += chunkSize)
+            ranges.emplace_back(begin, qMin(begin + chunkSize, count));
+        QtConcurrent::blockingMap(ranges, [this, back](const std::pair<int, int> &range) {
+            updateRange(range.first, range.second, back);
+        });
+    }
+    else
+    {
+        updateRange(0, count, back);
+    }
+
+    // ...ve ebeveynin dünya konumu eklenir; ebeveyn önce geldiği için konumu zaten dünya konumudur.
+    // Atlanan bloklardaki matrisler önceki güncellemeden kalır ve zaten dünya konumundadır
+    for (int i = 0; i < count; ++i)
+    {
+        if (parent[i] < 0 || !blockUpdated[i / blockSize])
+            continue;
+        float *m = modelData.data() + 16 * size_t(i);
+        const float *p = modelData.data() + 16 * size_t(parent[i]);
+        m[12] += p[12];
+        m[13] += p[13];
+        m[14] += p[14];
+    }
+
+    std::fill(dirty.begin(), dirty.end(), 0);
+    return updated;
+}
+
+void BodyStore::updateRange(int begin, int end, float back)
+{
+    float meanAnomaly[blockSize], spin[blockSize], cosE[blockSize], sinE[blockSize];
+    float x[blockSize], y[blockSize], z[blockSize];
+
+    for (int first = begin; first < end; first += blockSize)
+    {
+        const int n = qMin(blockSize, end - first);
+        if (!blockUpdated[first / blockSize])
+            continue;
+
+        for (int j = 0; j < n; ++j)
+        {
+            meanAnomaly[j] = orbitAngle[first + j] + orbitRate[first + j] * back;
+            spin[j] = spinAngle[first + j] + spinRate[first + j] * back;
+        }
+
+        KeplerSolver::solve(meanAnomaly, &eccentricity[first], n, cosE, sinE);
+
+        for (int j = 0; j < n; ++j)
+        {
+            const int i = first + j;
+            const float u = orbitRadius[i] * (cosE[j] - eccentricity[i]);
+            const float v = semiMinorAxis[i] * sinE[j];
+            x[j] = u * majorAxisX[i] + v * minorAxisX[i];
+            y[j] = u * majorAxisY[i] + v * minorAxisY[i];
+            z[j] = u * majorAxisZ[i] + v * minorAxisZ[i];
+        }
+
+        ModelMatrixKernel::compose(spin, &scale[first], x, y, z, n, modelData.data() + 16 * size_t(first));
+    }
+}
+
+void BodyStore::placeBodies(const float *x, const float *y, const float *z, float alpha)
+{
+    const int count = size();
+    const float back = alpha - 1.0f;
+    if (count >= parallelThreshold)
+    {
+        ranges.clear();
+        for (int begin = 0; begin < count; begin += chunkSize)
+            ranges.emplace_back(begin, qMin(begin + chunkSize, count));
+        QtConcurrent::blockingMap(ranges, [=](const std::pair<int, int> &range) {
+            placeRange(range.first, range.second, x, y, z, back);
+        });
+    }
+    else
+    {
+        placeRange(0, count, x, y, z, back);
+    }
+
+    // referans yolun matrisleri artık geçersiz
+    std::fill(dirty.begin(), dirty.end(), 1);
+    std::fill(worldChanged.begin(), worldChanged.end(), 1);
+    std::fill(placedExternally.begin(), placedExternally.end(), 1);
+}
+
+void BodyStore::placeRange(int begin, int end, const float *x, const float *y, const float *z, float back)
+{
+    float spin[blockSize];
+    for (int first = begin; first < end; first += blockSize)
+    {
+        const int n = qMin(blockSize, end - first);
+        for (int j = 0; j < n; ++j)
+            spin[j] = spinAngle[first + j] + spinRate[first + j] * back;
+
+        ModelMatrixKernel::compose(spin, &scale[first], x + first, y + first, z + first, n,
+                                   modelData.data() + 16 * size_t(first));
+    }
+}
+
+void BodyStore::setRelativePositions(const int *indices, const float *x, const float *y, const float *z, int count)
+{
+    if (count == 0)
+        return;
+
+    // önce her cismin kendi farkı, dünya konumları henüz değişmeden...
+    shift.assign(3 * size_t(size()), 0.0f);
+    for (int k = 0; k < count; ++k)
+    {
+        const int i = indices[k];
+        const QVector3D origin = parent[i] >= 0 ? position(parent[i]) : QVector3D();
+        const QVector3D offset = QVector3D(x[k], y[k], z[k]) - (position(i) - origin);
+        shift[3 * size_t(i)] = offset.x();
+        shift[3 * size_t(i) + 1] = offset.y();
+        shift[3 * size_t(i) + 2] = offset.z();
+        placedExternally[i] = 1;
+    }
+
+    // ...sonra ebeveynin toplam farkı eklenerek alt ağaçlara yayılır (parent[i] < i)
+    const int bodyCount = size();
+    for (int i = 0; i < bodyCount; ++i)
+    {
+        float *d = shift.data() + 3 * size_t(i);
+        if (parent[i] >= 0)
+        {
+            const float *p = shift.data() + 3 * size_t(parent[i]);
+            d[0] += p[0];
+            d[1] += p[1];
+            d[2] += p[2];
+        }
+        if (d[0] == 0.0f && d[1] == 0.0f && d[2] == 0.0f)
+            continue;
+        float *m = modelData.data() + 16 * size_t(i);
+        m[12] += d[0];
+        m[13] += d[1];
+        m[14] += d[2];
+        // referans yolun önbelleğindeki matris artık çizilenle aynı değil
+        dirty[i] = 1;
+    }
+}
+
+void BodyStore::orbitState(int index, float gm, QVector3D &relativePosition, QVector3D &relativeVelocity) const
+{
+    relativePosition = orbitOffset(index, orbitAngle[index]);
+    relativeVelocity = QVector3D();
+    if (orbitRadius[index] <= 0.0f || gm <= 0.0f)
+        return;
+
+    float cosE, sinE;
+    KeplerSolver::solve(SimdMath::Scalar, &orbitAngle[index], &eccentricity[index], 1, &cosE, &sinE);
+
+    // dE/dt = n / (1 - e cosE), n = sqrt(gm / a^3); yörünge düzleminde (-a sinE, b cosE) * dE/dt
+    const float a = orbitRadius[index];
+    const float rate = std::sqrt(gm / a) / (a * (1.0f - eccentricity[index] * cosE));
+    const float u = -a * sinE * rate;
+    const float v = semiMinorAxis[index] * cosE * rate;
+    relativeVelocity = QVector3D(u * majorAxisX[index] + v * minorAxisX[index],
+                                 u * majorAxisY[index] + v * minorAxisY[index],
+                                 u * majorAxisZ[index] + v * minorAxisZ[index]);
+}
+
+QMatrix4x4 BodyStore::rotationY(float degrees, float radius, float scaleMultp)
+{
+    // rotate(degrees, 0, 1, 0) * translate(radius, 0, 0) * scale(scaleMultp), açık biçimde
+    const float radians = qDegreesToRadians(degrees);
+    const float c = std::cos(radians), s = std::sin(radians);
+    return QMatrix4x4(c * scaleMultp, 0.0f, s * scaleMultp, c * radius,
+                      0.0f, scaleMultp, 0.0f, 0.0f,
+                      -s * scaleMultp, 0.0f, c * scaleMultp, -s * radius,
+                      0.0f, 0.0f, 0.0f, 1.0f);
+}
+
+void BodyStore::update(double ticks)
+{
+    advance(ticks);
+    updateMatrices(1.0f);
+}
+
+int BodyStore::cull(const Frustum &frustum, float bodyScale)
+{
+    const int count = size();
+
+    // sistem yarıçapları: çocuklar ebeveynden sonra geldiği için ters sırada tek geçiş yeter;
+    // Kepler yörüngesindeki uydu ebeveyninden en çok a * (1 + e) kadar (apoapsis) uzaklaşır.
+    // Konumu dışarıdan verilen cisimler (placedExternally) bu sınırı aşabilir; onlar için
+    // şimdiki gerçek uzaklık da hesaba katılır
+    for (int i = 0; i < count; ++i)
+        systemRadius[i] = scale[i] * bodyScale;
+    for (int i = count - 1; i >= 0; --i)
+    {
+        const int p = parent[i];
+        if (p < 0)
+            continue;
+        float reach = orbitRadius[i] * (1.0f + eccentricity[i]);
+        if (placedExternally[i])
+        {
+            const float *m = model(i), *q = model(p);
+            const float dx = m[12] - q[12], dy = m[13] - q[13], dz = m[14] - q[14];
+            const float distance2 = dx * dx + dy * dy + dz * dz;
+            if (distance2 > reach * reach)
+                reach = std::sqrt(distance2);
+        }
+        systemRadius[p] = qMax(systemRadius[p], reach + systemRadius[i]);
+    }
+
+    int drawn = 0;
+    for (int i = 0; i < count; ++i)
+    {
+        // ebeveynin sistemi dışarıdaysa bu cisim de dışarıdadır
+        if (parent[i] >= 0 && !systemVisible[parent[i]])
+        {
+            systemVisible[i] = 0;
+            visible[i] = 0;
+            continue;
+        }
+
+        const QVector3D center = position(i);
+        const float radius = scale[i] * bodyScale;
+        systemVisible[i] = frustum.intersectsSphere(center, systemRadius[i]);
+        // uyduları görünse de cismin kendisi ekran dışında olabilir
+        visible[i] = systemVisible[i] && (systemRadius[i] == radius || frustum.intersectsSphere(center, radius));
+        drawn += visible[i];
+    }
+    return drawn;
+}
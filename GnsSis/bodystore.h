@@ -0,0 +1,134 @@
+#ifndef BODYSTORE_H
+#define BODYSTORE_H
+
+#include <QMatrix4x4>
+#include <QOpenGLFunctions>
+#include <QVector3D>
+
+#include <utility>
+#include <vector>
+
+#include "frustum.h"
+
+// Kepler yörünge öğeleri. Açılar derece, epoch ve meanMotion adım (tick) cinsinden.
+// Referans düzlem ekliptik; sahnede ekliptik XZ düzlemi, kuzey +Y.
+struct OrbitalElements {
+    float semiMajorAxis;        // a
+    float eccentricity;         // e, 0 <= e < 1
+    float inclination;          // i
+    float ascendingNode;        // Ω, çıkış düğümünün boylamı
+    float periapsisArgument;    // ω, enberi argümanı
+    float meanAnomaly;          // M0, epoch anındaki ortalama anomali
+    float epoch;                // M0'ın geçerli olduğu adım; simülasyon 0'dan başlar
+    float meanMotion;           // n, adım başına ortalama anomali artışı
+};
+
+// Tüm gök cisimlerinin (güneş, gezegenler, uydular) tek tablosu.
+// Her özellik kendi dizisinde tutulur (structure-of-arrays), böylece
+// update() döngüsü belleği sırayla okur ve cisim sayısıyla doğrusal ölçeklenir.
+// Açılar sabit hızla döndüğü için bir önceki adımın açısı (açı - hız) ile bulunur;
+// ara değerleme için ayrı bir kopya tutulmaz. Açılar toplanarak büyümez: her biri
+// double simülasyon zamanından (faz + hız * t) doğrudan hesaplanıp bir tura indirgenir,
+// böylece zamanda ileri-geri atlamak cisim başına O(1)'dir ve uzun çalışmada duyarlık kaybolmaz.
+// Ebeveyn her zaman çocuğundan önce eklenir (parent[i] < i); böylece dönüşüm
+// hiyerarşisi (yıldız → gezegen → uydu → uzay aracı) düz dizide tek geçişte güncellenir.
+// Her cisim ebeveyninin çevresinde bir Kepler elipsinde dolanır: ortalama anomaliden
+// Kepler denklemi çözülür (KeplerSolver), konum yörünge düzleminden sahneye döndürülür.
+// Varsayılan yolda bu ve model matrisleri bloklar halinde toplu (SIMD) hesaplanır,
+// büyük sahnelerde bloklar iş parçacıklarına dağıtılır.
+class BodyStore
+{
+public:
+    int addBody(int parentIndex, const OrbitalElements &orbit, float spinSpeed,
+                float scaleMultp, GLuint textureID, GLint layer, int meshID);
+    // dairesel yörünge; negatif uzaklık cismi ebeveynin öbür yanından başlatır
+    int addBody(int parentIndex, float radius, float orbitSpeed, float spinSpeed,
+                float scaleMultp, GLuint textureID, GLint layer, int meshID);
+    void setOrbit(int index, const OrbitalElements &orbit);
+    // açıları t = ticks anına göre kurar; t negatif olabilir (0 öncesi)
+    void setTime(double ticks);
+    double time() const { return simulationTime; }
+    // setTime(time() + ticks)
+    void advance(double ticks);
+    // matrisleri son iki adım arasındaki alpha oranında ara değerle kurar (1: son adım);
+    // dünya dönüşümü yeniden hesaplanan cisim sayısını döndürür
+    int updateMatrices(float alpha = 1.0f);
+    void update(double ticks = 1.0);
+    // Dünya konumları dışarıdan (ör. NBodySimulation) gelen cisimler için: yörünge hesabı
+    // atlanır, matrisler verilen konum ve ara değerlenmiş dönüş açısıyla toplu kurulur.
+    void placeBodies(const float *x, const float *y, const float *z, float alpha = 1.0f);
+    // updateMatrices ya da placeBodies'den sonra: verilen cisimlerin ebeveyne göre konumunu
+    // değiştirir (ör. Ephemeris), uyduları birlikte taşınır. Dönüş ve ölçek korunur.
+    void setRelativePositions(const int *indices, const float *x, const float *y, const float *z, int count);
+    // ebeveyne göre şimdiki konum ve hız; gm ebeveynin kütle çekim parametresi (G * M),
+    // birimler sahne uzunluğu ve adım (tick)
+    void orbitState(int index, float gm, QVector3D &relativePosition, QVector3D &relativeVelocity) const;
+    // false: cisim başına QMatrix4x4 çarpımlarıyla kurulan referans yol
+    void setMatrixKernel(bool enabled);
+    bool matrixKernel() const { return useKernel; }
+    // görüş hacmi testi; bodyScale geometriye uygulanan ek ölçek (scaleMatrix).
+    // Bir cismin uydu sistemi dışarıdaysa uyduları hiç test edilmez. Çizilecek cisim sayısını döndürür.
+    int cull(const Frustum &frustum, float bodyScale);
+    // parametreleri ya da açıları dışarıdan değiştiren kod çağırmalı (hareketsiz cisimler için)
+    void markDirty(int index) { dirty[index] = 1; }
+    void reserve(int count);
+    void clear();
+    int size() const { return int(parent.size()); }
+
+    // yörünge düzleminde enberiye doğru ve hareket yönündeki birim vektörler (sahne eksenlerinde)
+    static void orbitAxes(const OrbitalElements &orbit, QVector3D &majorAxis, QVector3D &minorAxis);
+    // Y ekseni etrafında dönüş, ardından x yönünde öteleme ve eşit ölçek
+    static QMatrix4x4 rotationY(float degrees, float radius, float scaleMultp);
+
+    // çizimde kullanılan model matrisi (sütun öncelikli 16 float) ve cismin dünya konumu
+    const float *model(int index) const { return modelData.data() + 16 * size_t(index); }
+    QVector3D position(int index) const { return QVector3D(model(index)[12], model(index)[13], model(index)[14]); }
+
+    // sabit parametreler
+    std::vector<float> orbitRadius;     // yarı büyük eksen (a)
+    std::vector<float> eccentricity;
+    std::vector<float> semiMinorAxis;   // a * sqrt(1 - e^2)
+    std::vector<float> majorAxisX, majorAxisY, majorAxisZ;  // enberiye doğru birim vektör (sahnede)
+    std::vector<float> minorAxisX, minorAxisY, minorAxisZ;  // yörünge düzleminde, hareket yönünde
+    std::vector<float> orbitRate;       // adım (tick) başına ortalama anomali (derece)
+    std::vector<float> spinRate;        // adım (tick) başına kendi ekseni etrafında dönüş (derece)
+    std::vector<float> orbitPhase;      // t = 0 anındaki ortalama anomali
+    std::vector<float> spinPhase;       // t = 0 anındaki dönüş açısı
+    std::vector<float> scale;
+    std::vector<int> parent;            // -1: kök (ör. güneş)
+    std::vector<GLuint> texture;
+    std::vector<GLint> textureLayer;    // doku dizisindeki katman (tekil dokuda 0)
+    std::vector<int> mesh;              // QOpenGLPanel::meshes indisi
+
+    // her adımda güncellenen durum
+    std::vector<float> orbitAngle;      // ortalama anomali, -180..180
+    std::vector<float> spinAngle;       // -180..180
+    std::vector<QMatrix4x4> localMatrix;    // referans yol: ebeveyne göre yörünge konumu
+    std::vector<QMatrix4x4> orbitMatrix;    // referans yol: ebeveynin orbitMatrix'i * localMatrix
+    std::vector<QMatrix4x4> modelMatrix;    // referans yol: orbitMatrix * dönüş * ölçek
+    std::vector<char> dirty;                // yerel dönüşüm bir sonraki güncellemede yeniden kurulur
+    std::vector<char> worldChanged;         // son güncellemede dünya dönüşümü değişti
+    std::vector<char> placedExternally;     // konum dışarıdan verilir; cull Kepler sınırına güvenmez
+    std::vector<float> modelData;           // her iki yolun çıktısı: cisim başına 16 float
+
+    // cull() sonucu
+    std::vector<float> systemRadius;        // cismi ve tüm uydularını içeren küre
+    std::vector<char> systemVisible;        // sistem küresi görüş hacmiyle kesişiyor
+    std::vector<char> visible;              // cismin kendisi çizilecek
+
+private:
+    // ebeveyne göre konum; referans yol için tek cisim
+    QVector3D orbitOffset(int index, float meanAnomaly) const;
+    int updateMatricesKernel(float back);
+    // [begin, end) cisimlerinin matrislerini ebeveyne göre konumla yazar
+    void updateRange(int begin, int end, float back);
+    void placeRange(int begin, int end, const float *x, const float *y, const float *z, float back);
+
+    bool useKernel = true;
+    double simulationTime = 0.0;                // adım (tick)
+    std::vector<std::pair<int, int>> ranges;    // iş parçacıklarına dağıtılan bloklar
+    std::vector<char> blockUpdated;             // çekirdek: son güncellemede yeniden yazılan bloklar
+    std::vector<float> shift;                   // setRelativePositions: cisim başına öteleme farkı
+};
+
+#endif // BODYSTORE_H
@@ -0,0 +1,329 @@
+#include "collisiondetector.h"
+
+#include <QElapsedTimer>
+#include <QtConcurrent/QtConcurrentMap>
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// bu sayının altında iş parçacığı başlatmanın maliyeti kazançtan büyük
+const int parallelThreshold = 16384;
+const int chunkSize = 8192;
+// bu kadar ya da daha az cisim içeren seviye kovalarla değil doğrudan taranır
+const int sparseLevel = 27;
+// süpürülmüş yarıçapların bu oranı en alt seviyenin hücresine sığar
+const float cellPercentile = 0.99f;
+
+}
+
+int CollisionDetector::detect(const float *startX, const float *startY, const float *startZ,
+                              const float *endX, const float *endY, const float *endZ, const float *radius, int count)
+{
+    QElapsedTimer timer;
+    timer.start();
+    found.clear();
+    overlaps = 0;
+    grid.clear();
+
+    // süpürülmüş küreler; pay iki cisme yarı yarıya dağıtılır
+    centerX.resize(count);
+    centerY.resize(count);
+    centerZ.resize(count);
+    sweptRadius.resize(count);
+    std::vector<float> activeRadius;
+    activeRadius.reserve(count);
+    for (int i = 0; i < count; ++i)
+    {
+        const float dx = endX[i] - startX[i], dy = endY[i] - startY[i], dz = endZ[i] - startZ[i];
+        centerX[i] = startX[i] + 0.5f * dx;
+        centerY[i] = startY[i] + 0.5f * dy;
+        centerZ[i] = startZ[i] + 0.5f * dz;
+        sweptRadius[i] = radius[i] > 0.0f ? radius[i] + 0.5f * std::sqrt(dx * dx + dy * dy + dz * dz)
+                                              + 0.5f * approachMargin : 0.0f;
+        if (sweptRadius[i] > 0.0f)
+            activeRadius.push_back(sweptRadius[i]);
+    }
+    if (activeRadius.empty())
+    {
+        lastDetectNs = timer.nsecsElapsed();
+        return 0;
+    }
+
+    // En alt seviyeye cisimlerin büyük çoğunluğu sığar. Ortanca alınırsa yarısı bir üst
+    // seviyenin iki kat geniş hücrelerine düşer ve aday sayısı katlanır.
+    const size_t nth = size_t(cellPercentile * float(activeRadius.size() - 1));
+    std::nth_element(activeRadius.begin(), activeRadius.begin() + nth, activeRadius.end());
+    float cell = 2.0f * activeRadius[nth];
+    if (!(cell > 0.0f))
+        cell = 1.0f;
+    for (int l = 0; l < levelCount; ++l)
+    {
+        levelCell[l] = cell;
+        inverseCell[l] = 1.0f / cell;
+        levelBodies[l] = 0;
+        cell *= 2.0f;
+    }
+
+    // cisimler seviye ve hücreye göre kovalara (sayarak sıralama)
+    const int activeCount = int(activeRadius.size());
+    int tableBits = 6;
+    while ((1 << tableBits) < 2 * activeCount)
+        ++tableBits;
+    const quint32 bucketCount = 1u << tableBits;
+    bucketMask = bucketCount - 1;
+
+    // Tablonun bitleri eksenlere en alt seviyedeki kutu genişliğiyle orantılı dağıtılır; ince
+    // bir diskte (kuşak, halka) kalınlık ekseni az bit alır.
+    float minX = HUGE_VALF, minY = HUGE_VALF, minZ = HUGE_VALF;
+    float maxX = -HUGE_VALF, maxY = -HUGE_VALF, maxZ = -HUGE_VALF;
+    for (int i = 0; i < count; ++i)
+    {
+        if (sweptRadius[i] <= 0.0f)
+            continue;
+        minX = qMin(minX, centerX[i]);
+        minY = qMin(minY, centerY[i]);
+        minZ = qMin(minZ, centerZ[i]);
+        maxX = qMax(maxX, centerX[i]);
+        maxY = qMax(maxY, centerY[i]);
+        maxZ = qMax(maxZ, centerZ[i]);
+    }
+    int bits[3];
+    const float extent[3] = { maxX - minX, maxY - minY, maxZ - minZ };
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        const float cells = extent[axis] * inverseCell[0] + 2.0f;
+        bits[axis] = 0;
+        while (bits[axis] < 20 && float(1 << bits[axis]) < cells)
+            ++bits[axis];
+    }
+    // eksen başına en az 2 bit: -1, 0 ve +1 komşuları farklı kovalara düşer
+    for (int axis = 0; axis < 3; ++axis)
+        bits[axis] = qMax(bits[axis], 2);
+    while (bits[0] + bits[1] + bits[2] > tableBits)
+        --*std::max_element(bits, bits + 3);
+    minimumBits = *std::min_element(bits, bits + 3);
+    bitsX = bits[0];
+    bitsY = bits[1];
+    maskX = (1u << bits[0]) - 1;
+    maskY = (1u << bits[1]) - 1;
+    maskZ = (1u << bits[2]) - 1;
+    level.resize(count);
+    bucket.resize(count);
+    bucketStart.assign(bucketCount + 1, 0);
+    for (int i = 0; i < count; ++i)
+    {
+        if (sweptRadius[i] <= 0.0f)
+        {
+            level[i] = -1;
+            continue;
+        }
+        // en üst seviyeye sığmayan cisimler de oraya girer (komşu taraması eksik kalır);
+        // bu, cisimlerin çoğundan 2^15 kat büyük bir cisim demektir
+        int l = 0;
+        while (l + 1 < levelCount && sweptRadius[i] > 0.5f * levelCell[l])
+            ++l;
+        level[i] = char(l);
+        ++levelBodies[l];
+        bucket[i] = bucketOf(l, int(std::floor(centerX[i] * inverseCell[l])), int(std::floor(centerY[i] * inverseCell[l])),
+                             int(std::floor(centerZ[i] * inverseCell[l])));
+        ++bucketStart[bucket[i] + 1];
+    }
+    for (quint32 b = 0; b < bucketCount; ++b)
+        bucketStart[b + 1] += bucketStart[b];
+    grid.resize(activeCount);
+    for (int l = 0; l < levelCount; ++l)
+        levelMembers[l].clear();
+    std::vector<int> next(bucketStart.begin(), bucketStart.end() - 1);
+    for (int i = 0; i < count; ++i)
+    {
+        if (level[i] < 0)
+            continue;
+        // dar faz da yalnızca kaydı okur; çağıranın dizilerine rastgele erişilmez
+        const GridEntry entry = { centerX[i], centerY[i], centerZ[i], sweptRadius[i],
+                                  startX[i], startY[i], startZ[i],
+                                  endX[i] - startX[i], endY[i] - startY[i], endZ[i] - startZ[i],
+                                  radius[i], i, level[i] };
+        grid[next[bucket[i]]++] = entry;
+        if (levelBodies[entry.level] <= sparseLevel)
+            levelMembers[entry.level].push_back(entry);
+    }
+
+    // kova sırasında gezilir: aynı hücredeki cisimler art arda, komşu kovalar önbellekte
+    const int gridCount = int(grid.size());
+    ranges.clear();
+    if (gridCount >= parallelThreshold)
+    {
+        for (int begin = 0; begin < gridCount; begin += chunkSize)
+            ranges.emplace_back(begin, qMin(begin + chunkSize, gridCount));
+    }
+    else
+    {
+        ranges.emplace_back(0, gridCount);
+    }
+    rangeContacts.resize(ranges.size());
+    if (ranges.size() > 1)
+    {
+        QtConcurrent::blockingMap(ranges, [this](const std::pair<int, int> &range) {
+            const size_t index = size_t(&range - ranges.data());
+            rangeContacts[index].clear();
+            findPairs(range.first, range.second, rangeContacts[index]);
+        });
+    }
+    else
+    {
+        rangeContacts[0].clear();
+        findPairs(ranges[0].first, ranges[0].second, rangeContacts[0]);
+    }
+    for (const std::vector<Contact> &contacts : rangeContacts)
+        found.insert(found.end(), contacts.begin(), contacts.end());
+
+    std::sort(found.begin(), found.end(), [](const Contact &a, const Contact &b) {
+        return a.first != b.first ? a.first < b.first : a.second < b.second;
+    });
+    for (const Contact &contact : found)
+        overlaps += contact.separation < 0.0f;
+    lastDetectNs = timer.nsecsElapsed();
+    return int(found.size());
+}
+
+void CollisionDetector::findPairs(int begin, int end, std::vector<Contact> &out) const
+{
+    std::vector<quint32> buckets;
+    for (int k = begin; k < end; ++k)
+    {
+        const GridEntry &entry = grid[k];
+        const int own = entry.level;
+
+        // Aynı seviye: her iki küre de hücreye sığar, kesişen çift komşu hücrelerdedir. Her çift
+        // bir kez bulunsun diye yalnızca kendi hücresi (daha büyük indisli cisimler) ve "ileri"
+        // 13 komşu taranır. Eksen başına en az 2 bit olduğundan komşular farklı kovalara düşer.
+        const int cellX = int(std::floor(entry.x * inverseCell[own]));
+        const int cellY = int(std::floor(entry.y * inverseCell[own]));
+        const int cellZ = int(std::floor(entry.z * inverseCell[own]));
+        const quint32 home = bucketOf(own, cellX, cellY, cellZ);
+        for (int m = bucketStart[home]; m < bucketStart[home + 1]; ++m)
+        {
+            if (grid[m].body > entry.body)
+                testNearby(entry, grid[m], own, out);
+        }
+        for (int dz = 0; dz <= 1; ++dz)
+        {
+            for (int dy = dz == 0 ? 0 : -1; dy <= 1; ++dy)
+            {
+                for (int dx = dz == 0 && dy == 0 ? 1 : -1; dx <= 1; ++dx)
+                {
+                    const quint32 b = bucketOf(own, cellX + dx, cellY + dy, cellZ + dz);
+                    for (int m = bucketStart[b]; m < bucketStart[b + 1]; ++m)
+                        testNearby(entry, grid[m], own, out);
+                }
+            }
+        }
+
+        // Üstteki seyrek seviyeler (birkaç büyük cisim) doğrudan sınanır.
+        for (int l = own + 1; l < levelCount; ++l)
+        {
+            if (levelBodies[l] > 0 && levelBodies[l] <= sparseLevel)
+            {
+                for (const GridEntry &other : levelMembers[l])
+                    testNearby(entry, other, l, out);
+            }
+        }
+
+        // Yoğun bir seviyedeki cisim alttaki yoğun seviyelerle çiftlerini kendisi arar: yarıçapı
+        // alt hücrenin 2^(fark - 1) katına kadar çıkabildiğinden komşuluk o kadar genişler.
+        // Böylece kalabalık alt seviye her cisim için üst seviyenin 27 kovasına bakmaz.
+        // Alttaki seyrek seviyeler yukarı yalnızca seyrek seviyelere baktığı için burada
+        // doğrudan sınanır.
+        if (levelBodies[own] <= sparseLevel)
+            continue;
+        for (int l = 0; l < own; ++l)
+        {
+            if (levelBodies[l] <= sparseLevel)
+            {
+                for (const GridEntry &other : levelMembers[l])
+                    testNearby(entry, other, l, out);
+                continue;
+            }
+            const int range = (1 << (own - l - 1)) + 1;
+            const int lowX = int(std::floor(entry.x * inverseCell[l]));
+            const int lowY = int(std::floor(entry.y * inverseCell[l]));
+            const int lowZ = int(std::floor(entry.z * inverseCell[l]));
+            buckets.clear();
+            for (int dz = -range; dz <= range; ++dz)
+            {
+                for (int dy = -range; dy <= range; ++dy)
+                {
+                    for (int dx = -range; dx <= range; ++dx)
+                        buckets.push_back(bucketOf(l, lowX + dx, lowY + dy, lowZ + dz));
+                }
+            }
+            // komşuluk tablonun bir eksenini aşarsa katlanır ve aynı kova birden çok kez çıkar
+            if (2 * range + 1 > (1 << minimumBits))
+            {
+                std::sort(buckets.begin(), buckets.end());
+                buckets.erase(std::unique(buckets.begin(), buckets.end()), buckets.end());
+            }
+            for (quint32 b : buckets)
+            {
+                for (int m = bucketStart[b]; m < bucketStart[b + 1]; ++m)
+                    testNearby(entry, grid[m], l, out);
+            }
+        }
+    }
+}
+
+inline void CollisionDetector::testNearby(const GridEntry &entry, const GridEntry &other, int level,
+                                          std::vector<Contact> &out) const
+{
+    // kovayı paylaşan başka seviyedeki cisimler atlanır
+    if (other.level != level)
+        return;
+    const float ex = other.x - entry.x, ey = other.y - entry.y, ez = other.z - entry.z;
+    const float reach = entry.reach + other.reach;
+    if (ex * ex + ey * ey + ez * ez < reach * reach)
+        testPair(entry, other, out);
+}
+
+void CollisionDetector::testPair(const GridEntry &a, const GridEntry &b, std::vector<Contact> &out) const
+{
+    // göreli hareket adım içinde doğrusal: d(t) = d0 + t * dv, en yakın an t in [0, 1]
+    const float d0x = b.startX - a.startX, d0y = b.startY - a.startY, d0z = b.startZ - a.startZ;
+    const float dvx = b.moveX - a.moveX, dvy = b.moveY - a.moveY, dvz = b.moveZ - a.moveZ;
+    const float speed2 = dvx * dvx + dvy * dvy + dvz * dvz;
+    const float t = speed2 > 0.0f ? qBound(0.0f, -(d0x * dvx + d0y * dvy + d0z * dvz) / speed2, 1.0f) : 0.0f;
+
+    const float dx = d0x + t * dvx, dy = d0y + t * dvy, dz = d0z + t * dvz;
+    const float separation = std::sqrt(dx * dx + dy * dy + dz * dz) - (a.radius + b.radius);
+    if (separation < approachMargin)
+        out.push_back({ qMin(a.body, b.body), qMax(a.body, b.body), t, separation });
+}
+
+quint32 CollisionDetector::bucketOf(int level, int cellX, int cellY, int cellZ) const
+{
+    // kutudan büyük sahnede uzak hücreler aynı kovaya katlanır; bu yalnızca aday ekler.
+    // Seviyeler tabloda kaydırılır, kendi içlerinde komşuluk korunur.
+    const quint32 index = (quint32(cellX) & maskX) | (quint32(cellY) & maskY) << bitsX
+                          | (quint32(cellZ) & maskZ) << (bitsX + bitsY);
+    return (index + quint32(level) * 2654435761u) & bucketMask;
+}
+
+int CollisionDetector::occupiedLevels() const
+{
+    int occupied = 0;
+    for (int l = 0; l < levelCount; ++l)
+        occupied += levelBodies[l] > 0;
+    return occupied;
+}
+
+CollisionDetector::Contact CollisionDetector::closestApproach() const
+{
+    Contact closest = { -1, -1, 0.0f, 0.0f };
+    for (const Contact &contact : found)
+    {
+        if (closest.first < 0 || contact.separation < closest.separation)
+            closest = contact;
+    }
+    return closest;
+}
@@ -0,0 +1,93 @@
+#ifndef COLLISIONDETECTOR_H
+#define COLLISIONDETECTOR_H
+
+#include <QtGlobal>
+
+#include <utility>
+#include <vector>
+
+// Sınırlayıcı kürelerin çarpışma ve yakın geçiş testi. Her adımda cismin adım başı ve
+// sonu konumları verilir; küre bu iki nokta arasında doğrusal süpürülür, böylece bir adımda
+// birbirinin içinden geçen hızlı cisimler de yakalanır.
+// Geniş faz düzgün ızgaralardır (uniform spatial hash), hücre kenarı seviyeden seviyeye 2 kat
+// büyür: her cisim çapının sığdığı seviyeye girer. Aynı seviyedeki çiftler kendi hücresinde ve
+// 13 "ileri" komşuda, farklı seviyedekiler büyük cismin çevresindeki alt seviye hücrelerinde
+// aranır. Böylece güneş ile asteroitler aynı sahnede hücreleri şişirmez.
+// Kova, hücre koordinatlarının kutuya göre katlanmış (modulo) bitleridir: komşu hücreler komşu
+// kovalara düşer ve kova sırasında gezilen cisimler önbelleği yeniden kullanır.
+// Çift üretimi büyük sahnelerde QtConcurrent ile bloklara dağıtılır.
+class CollisionDetector
+{
+public:
+    // çarpışan ya da yaklaşan iki cisim, first < second
+    struct Contact {
+        int first, second;
+        float time;         // en yakın anın adım içindeki yeri, 0..1
+        float separation;   // o andaki yüzeyler arası uzaklık; negatif: iç içe
+    };
+
+    // çarpışmalara tepki (yalnızca N-body modunda hareketi değiştirir)
+    enum Response { Flag, Bounce, Merge };
+
+    // yüzeyler arası uzaklığı bundan küçük olan çiftler yakın geçiş olarak raporlanır
+    void setApproachMargin(float margin) { approachMargin = qMax(0.0f, margin); }
+    float margin() const { return approachMargin; }
+
+    // yarıçapı 0 olan cisimler (ör. birleşip silinenler) atlanır; raporlanan çift sayısını döndürür
+    int detect(const float *startX, const float *startY, const float *startZ,
+               const float *endX, const float *endY, const float *endZ, const float *radius, int count);
+
+    // first, second sırasına göre dizili
+    const std::vector<Contact> &contacts() const { return found; }
+    int overlapCount() const { return overlaps; }
+    // en küçük separation'lı çift; çift yoksa first = -1
+    Contact closestApproach() const;
+
+    // en alt seviyenin hücre kenarı ve cisim içeren seviye sayısı
+    float cellSize() const { return levelCell[0]; }
+    int occupiedLevels() const;
+    // son detect çağrısının süresi
+    qint64 detectNsecs() const { return lastDetectNs; }
+
+    static const int levelCount = 16;
+
+private:
+    // ızgaradaki bir cisim: kova sırasında ardışık, tarama belleği sırayla okur
+    struct GridEntry {
+        float x, y, z, reach;   // süpürülmüş küre
+        float startX, startY, startZ;
+        float moveX, moveY, moveZ;
+        float radius;
+        int body;
+        int level;
+    };
+
+    void findPairs(int begin, int end, std::vector<Contact> &out) const;
+    void testNearby(const GridEntry &entry, const GridEntry &other, int level, std::vector<Contact> &out) const;
+    void testPair(const GridEntry &a, const GridEntry &b, std::vector<Contact> &out) const;
+    quint32 bucketOf(int level, int cellX, int cellY, int cellZ) const;
+
+    float approachMargin = 0.0f;
+
+    // süpürülmüş küreler: merkez adımın ortası, yarıçap + yolun yarısı + payın yarısı
+    std::vector<float> centerX, centerY, centerZ, sweptRadius;
+    float levelCell[levelCount] = {}, inverseCell[levelCount] = {};
+    int levelBodies[levelCount] = {};
+    std::vector<char> level;            // -1: yarıçap 0, atlanır
+    quint32 bucketMask = 0;
+    int bitsX = 0, bitsY = 0, minimumBits = 0;
+    quint32 maskX = 0, maskY = 0, maskZ = 0;
+    std::vector<quint32> bucket;
+    std::vector<int> bucketStart;       // kova başına sıralı aralık (bucketMask + 2 eleman)
+    std::vector<GridEntry> grid;        // kova sırasında cisimler
+    // birkaç cisimlik seviyeler (gezegenler, güneş) 27 kova yerine doğrudan sınanır
+    std::vector<GridEntry> levelMembers[levelCount];
+
+    std::vector<std::pair<int, int>> ranges;    // iş parçacıklarına dağıtılan bloklar
+    std::vector<std::vector<Contact>> rangeContacts;
+    std::vector<Contact> found;
+    int overlaps = 0;
+    qint64 lastDetectNs = 0;
+};
+
+#endif // COLLISIONDETECTOR_H
@@ -0,0 +1,247 @@
+#include "ephemeris.h"
+
+#include <QSaveFile>
+#include <QtMath>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+const char magic[8] = { 'G', 'N', 'S', 'E', 'P', 'H', '0', '1' };
+const int headerSize = 8 + 4 + 4 + 3 * 8;
+const int recordSize = 4 * 4 + 2 * 8 + 8;
+// bozuk bir dosyanın seriesByBody'yi şişirmemesi için
+const int maxBodies = 1 << 24;
+
+template <typename T>
+T read(const uchar *p)
+{
+    T value;
+    std::memcpy(&value, p, sizeof(T));
+    return value;
+}
+
+template <typename T>
+void append(QByteArray &out, T value)
+{
+    out.append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+}
+
+bool Ephemeris::open(const QString &path)
+{
+    close();
+    file.reset(new QFile(path));
+    if (!file->open(QFile::ReadOnly) || file->size() < headerSize)
+    {
+        close();
+        return false;
+    }
+
+    const quint64 fileSize = quint64(file->size());
+    const uchar *mapped = file->map(0, file->size());
+    if (!mapped || std::memcmp(mapped, magic, 8) != 0 || read<quint32>(mapped + 8) != 0x04030201)
+    {
+        close();
+        return false;
+    }
+
+    const quint32 count = read<quint32>(mapped + 12);
+    fileUnits.epoch = read<double>(mapped + 16);
+    fileUnits.ticksPerUnit = read<double>(mapped + 24);
+    fileUnits.lengthScale = read<double>(mapped + 32);
+    if (quint64(headerSize) + quint64(count) * recordSize > fileSize || !(fileUnits.ticksPerUnit > 0.0))
+    {
+        close();
+        return false;
+    }
+
+    for (quint32 i = 0; i < count; ++i)
+    {
+        const uchar *p = mapped + headerSize + size_t(i) * recordSize;
+        Record record;
+        record.target = read<qint32>(p);
+        record.center = read<qint32>(p + 4);
+        record.coefficientCount = read<qint32>(p + 8);
+        record.segmentCount = read<qint32>(p + 12);
+        record.start = read<double>(p + 16);
+        record.length = read<double>(p + 24);
+        const quint64 offset = read<quint64>(p + 32);
+
+        // katsayılar eşlenen bellekten doğrudan double olarak okunur
+        const quint64 bytes = quint64(qMax(0, record.segmentCount)) * 3 * quint64(qMax(0, record.coefficientCount)) * 8;
+        if (record.target < 0 || record.target >= maxBodies || record.coefficientCount < 1
+            || record.segmentCount < 1 || !(record.length > 0.0) || offset % 8 != 0 || offset > fileSize || bytes > fileSize - offset)
+        {
+            close();
+            return false;
+        }
+        record.coefficients = reinterpret_cast<const double *>(mapped + offset);
+        record.segment = -1;
+        record.segmentStart = 0.0;
+        record.segmentCoefficients = nullptr;
+        series.push_back(record);
+
+        // cisim başına tek seri; ikincisi hangisinin geçerli olduğunu belirsiz bırakır
+        if (record.target >= int(seriesByBody.size()))
+            seriesByBody.resize(record.target + 1, -1);
+        if (seriesByBody[record.target] >= 0)
+        {
+            close();
+            return false;
+        }
+        seriesByBody[record.target] = int(i);
+    }
+
+    data = mapped;
+    return true;
+}
+
+void Ephemeris::close()
+{
+    // QFile kapanınca eşleme de kalkar
+    file.reset();
+    data = nullptr;
+    fileUnits = { 0.0, 1.0, 1.0 };
+    series.clear();
+    seriesByBody.clear();
+}
+
+int Ephemeris::seriesOf(int body) const
+{
+    return body >= 0 && body < int(seriesByBody.size()) ? seriesByBody[body] : -1;
+}
+
+double Ephemeris::startTicks(int index) const
+{
+    return (series[index].start - fileUnits.epoch) * fileUnits.ticksPerUnit;
+}
+
+double Ephemeris::endTicks(int index) const
+{
+    const Record &record = series[index];
+    return (record.start + record.length * record.segmentCount - fileUnits.epoch) * fileUnits.ticksPerUnit;
+}
+
+bool Ephemeris::covers(int index, double ticks) const
+{
+    return ticks >= startTicks(index) && ticks <= endTicks(index);
+}
+
+const double *Ephemeris::locate(Record &record, double time, double &s)
+{
+    // çoğu çağrı bir önceki parçaya düşer; bölme ve sınır denetimi yalnızca parça değişince
+    if (record.segment < 0 || time < record.segmentStart || time >= record.segmentStart + record.length)
+    {
+        const double index = std::floor((time - record.start) / record.length);
+        record.segment = int(qBound(0.0, index, double(record.segmentCount - 1)));
+        record.segmentStart = record.start + record.length * record.segment;
+        record.segmentCoefficients = record.coefficients + size_t(record.segment) * 3 * size_t(record.coefficientCount);
+    }
+    // kapsam dışı: uçtaki parçanın ucu (polinom dışarıda hızla sapar)
+    s = qBound(-1.0, 2.0 * (time - record.segmentStart) / record.length - 1.0, 1.0);
+    return record.segmentCoefficients;
+}
+
+void Ephemeris::evaluate(const Record &record, const double *coefficients, double s, double out[3]) const
+{
+    // Clenshaw: b_k = c_k + 2 s b_(k+1) - b_(k+2), f = c_0 + s b_1 - b_2; üç bileşen birlikte
+    const int n = record.coefficientCount;
+    const double *cx = coefficients, *cy = coefficients + n, *cz = coefficients + 2 * n;
+    const double twoS = 2.0 * s;
+    double x1 = 0.0, x2 = 0.0, y1 = 0.0, y2 = 0.0, z1 = 0.0, z2 = 0.0;
+    for (int k = n - 1; k >= 1; --k)
+    {
+        const double x0 = cx[k] + twoS * x1 - x2;
+        const double y0 = cy[k] + twoS * y1 - y2;
+        const double z0 = cz[k] + twoS * z1 - z2;
+        x2 = x1, x1 = x0;
+        y2 = y1, y1 = y0;
+        z2 = z1, z1 = z0;
+    }
+    out[0] = (cx[0] + s * x1 - x2) * fileUnits.lengthScale;
+    out[1] = (cy[0] + s * y1 - y2) * fileUnits.lengthScale;
+    out[2] = (cz[0] + s * z1 - z2) * fileUnits.lengthScale;
+}
+
+QVector3D Ephemeris::position(int index, double ticks)
+{
+    Record &record = series[index];
+    double s, out[3];
+    const double *coefficients = locate(record, fileUnits.epoch + ticks / fileUnits.ticksPerUnit, s);
+    evaluate(record, coefficients, s, out);
+    return QVector3D(float(out[0]), float(out[1]), float(out[2]));
+}
+
+void Ephemeris::positions(int index, const double *ticks, int count, float *x, float *y, float *z)
+{
+    Record &record = series[index];
+    for (int i = 0; i < count; ++i)
+    {
+        double s, out[3];
+        const double *coefficients = locate(record, fileUnits.epoch + ticks[i] / fileUnits.ticksPerUnit, s);
+        evaluate(record, coefficients, s, out);
+        x[i] = float(out[0]);
+        y[i] = float(out[1]);
+        z[i] = float(out[2]);
+    }
+}
+
+bool Ephemeris::write(const QString &path, const Units &units, const std::vector<Series> &series)
+{
+    QByteArray out(magic, 8);
+    append<quint32>(out, 0x04030201);
+    append<quint32>(out, quint32(series.size()));
+    append<double>(out, units.epoch);
+    append<double>(out, units.ticksPerUnit);
+    append<double>(out, units.lengthScale);
+
+    // başlık ve seri tablosu 8'in katı; katsayılar hizalı başlar
+    quint64 offset = quint64(headerSize) + quint64(series.size()) * recordSize;
+    for (const Series &s : series)
+    {
+        const size_t segmentSize = 3 * size_t(s.coefficientCount);
+        if (s.coefficientCount < 1 || s.coefficients.empty() || s.coefficients.size() % segmentSize != 0)
+            return false;
+        append<qint32>(out, s.target);
+        append<qint32>(out, s.center);
+        append<qint32>(out, s.coefficientCount);
+        append<qint32>(out, qint32(s.coefficients.size() / segmentSize));
+        append<double>(out, s.start);
+        append<double>(out, s.length);
+        append<quint64>(out, offset);
+        offset += quint64(s.coefficients.size()) * 8;
+    }
+    for (const Series &s : series)
+        out.append(reinterpret_cast<const char *>(s.coefficients.data()), qsizetype(s.coefficients.size() * 8));
+
+    QSaveFile saveFile(path);
+    if (!saveFile.open(QFile::WriteOnly))
+        return false;
+    saveFile.write(out);
+    return saveFile.commit();
+}
+
+void Ephemeris::fit(const std::function<void(double, double[3])> &f,
+                    double start, double length, int coefficientCount, double *out)
+{
+    // n düğümde interpolasyon: c_k = 2/n * sum f(s_j) T_k(s_j), s_j = cos(pi (j + 1/2) / n); c_0 yarıya
+    const int n = coefficientCount;
+    std::fill(out, out + 3 * n, 0.0);
+    for (int j = 0; j < n; ++j)
+    {
+        const double theta = M_PI * (j + 0.5) / n;
+        double position[3];
+        f(start + 0.5 * length * (std::cos(theta) + 1.0), position);
+        for (int k = 0; k < n; ++k)
+        {
+            const double weight = std::cos(k * theta) * (k == 0 ? 1.0 : 2.0) / n;
+            out[k] += weight * position[0];
+            out[n + k] += weight * position[1];
+            out[2 * n + k] += weight * position[2];
+        }
+    }
+}
@@ -0,0 +1,93 @@
+#ifndef EPHEMERIS_H
+#define EPHEMERIS_H
+
+#include <QFile>
+#include <QString>
+#include <QVector3D>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+// Chebyshev katsayılı konum tablosu (JPL DE düzeni). Her cismin zaman ekseni eşit
+// uzunlukta parçalara (segment) bölünür; her parçada x, y ve z ayrı Chebyshev serileridir.
+// Dosya QFile::map ile belleğe eşlenir (mmap), katsayılar kopyalanmaz ve yalnızca okunan
+// sayfalar diskten gelir. Konum Clenshaw yinelemesiyle double'da hesaplanır; her cisim
+// son kullanılan parçayı önbellekte tutar, ardışık karelerde arama yapılmaz.
+//
+// Dosya düzeni (little-endian, katsayılar 8 bayta hizalı):
+//   başlık    magic "GNSEPH01", u32 0x04030201, u32 seri sayısı,
+//             f64 epoch, f64 ticksPerUnit, f64 lengthScale
+//   seri      i32 target, i32 center, i32 katsayı sayısı, i32 parça sayısı,
+//             f64 ilk parçanın başı, f64 parça uzunluğu, u64 katsayıların dosyadaki yeri
+//   katsayı   her parça için x[n], y[n], z[n]
+// Zaman ve uzunluk dosyanın kendi birimindedir (ör. gün ve km); simülasyon adımı t için
+// dosya zamanı epoch + t / ticksPerUnit, sahne uzunluğu dosya uzunluğu * lengthScale olur.
+// target ve center sahnedeki cisim indisleridir (BodyStore); konum center'a göredir.
+class Ephemeris
+{
+public:
+    struct Units {
+        double epoch;           // t = 0 anının dosya zamanı
+        double ticksPerUnit;    // dosya zamanı biriminde adım (tick) sayısı
+        double lengthScale;     // dosya uzunluk biriminden sahne birimine
+    };
+    // write() girdisi
+    struct Series {
+        int target, center;
+        int coefficientCount;
+        double start, length;               // dosya zamanı
+        std::vector<double> coefficients;   // parça başına x, y, z serileri (3 * coefficientCount)
+    };
+
+    // dosya yoksa, bozuksa ya da bir cismin birden çok serisi varsa false
+    bool open(const QString &path);
+    void close();
+    bool isOpen() const { return data != nullptr; }
+    const Units &units() const { return fileUnits; }
+
+    int seriesCount() const { return int(series.size()); }
+    int target(int index) const { return series[index].target; }
+    int center(int index) const { return series[index].center; }
+    // bu cismin serisi; yoksa -1
+    int seriesOf(int body) const;
+    // serinin kapsadığı aralık (adım)
+    double startTicks(int index) const;
+    double endTicks(int index) const;
+    bool covers(int index, double ticks) const;
+
+    // t (adım) anında center'a göre konum (sahne birimi); kapsam dışında uçtaki parçanın ucu
+    QVector3D position(int index, double ticks);
+    // çok sayıda an için (ör. yörünge çizimi); ardışık anlar aynı parçayı paylaşır
+    void positions(int index, const double *ticks, int count, float *x, float *y, float *z);
+
+    static bool write(const QString &path, const Units &units, const std::vector<Series> &series);
+    // f'yi [start, start + length] aralığında Chebyshev düğümlerinde örnekleyip bir parçanın
+    // x, y, z katsayılarını out'a yazar (3 * coefficientCount)
+    static void fit(const std::function<void(double time, double position[3])> &f,
+                    double start, double length, int coefficientCount, double *out);
+
+private:
+    struct Record {
+        int target, center;
+        int coefficientCount, segmentCount;
+        double start, length;
+        const double *coefficients;
+        // son kullanılan parça
+        int segment;
+        double segmentStart;
+        const double *segmentCoefficients;
+    };
+
+    // dosya zamanını parçaya yerleştirir, s (-1..1) ile katsayıları döndürür
+    const double *locate(Record &record, double time, double &s);
+    void evaluate(const Record &record, const double *coefficients, double s, double out[3]) const;
+
+    std::unique_ptr<QFile> file;
+    const uchar *data = nullptr;
+    Units fileUnits = { 0.0, 1.0, 1.0 };
+    std::vector<Record> series;
+    std::vector<int> seriesByBody;
+};
+
+#endif // EPHEMERIS_H
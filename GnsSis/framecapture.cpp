@@ -0,0 +1,299 @@
+#include "framecapture.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QImage>
+#include <QMutexLocker>
+#include <QThread>
+
+#include <cstring>
+
+FrameCapture::FrameCapture()
+{
+    for (Readback &readback : ring)
+        readback = { 0, nullptr, -1 };
+}
+
+FrameCapture::~FrameCapture()
+{
+    // GL nesneleri stop() ile silinir; burada yalnızca işler beklenir
+    encodePool.waitForDone();
+}
+
+FrameCapture::Format FrameCapture::formatFor(const QString &path)
+{
+    const QString suffix = QFileInfo(path).suffix().toLower();
+    return suffix == "y4m" ? Y4mVideo : suffix == "yuv" ? RawYuv : PngSequence;
+}
+
+bool FrameCapture::start(QOpenGLExtraFunctions *ef, const QString &path, Format format, QSize size, int fps)
+{
+    stop(ef);
+    frameSize = QSize((qMax(2, size.width()) + 1) & ~1, (qMax(2, size.height()) + 1) & ~1);
+    this->format = format;
+    this->path = path;
+    framesPerSecond = qMax(1, fps);
+
+    if (format == PngSequence)
+    {
+        if (!QDir().mkpath(path))
+        {
+            qDebug() << "Cannot create capture directory" << path;
+            return false;
+        }
+        // PNG sıkıştırması kare başına en pahalı iş; kareler birbirinden bağımsız
+        encodePool.setMaxThreadCount(qMax(1, QThread::idealThreadCount() - 1));
+    }
+    else
+    {
+        video.setFileName(path);
+        if (!video.open(QFile::WriteOnly | QFile::Truncate))
+        {
+            qDebug() << "Cannot open capture file" << path;
+            return false;
+        }
+        if (format == Y4mVideo)
+        {
+            video.write(QString("YUV4MPEG2 W%1 H%2 F%3:1 Ip A1:1 C420jpeg XCOLORRANGE=FULL\n")
+                        .arg(frameSize.width()).arg(frameSize.height()).arg(framesPerSecond).toLatin1());
+        }
+        // tek işçi: kareler kuyruğa girdiği sırayla yazılır
+        encodePool.setMaxThreadCount(1);
+    }
+
+    QOpenGLFramebufferObjectFormat fboFormat;
+    fboFormat.setAttachment(QOpenGLFramebufferObject::CombinedDepthStencil);
+    framebuffer.reset(new QOpenGLFramebufferObject(frameSize, fboFormat));
+
+    const GLsizeiptr bytes = GLsizeiptr(frameSize.width()) * frameSize.height() * 4;
+    for (Readback &readback : ring)
+    {
+        ef->glGenBuffers(1, &readback.buffer);
+        ef->glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.buffer);
+        ef->glBufferData(GL_PIXEL_PACK_BUFFER, bytes, nullptr, GL_STREAM_READ);
+        readback.fence = nullptr;
+        readback.frame = -1;
+    }
+    ef->glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    next = 0;
+    captured = 0;
+    readStalls = encodeStalls = 0;
+    written = 0;
+    failed = false;
+    qDebug() << "Capturing" << frameSize.width() << "x" << frameSize.height() << "at" << framesPerSecond
+             << "fps to" << path;
+    return true;
+}
+
+void FrameCapture::stop(QOpenGLExtraFunctions *ef)
+{
+    if (!framebuffer)
+        return;
+
+    collect(ef, ringSize);
+    for (Readback &readback : ring)
+    {
+        ef->glDeleteBuffers(1, &readback.buffer);
+        readback = { 0, nullptr, -1 };
+    }
+    framebuffer.reset();
+
+    encodePool.waitForDone();
+    if (video.isOpen())
+        video.close();
+    {
+        QMutexLocker locker(&queueMutex);
+        freeBuffers.clear();
+    }
+
+    if (failed)
+        qDebug() << "Some captured frames were not written to" << path;
+    qDebug() << "Captured" << captured << "frames," << written.load() << "written,"
+             << readStalls << "readback stalls," << encodeStalls << "encoder stalls";
+}
+
+void FrameCapture::bind(QOpenGLExtraFunctions *ef)
+{
+    framebuffer->bind();
+    ef->glViewport(0, 0, frameSize.width(), frameSize.height());
+}
+
+void FrameCapture::capture(QOpenGLExtraFunctions *ef)
+{
+    collect(ef, 0);
+
+    // halka dolu: GPU dört kare geride, yalnızca en eski okuma beklenir
+    Readback &readback = ring[next];
+    if (readback.fence)
+    {
+        ++readStalls;
+        collect(ef, 1);
+    }
+
+    // PBO'ya okuma asenkron; glReadPixels hemen döner, kopya GPU'da sıraya girer
+    ef->glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer->handle());
+    ef->glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.buffer);
+    ef->glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    ef->glReadPixels(0, 0, frameSize.width(), frameSize.height(), GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    ef->glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    readback.fence = ef->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    readback.frame = captured++;
+    next = (next + 1) % ringSize;
+}
+
+void FrameCapture::present(QOpenGLExtraFunctions *ef, GLuint target, QSize targetSize)
+{
+    ef->glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer->handle());
+    ef->glBindFramebuffer(GL_DRAW_FRAMEBUFFER, target);
+    ef->glBlitFramebuffer(0, 0, frameSize.width(), frameSize.height(), 0, 0, targetSize.width(), targetSize.height(),
+                          GL_COLOR_BUFFER_BIT, GL_LINEAR);
+    ef->glBindFramebuffer(GL_FRAMEBUFFER, target);
+    ef->glViewport(0, 0, targetSize.width(), targetSize.height());
+}
+
+void FrameCapture::collect(QOpenGLExtraFunctions *ef, int waitCount)
+{
+    const GLsizeiptr bytes = GLsizeiptr(frameSize.width()) * frameSize.height() * 4;
+    for (int k = 0; k < ringSize; ++k)
+    {
+        // next en eski okumayı gösterir
+        Readback &readback = ring[(next + k) % ringSize];
+        if (!readback.fence)
+            continue;
+        // ilk sorgu komutları gönderir (flush); aksi halde fence hiç geçilmeyebilir
+        GLenum status = ef->glClientWaitSync(readback.fence, GL_SYNC_FLUSH_COMMANDS_BIT,
+                                             k < waitCount ? GLuint64(1000000000) : 0);
+        if (status == GL_TIMEOUT_EXPIRED && k >= waitCount)
+            break;
+        // beklenen okuma atılmaz: yuva ancak pikseller kopyalandıktan sonra yeniden kullanılır
+        while (status == GL_TIMEOUT_EXPIRED)
+        {
+            qDebug() << "Frame capture is waiting for the GPU, frame" << readback.frame;
+            status = ef->glClientWaitSync(readback.fence, 0, GLuint64(1000000000));
+        }
+        ef->glDeleteSync(readback.fence);
+        readback.fence = nullptr;
+        // fence sınanamadıysa eşleme kendisi bekler
+        if (status == GL_WAIT_FAILED)
+            qDebug() << "Waiting on the capture fence failed, mapping frame" << readback.frame << "directly";
+
+        // kodlama kuyruğu dolu: bir işin bitmesi beklenir, kare atılmaz
+        {
+            QMutexLocker locker(&queueMutex);
+            if (queued >= maxQueued)
+                ++encodeStalls;
+            while (queued >= maxQueued)
+                encoded.wait(&queueMutex);
+            ++queued;
+        }
+
+        QByteArray pixels = takeBuffer();
+        ef->glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.buffer);
+        const void *mapped = ef->glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, bytes, GL_MAP_READ_BIT);
+        if (mapped)
+        {
+            std::memcpy(pixels.data(), mapped, size_t(bytes));
+            ef->glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        }
+        ef->glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+        const qint64 frame = readback.frame;
+        if (!mapped)
+        {
+            // tamponda çöp var; kare yazılmaz, kayıt hatalı olarak biter
+            qDebug() << "Cannot map captured frame" << frame;
+            failed = true;
+            QMutexLocker locker(&queueMutex);
+            freeBuffers.push_back(std::move(pixels));
+            --queued;
+            continue;
+        }
+        // tampon işe taşınır; paylaşılırsa geri döndüğünde yeniden ayrılırdı
+        encodePool.start([this, pixels = std::move(pixels), frame]() mutable { encode(std::move(pixels), frame); });
+    }
+}
+
+QByteArray FrameCapture::takeBuffer()
+{
+    // kare başına 8 MB (1080p) yeniden ayrılmaz; kodlanan karelerin tamponları döner
+    QMutexLocker locker(&queueMutex);
+    if (!freeBuffers.empty())
+    {
+        QByteArray buffer = std::move(freeBuffers.back());
+        freeBuffers.pop_back();
+        return buffer;
+    }
+    return QByteArray(qsizetype(frameSize.width()) * frameSize.height() * 4, Qt::Uninitialized);
+}
+
+void FrameCapture::encode(QByteArray pixels, qint64 frame)
+{
+    const uchar *rgba = reinterpret_cast<const uchar *>(pixels.constData());
+    bool ok = true;
+    if (format == PngSequence)
+    {
+        // GL satırları aşağıdan yukarı; alfa sahnede anlamsız (temizleme rengi 0)
+        const QImage image = QImage(rgba, frameSize.width(), frameSize.height(), QImage::Format_RGBX8888).mirrored();
+        const QString fileName = QString("%1/frame_%2.png").arg(path).arg(frame, 6, 10, QChar('0'));
+        // kalite 80: düşük sıkıştırma düzeyi, kodlama hızı dosya boyutundan önemli
+        ok = image.save(fileName, "PNG", 80);
+    }
+    else
+    {
+        writeYuv(rgba);
+        ok = video.error() == QFile::NoError;
+    }
+    if (ok)
+        ++written;
+    else
+        failed = true;
+
+    QMutexLocker locker(&queueMutex);
+    freeBuffers.push_back(std::move(pixels));
+    --queued;
+    encoded.wakeAll();
+}
+
+void FrameCapture::writeYuv(const uchar *rgba)
+{
+    // I420, tam aralık BT.601 (C420jpeg); renk 2x2 bloğun ortalaması, satırlar ters çevrilir
+    const int width = frameSize.width(), height = frameSize.height();
+    const int chromaWidth = width / 2, chromaHeight = height / 2;
+    yuv.resize(qsizetype(width) * height * 3 / 2);
+    uchar *y = reinterpret_cast<uchar *>(yuv.data());
+    uchar *u = y + size_t(width) * height;
+    uchar *v = u + size_t(chromaWidth) * chromaHeight;
+
+    for (int row = 0; row < height; ++row)
+    {
+        const uchar *source = rgba + size_t(height - 1 - row) * width * 4;
+        uchar *luma = y + size_t(row) * width;
+        for (int x = 0; x < width; ++x)
+        {
+            const int r = source[4 * x], g = source[4 * x + 1], b = source[4 * x + 2];
+            luma[x] = uchar((77 * r + 150 * g + 29 * b + 128) >> 8);
+        }
+    }
+    for (int row = 0; row < chromaHeight; ++row)
+    {
+        const uchar *top = rgba + size_t(height - 1 - 2 * row) * width * 4;
+        const uchar *bottom = top - size_t(width) * 4;
+        for (int x = 0; x < chromaWidth; ++x)
+        {
+            const uchar *p = top + 8 * x, *q = bottom + 8 * x;
+            const int r = p[0] + p[4] + q[0] + q[4];
+            const int g = p[1] + p[5] + q[1] + q[5];
+            const int b = p[2] + p[6] + q[2] + q[6];
+            // dört pikselin toplamı: katsayılar 4 * 256'ya bölünür; 128 kaydırması bölmeden önce
+            // eklenir, böylece kaydırılan değer hiç negatif olmaz
+            u[size_t(row) * chromaWidth + x] = uchar(qMin(255, (-43 * r - 85 * g + 128 * b + 131584) >> 10));
+            v[size_t(row) * chromaWidth + x] = uchar(qMin(255, (128 * r - 107 * g - 21 * b + 131584) >> 10));
+        }
+    }
+
+    if (format == Y4mVideo)
+        video.write("FRAME\n", 6);
+    video.write(yuv);
+}
@@ -0,0 +1,103 @@
+#ifndef FRAMECAPTURE_H
+#define FRAMECAPTURE_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QMutex>
+#include <QOpenGLExtraFunctions>
+#include <QSize>
+#include <QString>
+#include <QThreadPool>
+#include <QWaitCondition>
+#include <QtOpenGL/QOpenGLFramebufferObject>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+// Sahnenin kayıt çözünürlüğünde (pencereden bağımsız) bir FBO'ya çizilip görüntü dizisi ya
+// da ham video olarak yazılması. Her kare glReadPixels ile halkadaki bir pixel buffer
+// object'e (PBO) okunur ve arkasına fence konur; çizim döngüsü okumayı beklemez, kareler
+// birkaç kare sonra fence geçildiğinde eşlenip kopyalanır. Kodlama (PNG, YUV dönüşümü ve
+// yazma) iş parçacığı havuzunda yapılır.
+//
+// Biçimler: PNG dizisi (klasör/frame_000000.png, kareler paralel kodlanır), Y4M (YUV4MPEG2,
+// 4:2:0, tam aralık BT.601; ffmpeg ve mpv doğrudan okur) ve başlıksız I420 (.yuv). Video
+// biçimlerinde kareler sırayla tek işçide yazılır.
+// Halka doluysa (GPU geride) en eski okuma beklenir, kodlama kuyruğu doluysa bir işin bitmesi
+// beklenir; ikisi de sayılır (readbackStalls, encoderStalls).
+class FrameCapture
+{
+public:
+    enum Format { PngSequence, Y4mVideo, RawYuv };
+
+    FrameCapture();
+    ~FrameCapture();
+
+    // dosya adından: .y4m, .yuv; diğerleri PNG klasörü
+    static Format formatFor(const QString &path);
+
+    // bağlam current olmalı; boyut 4:2:0 için çift sayıya yuvarlanır
+    bool start(QOpenGLExtraFunctions *ef, const QString &path, Format format, QSize size, int fps);
+    // bekleyen okumaları ve kodlamaları bitirip dosyayı kapatır
+    void stop(QOpenGLExtraFunctions *ef);
+    bool isActive() const { return framebuffer != nullptr; }
+    QSize size() const { return frameSize; }
+
+    // sahne çizilmeden önce: kayıt FBO'sunu bağlar ve viewport'u ayarlar
+    void bind(QOpenGLExtraFunctions *ef);
+    // sahne çizildikten sonra: okumayı başlatır, hazır olan kareleri işçilere verir
+    void capture(QOpenGLExtraFunctions *ef);
+    // kayıt görüntüsünü target framebuffer'a ölçekleyerek kopyalar (pencerede önizleme)
+    void present(QOpenGLExtraFunctions *ef, GLuint target, QSize targetSize);
+
+    qint64 capturedFrames() const { return captured; }
+    qint64 writtenFrames() const { return written.load(); }
+    qint64 readbackStalls() const { return readStalls; }
+    qint64 encoderStalls() const { return encodeStalls; }
+
+private:
+    struct Readback {
+        GLuint buffer;
+        GLsync fence;
+        qint64 frame;
+    };
+    static const int ringSize = 4;
+    // bellekte bekleyebilecek kodlanmamış kare
+    static const int maxQueued = 8;
+
+    // en eski okumadan başlayarak fence'i geçilmiş olanları işçilere verir; ilk waitCount
+    // okuma hazır değilse beklenir
+    void collect(QOpenGLExtraFunctions *ef, int waitCount);
+    void encode(QByteArray pixels, qint64 frame);
+    void writeYuv(const uchar *rgba);
+    QByteArray takeBuffer();
+
+    std::unique_ptr<QOpenGLFramebufferObject> framebuffer;
+    QSize frameSize;
+    Format format = PngSequence;
+    QString path;
+    int framesPerSecond = 60;
+
+    Readback ring[ringSize];
+    int next = 0;
+    qint64 captured = 0;
+    qint64 readStalls = 0, encodeStalls = 0;
+
+    // video dosyası yalnızca (tek) işçiden yazılır
+    QFile video;
+    QByteArray yuv;
+    std::atomic<qint64> written { 0 };
+    std::atomic<bool> failed { false };
+
+    // işçiler bitirdikçe tampon geri döner ve bekleyen kare sayısı azalır
+    QMutex queueMutex;
+    QWaitCondition encoded;
+    int queued = 0;
+    std::vector<QByteArray> freeBuffers;
+
+    // son üye olduğu için ilk yok edilir; işler bitmeden diğer üyeler silinmez
+    QThreadPool encodePool;
+};
+
+#endif // FRAMECAPTURE_H
@@ -0,0 +1,405 @@
+#include "frameprofiler.h"
+
+#include <QDebug>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QOpenGLContext>
+#include <QPainter>
+#include <QSaveFile>
+#include <QtOpenGL/QOpenGLTimerQuery>
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+const char *const trackNames[FrameProfiler::TrackCount] = { "Main", "Simulation", "GPU" };
+
+// bölge adından sabit bir renk; kareden kareye değişmez
+QColor zoneColor(const char *name)
+{
+    return QColor::fromHsv(int(qHash(QByteArray(name)) % 360), 150, 230);
+}
+
+}
+
+FrameProfiler::CpuZone::CpuZone(FrameProfiler &profiler, const char *name)
+    : profiler(profiler), name(name), begin(profiler.enabled ? profiler.now() : 0)
+{
+}
+
+FrameProfiler::CpuZone::~CpuZone()
+{
+    if (profiler.enabled)
+        profiler.addZone(name, MainTrack, begin, profiler.now());
+}
+
+FrameProfiler::GpuZone::GpuZone(FrameProfiler &profiler, const char *name)
+    : profiler(profiler), active(profiler.beginGpuZone(name))
+{
+}
+
+FrameProfiler::GpuZone::~GpuZone()
+{
+    if (active)
+        profiler.endGpuZone();
+}
+
+FrameProfiler::FrameProfiler()
+{
+    clock.start();
+}
+
+FrameProfiler::~FrameProfiler() = default;
+
+void FrameProfiler::setEnabled(bool enabled)
+{
+    this->enabled = enabled;
+    if (!enabled)
+        inFrame = false;
+}
+
+void FrameProfiler::initialize()
+{
+    // her yuvaya bir sorgu; oluşturulamıyorsa sürücü GL_TIME_ELAPSED desteklemiyor
+    gpuReady = false;
+    if (!enabled || !gpuTiming || !QOpenGLContext::currentContext())
+        return;
+    for (GpuSlot &slot : gpuSlots)
+    {
+        std::unique_ptr<QOpenGLTimerQuery> query(new QOpenGLTimerQuery);
+        if (!query->create())
+        {
+            qDebug() << "GPU timer queries unavailable, profiling CPU only";
+            release();
+            return;
+        }
+        slot.queries.push_back(std::move(query));
+    }
+    gpuReady = true;
+}
+
+void FrameProfiler::release()
+{
+    for (GpuSlot &slot : gpuSlots)
+    {
+        slot.queries.clear();
+        slot.names.clear();
+        slot.submitted.clear();
+        slot.pending = false;
+    }
+    gpuReady = false;
+    gpuOpen = false;
+}
+
+void FrameProfiler::beginFrame()
+{
+    if (!enabled)
+        return;
+    retire();
+
+    // yuva hâlâ dört kare önceki sonuçları bekliyorsa beklenmez; o karenin GPU süreleri atılır
+    GpuSlot &slot = gpuSlots[frameIndex % gpuLatency];
+    if (slot.pending)
+    {
+        slot.pending = false;
+        slot.frame.gpuNsecs = -1;
+        ++dropped;
+        finish(slot.frame);
+        retire();
+    }
+    slot.names.clear();
+    slot.submitted.clear();
+
+    current.index = frameIndex;
+    current.begin = now();
+    current.end = current.begin;
+    current.gpuNsecs = -1;
+    current.zones.clear();
+    inFrame = true;
+}
+
+void FrameProfiler::endFrame()
+{
+    if (!enabled || !inFrame)
+        return;
+    if (gpuOpen)
+        endGpuZone();
+    current.end = now();
+    inFrame = false;
+
+    // GPU bölgesi olmayan kareler de sırayı korumak için yuvadan geçer
+    GpuSlot &slot = gpuSlots[frameIndex % gpuLatency];
+    slot.frame = std::move(current);
+    slot.pending = true;
+    ++frameIndex;
+    retire();
+}
+
+void FrameProfiler::addZone(const char *name, Track track, qint64 begin, qint64 end)
+{
+    if (!enabled)
+        return;
+    if (inFrame)
+        current.zones.push_back({ name, track, begin, end });
+    else
+        startupZones.push_back({ name, track, begin, end });
+}
+
+bool FrameProfiler::beginGpuZone(const char *name)
+{
+    // sorgular iç içe olamaz; içteki bölge ölçülmez
+    if (!enabled || !gpuReady || !inFrame || gpuOpen)
+        return false;
+    GpuSlot &slot = gpuSlots[frameIndex % gpuLatency];
+    const size_t used = slot.names.size();
+    if (used == slot.queries.size())
+    {
+        std::unique_ptr<QOpenGLTimerQuery> query(new QOpenGLTimerQuery);
+        if (!query->create())
+            return false;
+        slot.queries.push_back(std::move(query));
+    }
+    slot.names.push_back(name);
+    slot.submitted.push_back(now());
+    slot.queries[used]->begin();
+    gpuOpen = true;
+    return true;
+}
+
+void FrameProfiler::endGpuZone()
+{
+    if (!gpuOpen)
+        return;
+    GpuSlot &slot = gpuSlots[frameIndex % gpuLatency];
+    slot.queries[slot.names.size() - 1]->end();
+    gpuOpen = false;
+}
+
+void FrameProfiler::retire(bool wait)
+{
+    // GPU sorguları sırayla tamamlar; en eski bekleyen kareden başlanır
+    for (qint64 index = qMax<qint64>(0, frameIndex - gpuLatency); index < frameIndex; ++index)
+    {
+        GpuSlot &slot = gpuSlots[index % gpuLatency];
+        if (!slot.pending || slot.frame.index != index)
+            continue;
+        if (!resolve(slot, wait))
+            break;
+        slot.pending = false;
+        finish(slot.frame);
+    }
+}
+
+bool FrameProfiler::resolve(GpuSlot &slot, bool wait)
+{
+    const size_t count = slot.names.size();
+    for (size_t i = 0; i < count && !wait; ++i)
+    {
+        if (!slot.queries[i]->isResultAvailable())
+            return false;
+    }
+
+    // yalnızca süre bilinir: bölge CPU'da gönderildiği andan ya da bir öncekinin bitişinden başlatılır
+    Frame &frame = slot.frame;
+    frame.gpuNsecs = count > 0 ? 0 : -1;
+    qint64 gpuTime = frame.begin;
+    for (size_t i = 0; i < count; ++i)
+    {
+        const qint64 elapsed = qint64(slot.queries[i]->waitForResult());
+        const qint64 begin = qMax(gpuTime, slot.submitted[i]);
+        frame.zones.push_back({ slot.names[i], GpuTrack, begin, begin + elapsed });
+        frame.gpuNsecs += elapsed;
+        gpuTime = begin + elapsed;
+    }
+    return true;
+}
+
+void FrameProfiler::finish(Frame &frame)
+{
+    frames.push_back(std::move(frame));
+    while (int(frames.size()) > historySize)
+        frames.pop_front();
+
+    const Frame &done = frames.back();
+    if (tracePath.isEmpty() || done.index < traceFirst)
+        return;
+    if (done.index <= traceLast)
+        traceFrames.push_back(done);
+    if (done.index >= traceLast)
+    {
+        if (writeTrace(tracePath, startupZones, traceFrames))
+            qDebug() << "Profiler trace of frames" << traceFirst << "-" << traceLast << "written to" << tracePath;
+        else
+            qDebug() << "Cannot write profiler trace" << tracePath;
+        tracePath.clear();
+        traceFrames.clear();
+    }
+}
+
+void FrameProfiler::setHistorySize(int count)
+{
+    historySize = qMax(1, count);
+    while (int(frames.size()) > historySize)
+        frames.pop_front();
+}
+
+std::vector<std::pair<QString, double>> FrameProfiler::averages(int frameCount) const
+{
+    // GPU bölgeleri yalnızca ölçülen karelere bölünür
+    const int count = qMin(frameCount, int(frames.size()));
+    int gpuFrames = 0;
+    std::vector<std::pair<const char *, qint64>> cpuSums, gpuSums;
+    for (int k = int(frames.size()) - count; k < int(frames.size()); ++k)
+    {
+        const Frame &frame = frames[k];
+        if (frame.gpuNsecs >= 0)
+            ++gpuFrames;
+        for (const Zone &zone : frame.zones)
+        {
+            auto &sums = zone.track == GpuTrack ? gpuSums : cpuSums;
+            auto sum = std::find_if(sums.begin(), sums.end(), [&zone](const std::pair<const char *, qint64> &s) {
+                return s.first == zone.name || std::strcmp(s.first, zone.name) == 0;
+            });
+            if (sum == sums.end())
+                sums.push_back({ zone.name, zone.end - zone.begin });
+            else
+                sum->second += zone.end - zone.begin;
+        }
+    }
+
+    std::vector<std::pair<QString, double>> result;
+    for (const auto &sum : cpuSums)
+        result.push_back({ QString::fromLatin1(sum.first), sum.second / 1.0e6 / qMax(1, count) });
+    for (const auto &sum : gpuSums)
+        result.push_back({ QString::fromLatin1(sum.first), sum.second / 1.0e6 / qMax(1, gpuFrames) });
+    std::sort(result.begin(), result.end(), [](const std::pair<QString, double> &a, const std::pair<QString, double> &b) {
+        return a.second > b.second;
+    });
+    return result;
+}
+
+void FrameProfiler::captureTrace(const QString &path, qint64 firstFrame, qint64 lastFrame)
+{
+    tracePath = path;
+    traceFirst = qMax<qint64>(0, firstFrame);
+    traceLast = qMax(traceFirst, lastFrame);
+    traceFrames.clear();
+}
+
+bool FrameProfiler::writeTrace(const QString &path, const std::vector<Zone> &startup, const std::vector<Frame> &captured)
+{
+    // trace-event biçimi: tam olaylar ("X"), zaman ve süre mikrosaniye
+    QJsonArray events;
+    for (int track = 0; track < TrackCount; ++track)
+    {
+        QJsonObject name;
+        name.insert("name", "thread_name");
+        name.insert("ph", "M");
+        name.insert("pid", 1);
+        name.insert("tid", track);
+        name.insert("args", QJsonObject{ { "name", trackNames[track] } });
+        events.append(name);
+    }
+    auto append = [&events](const QString &name, int track, qint64 begin, qint64 end) {
+        QJsonObject event;
+        event.insert("name", name);
+        event.insert("cat", trackNames[track]);
+        event.insert("ph", "X");
+        event.insert("ts", begin / 1.0e3);
+        event.insert("dur", (end - begin) / 1.0e3);
+        event.insert("pid", 1);
+        event.insert("tid", track);
+        events.append(event);
+    };
+    for (const Zone &zone : startup)
+        append(QString::fromLatin1(zone.name), zone.track, zone.begin, zone.end);
+    for (const Frame &frame : captured)
+    {
+        append(QString("Frame %1").arg(frame.index), MainTrack, frame.begin, frame.end);
+        for (const Zone &zone : frame.zones)
+            append(QString::fromLatin1(zone.name), zone.track, zone.begin, zone.end);
+    }
+
+    QJsonObject trace;
+    trace.insert("traceEvents", events);
+    trace.insert("displayTimeUnit", "ms");
+    QSaveFile file(path);
+    if (!file.open(QFile::WriteOnly))
+        return false;
+    file.write(QJsonDocument(trace).toJson(QJsonDocument::Compact));
+    return file.commit();
+}
+
+void FrameProfiler::drawOverlay(QPainter &painter, const QRect &area) const
+{
+    painter.save();
+    painter.fillRect(area, QColor(0, 0, 0, 170));
+    painter.setFont(QFont("monospace", 8));
+    const int lineHeight = painter.fontMetrics().height();
+
+    // üst: son karelerin ortalamaları, alt: kare başına sütunlar
+    const int count = qMin(int(frames.size()), historySize);
+    double cpuMs = 0.0, gpuMs = 0.0;
+    int gpuFrames = 0;
+    for (int k = int(frames.size()) - count; k < int(frames.size()); ++k)
+    {
+        cpuMs += (frames[k].end - frames[k].begin) / 1.0e6;
+        if (frames[k].gpuNsecs >= 0)
+        {
+            gpuMs += frames[k].gpuNsecs / 1.0e6;
+            ++gpuFrames;
+        }
+    }
+    int y = area.top() + lineHeight;
+    painter.setPen(Qt::white);
+    painter.drawText(area.left() + 6, y, QString("CPU %1 ms  GPU %2 ms  (%3 frames, %4 GPU dropped)")
+                                            .arg(cpuMs / qMax(1, count), 0, 'f', 2)
+                                            .arg(gpuFrames > 0 ? QString::number(gpuMs / gpuFrames, 'f', 2) : QString("-"))
+                                            .arg(count).arg(dropped));
+    const std::vector<std::pair<QString, double>> zones = averages(count);
+    const int textBottom = area.top() + area.height() / 2;
+    for (const auto &zone : zones)
+    {
+        if (y + lineHeight > textBottom)
+            break;
+        y += lineHeight;
+        painter.fillRect(area.left() + 6, y - lineHeight / 2 - 2, 8, 8, zoneColor(qPrintable(zone.first)));
+        painter.setPen(Qt::white);
+        painter.drawText(area.left() + 18, y, QString("%1 %2 ms").arg(zone.first, -24).arg(zone.second, 7, 'f', 3));
+    }
+
+    // 33.3 ms tam yükseklik; 16.7 ms (60 Hz) çizgisi
+    const QRect graph = area.adjusted(6, area.height() / 2 + 4, -6, -6);
+    const double pixelsPerNsec = graph.height() / 33.3e6;
+    const int columns = qMin(count, graph.width() / 2);
+    for (int c = 0; c < columns; ++c)
+    {
+        const Frame &frame = frames[frames.size() - columns + c];
+        const int x = graph.left() + c * 2;
+        const int cpuHeight = qMin(graph.height(), int((frame.end - frame.begin) * pixelsPerNsec));
+        painter.fillRect(x, graph.bottom() - cpuHeight, 2, cpuHeight, QColor(110, 110, 110));
+        // ana iş parçacığı bölgeleri üst üste
+        int stacked = 0;
+        for (const Zone &zone : frame.zones)
+        {
+            if (zone.track != MainTrack)
+                continue;
+            const int height = qMin(graph.height() - stacked, int((zone.end - zone.begin) * pixelsPerNsec));
+            if (height <= 0)
+                continue;
+            painter.fillRect(x, graph.bottom() - stacked - height, 2, height, zoneColor(zone.name));
+            stacked += height;
+        }
+        if (frame.gpuNsecs >= 0)
+        {
+            const int gpuHeight = qMin(graph.height(), int(frame.gpuNsecs * pixelsPerNsec));
+            painter.fillRect(x, graph.bottom() - gpuHeight, 2, 2, QColor(255, 150, 40));
+        }
+    }
+    painter.setPen(QColor(255, 255, 255, 120));
+    const int budget = graph.bottom() - int(16.7e6 * pixelsPerNsec);
+    painter.drawLine(graph.left(), budget, graph.right(), budget);
+    painter.restore();
+}
@@ -0,0 +1,140 @@
+#ifndef FRAMEPROFILER_H
+#define FRAMEPROFILER_H
+
+#include <QElapsedTimer>
+#include <QRect>
+#include <QString>
+
+#include <deque>
+#include <memory>
+#include <utility>
+#include <vector>
+
+class QOpenGLTimerQuery;
+class QPainter;
+
+// Kare profilcisi: CPU bölgeleri (RAII, QElapsedTimer) ve GPU geçişleri çevresinde
+// GL_TIME_ELAPSED sorguları (QOpenGLTimerQuery). GPU sonuçları birkaç kare sonra, yalnızca
+// hazır olduklarında okunur; sorgu yuvaları halkada döner ve çizim hiç beklemez. Halka
+// dolduğunda hâlâ hazır olmayan karenin GPU süreleri atılır (droppedGpuFrames).
+// Son kareler ekranda grafik olarak gösterilebilir (drawOverlay) ve seçilen kare aralığı
+// Chrome trace-event JSON'u olarak yazılabilir (chrome://tracing, Perfetto).
+// Zaman damgaları profilcinin açılışından bu yana nanosaniye; now() her iş parçacığından
+// okunabilir, kayıt yalnızca GUI iş parçacığından yapılır.
+class FrameProfiler
+{
+public:
+    // trace'te iş parçacığı (tid) olarak görünür
+    enum Track { MainTrack, SimulationTrack, GpuTrack, TrackCount };
+
+    struct Zone {
+        const char *name;       // kalıcı dizge (genellikle sabit)
+        Track track;
+        qint64 begin, end;      // ns
+    };
+    struct Frame {
+        qint64 index;
+        qint64 begin, end;      // CPU, ns
+        qint64 gpuNsecs;        // GPU bölgelerinin toplamı; -1: ölçülmedi ya da atıldı
+        std::vector<Zone> zones;
+    };
+
+    // kapsamın süresi MainTrack'e yazılır
+    class CpuZone
+    {
+    public:
+        CpuZone(FrameProfiler &profiler, const char *name);
+        ~CpuZone();
+    private:
+        FrameProfiler &profiler;
+        const char *name;
+        qint64 begin;
+    };
+    // GL_TIME_ELAPSED sorguları iç içe olamaz; GPU bölgeleri ardışık olmalı
+    class GpuZone
+    {
+    public:
+        GpuZone(FrameProfiler &profiler, const char *name);
+        ~GpuZone();
+    private:
+        FrameProfiler &profiler;
+        bool active;
+    };
+
+    FrameProfiler();
+    ~FrameProfiler();
+
+    // kapalıyken bölgeler hiçbir şey yapmaz
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return enabled; }
+    // GPU sorguları; bağlam yoksa ya da zamanlayıcı desteklenmiyorsa yalnızca CPU
+    void setGpuTiming(bool enabled) { gpuTiming = enabled; }
+    // bağlam current olmalı; release() aynı bağlamda
+    void initialize();
+    void release();
+
+    qint64 now() const { return clock.nsecsElapsed(); }
+
+    // kare dışında kaydedilen bölgeler (ör. açılış) ayrı tutulur ve her trace'e yazılır
+    void beginFrame();
+    void endFrame();
+    void addZone(const char *name, Track track, qint64 begin, qint64 end);
+    // bekleyen GPU sonuçlarını bekleyerek okur; ölçüm sonunda (ör. RenderBench), çizim döngüsünde değil
+    void flush() { retire(true); }
+
+    // tamamlanmış (GPU sonuçları okunmuş) son kareler, eskiden yeniye
+    void setHistorySize(int count);
+    const std::deque<Frame> &history() const { return frames; }
+    qint64 droppedGpuFrames() const { return dropped; }
+    // son n karede bölge başına ortalama (ms), büyükten küçüğe
+    std::vector<std::pair<QString, double>> averages(int frameCount) const;
+
+    // [first, last] karelerini toplayıp son kare tamamlanınca path'e yazar
+    void captureTrace(const QString &path, qint64 firstFrame, qint64 lastFrame);
+    bool isCapturing() const { return !tracePath.isEmpty(); }
+    static bool writeTrace(const QString &path, const std::vector<Zone> &startup, const std::vector<Frame> &captured);
+
+    // son historySize karenin CPU ve GPU süreleri ile bölge ortalamaları; area içinde
+    void drawOverlay(QPainter &painter, const QRect &area) const;
+
+private:
+    // bir karenin GPU sorguları; halkada gpuLatency yuva
+    struct GpuSlot {
+        std::vector<std::unique_ptr<QOpenGLTimerQuery>> queries;
+        std::vector<const char *> names;
+        std::vector<qint64> submitted;      // CPU'da begin anı; GPU bölgesi en erken burada başlar
+        bool pending = false;
+        Frame frame;
+    };
+    static const int gpuLatency = 4;
+
+    bool beginGpuZone(const char *name);
+    void endGpuZone();
+    // sıradaki karelerin hazır GPU sonuçlarını okur; ilk hazır olmayanda durur
+    void retire(bool wait = false);
+    bool resolve(GpuSlot &slot, bool wait);
+    void finish(Frame &frame);
+
+    bool enabled = true;
+    bool gpuTiming = true;
+    bool gpuReady = false;
+    QElapsedTimer clock;
+
+    bool inFrame = false;
+    qint64 frameIndex = 0;
+    Frame current;
+    std::vector<Zone> startupZones;
+
+    GpuSlot gpuSlots[gpuLatency];
+    bool gpuOpen = false;
+    qint64 dropped = 0;
+
+    int historySize = 240;
+    std::deque<Frame> frames;
+
+    QString tracePath;
+    qint64 traceFirst = 0, traceLast = -1;
+    std::vector<Frame> traceFrames;
+};
+
+#endif // FRAMEPROFILER_H
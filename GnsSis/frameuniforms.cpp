@@ -0,0 +1,40 @@
+#include "frameuniforms.h"
+
+#include <algorithm>
+
+void FrameUniforms::create(QOpenGLExtraFunctions *ef)
+{
+    release(ef);
+    ef->glGenBuffers(1, &buffer);
+    ef->glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+    ef->glBufferData(GL_UNIFORM_BUFFER, sizeof(Block), nullptr, GL_DYNAMIC_DRAW);
+    ef->glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+void FrameUniforms::release(QOpenGLExtraFunctions *ef)
+{
+    if (buffer != 0)
+        ef->glDeleteBuffers(1, &buffer);
+    buffer = 0;
+}
+
+void FrameUniforms::update(QOpenGLExtraFunctions *ef, const QMatrix4x4 &view, const QMatrix4x4 &projection, float pixelScale)
+{
+    viewMatrix = view;
+    projectionMatrix = projection;
+    viewProjectionMatrix = projection * view;
+    pixels = pixelScale;
+
+    Block block;
+    std::copy(view.constData(), view.constData() + 16, block.view);
+    std::copy(projection.constData(), projection.constData() + 16, block.projection);
+    std::copy(viewProjectionMatrix.constData(), viewProjectionMatrix.constData() + 16, block.viewProjection);
+    block.pixelScale = pixelScale;
+    std::fill(block.padding, block.padding + 3, 0.0f);
+
+    // kare başına tek yükleme; önceki karenin okunmasını beklememek için tampon yeniden ayrılır
+    ef->glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+    ef->glBufferData(GL_UNIFORM_BUFFER, sizeof(Block), &block, GL_DYNAMIC_DRAW);
+    ef->glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    ef->glBindBufferBase(GL_UNIFORM_BUFFER, binding, buffer);
+}
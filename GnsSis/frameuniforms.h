@@ -0,0 +1,43 @@
+#ifndef FRAMEUNIFORMS_H
+#define FRAMEUNIFORMS_H
+
+#include <QMatrix4x4>
+#include <QOpenGLExtraFunctions>
+
+// Kare başına bir kez yüklenen kamera verisi: shader'lardaki "Frame" uniform bloğu
+// (std140, binding 0). Kamera ve izdüşüm matrisleri her çizim çağrısında ayrı ayrı
+// glUniformMatrix4fv ile gönderilmez; tüm programlar aynı tampondan okur.
+class FrameUniforms
+{
+public:
+    static const GLuint binding = 0;
+
+    void create(QOpenGLExtraFunctions *ef);
+    void release(QOpenGLExtraFunctions *ef);
+    bool isCreated() const { return buffer != 0; }
+
+    // view = cameraMatrix * translateMatrix; pixelScale = 0.5 * yükseklik * P[1][1].
+    // Tamponu günceller ve binding noktasına bağlar.
+    void update(QOpenGLExtraFunctions *ef, const QMatrix4x4 &view, const QMatrix4x4 &projection, float pixelScale);
+
+    const QMatrix4x4 &view() const { return viewMatrix; }
+    const QMatrix4x4 &projection() const { return projectionMatrix; }
+    const QMatrix4x4 &viewProjection() const { return viewProjectionMatrix; }
+    float pixelScale() const { return pixels; }
+
+private:
+    // shader'daki blokla aynı düzen (std140: mat4 sütun öncelikli, float 16 bayta tamamlanır)
+    struct Block {
+        GLfloat view[16];
+        GLfloat projection[16];
+        GLfloat viewProjection[16];
+        GLfloat pixelScale;
+        GLfloat padding[3];
+    };
+
+    GLuint buffer = 0;
+    QMatrix4x4 viewMatrix, projectionMatrix, viewProjectionMatrix;
+    float pixels = 1.0f;
+};
+
+#endif // FRAMEUNIFORMS_H
@@ -0,0 +1,31 @@
+#include "frustum.h"
+
+Frustum::Frustum(const QMatrix4x4 &viewProjection)
+{
+    // Gribb-Hartmann: her düzlem son satır ± ilk üç satırdan biri
+    const QVector4D x = viewProjection.row(0);
+    const QVector4D y = viewProjection.row(1);
+    const QVector4D z = viewProjection.row(2);
+    const QVector4D w = viewProjection.row(3);
+
+    planes[0] = w + x;  // sol
+    planes[1] = w - x;  // sağ
+    planes[2] = w + y;  // alt
+    planes[3] = w - y;  // üst
+    planes[4] = w + z;  // yakın
+    planes[5] = w - z;  // uzak
+
+    // uzaklıkların dünya biriminde olması için normaller birim uzunluğa getirilir
+    for (QVector4D &plane : planes)
+        plane /= plane.toVector3D().length();
+}
+
+bool Frustum::intersectsSphere(const QVector3D &center, float radius) const
+{
+    for (const QVector4D &plane : planes)
+    {
+        if (QVector3D::dotProduct(plane.toVector3D(), center) + plane.w() < -radius)
+            return false;
+    }
+    return true;
+}
@@ -0,0 +1,22 @@
+#ifndef FRUSTUM_H
+#define FRUSTUM_H
+
+#include <QMatrix4x4>
+#include <QVector3D>
+#include <QVector4D>
+
+// Görüş hacminin altı düzlemi; düzlemler dünya → kırpma dönüşümünden
+// (projection * camera * ...) çıkarılır, normaller içeri bakar.
+class Frustum
+{
+public:
+    explicit Frustum(const QMatrix4x4 &viewProjection);
+
+    // küre tamamen bir düzlemin dışındaysa false; kesişen küreler görünür sayılır
+    bool intersectsSphere(const QVector3D &center, float radius) const;
+
+private:
+    QVector4D planes[6];
+};
+
+#endif // FRUSTUM_H
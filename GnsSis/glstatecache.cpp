@@ -0,0 +1,71 @@
+#include "glstatecache.h"
+
+void GLStateCache::invalidate()
+{
+    programKnown = vaoKnown = textureKnown = false;
+    uniforms.clear();
+}
+
+void GLStateCache::useProgram(QOpenGLExtraFunctions *ef, GLuint name)
+{
+    if (skipping && programKnown && program == name)
+    {
+        ++skipped;
+        return;
+    }
+    ef->glUseProgram(name);
+    program = name;
+    programKnown = true;
+    ++issued;
+}
+
+void GLStateCache::bindVertexArray(QOpenGLExtraFunctions *ef, GLuint name)
+{
+    if (skipping && vaoKnown && vao == name)
+    {
+        ++skipped;
+        return;
+    }
+    ef->glBindVertexArray(name);
+    vao = name;
+    vaoKnown = true;
+    ++issued;
+}
+
+void GLStateCache::bindTexture(QOpenGLExtraFunctions *ef, GLenum target, GLuint name)
+{
+    if (skipping && textureKnown && textureTarget == target && texture == name)
+    {
+        ++skipped;
+        return;
+    }
+    ef->glBindTexture(target, name);
+    textureTarget = target;
+    texture = name;
+    textureKnown = true;
+    ++issued;
+}
+
+void GLStateCache::uniform1i(QOpenGLExtraFunctions *ef, GLint location, GLint value)
+{
+    // -1: programda olmayan uniform, GL de yok sayar
+    if (location < 0)
+        return;
+    // program bilinmiyorsa hangi programın uniform'u olduğu da bilinmez
+    if (!programKnown)
+    {
+        ef->glUniform1i(location, value);
+        ++issued;
+        return;
+    }
+    const quint64 key = (quint64(program) << 32) | quint32(location);
+    const auto found = uniforms.find(key);
+    if (skipping && found != uniforms.end() && found->second == value)
+    {
+        ++skipped;
+        return;
+    }
+    ef->glUniform1i(location, value);
+    uniforms[key] = value;
+    ++issued;
+}
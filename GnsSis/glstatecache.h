@@ -0,0 +1,45 @@
+#ifndef GLSTATECACHE_H
+#define GLSTATECACHE_H
+
+#include <QOpenGLExtraFunctions>
+
+#include <unordered_map>
+
+// Program, VAO, doku (birim 0) ve tamsayı uniform'ların son değerini tutar; aynı değeri
+// yeniden yazan çağrıları GL'ye göndermez. Cache dışından GL durumu değiştiren kod
+// (doku yükleme, kuşak parçacıkları) sonrasında invalidate() çağrılmalı.
+// GNSSIS_STATE_CACHE=off her çağrıyı gönderir (karşılaştırma için); sayaçlar yine tutulur.
+class GLStateCache
+{
+public:
+    void setEnabled(bool enabled) { skipping = enabled; }
+    bool isEnabled() const { return skipping; }
+
+    void invalidate();
+    // kare başında; sayaçları sıfırlar
+    void resetCounters() { issued = skipped = 0; }
+
+    void useProgram(QOpenGLExtraFunctions *ef, GLuint program);
+    void bindVertexArray(QOpenGLExtraFunctions *ef, GLuint vao);
+    void bindTexture(QOpenGLExtraFunctions *ef, GLenum target, GLuint texture);
+    // etkin programın uniform'u
+    void uniform1i(QOpenGLExtraFunctions *ef, GLint location, GLint value);
+    // çizim çağrıları her zaman gider; yalnızca sayılır
+    void countDraw() { ++issued; }
+
+    // son sıfırlamadan bu yana GL'ye giden ve gereksiz olduğu için atlanan çağrılar
+    int issuedCalls() const { return issued; }
+    int skippedCalls() const { return skipped; }
+
+private:
+    bool skipping = true;
+    // 0 geçerli bir ad olduğu için bilinmeyen durum ayrı işaretlenir
+    bool programKnown = false, vaoKnown = false, textureKnown = false;
+    GLuint program = 0, vao = 0, texture = 0;
+    GLenum textureTarget = 0;
+    // (program << 32 | konum) -> değer
+    std::unordered_map<quint64, GLint> uniforms;
+    int issued = 0, skipped = 0;
+};
+
+#endif // GLSTATECACHE_H
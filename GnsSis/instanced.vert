@@ -0,0 +1,26 @@
+#version 430
+layout(location = 0) in vec3 position;
+layout(location = 1) in vec3 color;
+
+layout(location = 2) in vec3 aNormCoord;
+layout(location = 3) in vec2 aTexCoord;
+
+// cisim başına (instance) veriler
+layout(location = 4) in mat4 instanceMvp;     // projection * camera * translate * model * rotate * scale
+layout(location = 8) in float instanceLayer;
+
+
+out vec3 outColor;
+
+
+out vec3 outNorm;
+out vec2 outTexCoord;
+flat out float outLayer;
+
+void main() {
+   gl_Position = instanceMvp * vec4(position, 1.0);
+   outColor = color;
+   outNorm = aNormCoord;
+   outTexCoord = aTexCoord;
+   outLayer = instanceLayer;
+}
@@ -0,0 +1,174 @@
+#include "keplersolver.h"
+#include "simdsincos.h"
+
+#include <cmath>
+
+using namespace SimdMath;
+
+namespace {
+
+// bir Newton adımı bu değerin altına inince çözüm float duyarlığındadır
+const float tolerance = 1.0e-6f;
+const float danbyFactor = 0.85f;
+
+}
+
+void KeplerSolver::solve(const float *meanAnomaly, const float *eccentricity, int count, float *cosE, float *sinE)
+{
+    static const Variant variant = best();
+    solve(variant, meanAnomaly, eccentricity, count, cosE, sinE);
+}
+
+void KeplerSolver::solve(Variant variant, const float *meanAnomaly, const float *eccentricity, int count,
+                         float *cosE, float *sinE)
+{
+    if (!isSupported(variant))
+        variant = Scalar;
+
+    switch (variant)
+    {
+    case Sse:
+        solveSse(meanAnomaly, eccentricity, count, cosE, sinE);
+        break;
+    case Avx2:
+        solveAvx2(meanAnomaly, eccentricity, count, cosE, sinE);
+        break;
+    case Neon:
+        solveNeon(meanAnomaly, eccentricity, count, cosE, sinE);
+        break;
+    default:
+        solveScalar(meanAnomaly, eccentricity, count, cosE, sinE);
+        break;
+    }
+}
+
+void KeplerSolver::solveScalar(const float *meanAnomaly, const float *eccentricity, int count, float *cosE, float *sinE)
+{
+    // referans sürüm; SIMD sürümleri bununla karşılaştırılır ve kalan cisimler için kullanılır
+    for (int i = 0; i < count; ++i)
+    {
+        // [-180, 180) dereceye indir, sonra radyan
+        const float m = (meanAnomaly[i] - 360.0f * std::nearbyint(meanAnomaly[i] / 360.0f)) * degreesToRadians;
+        const float e = eccentricity[i];
+
+        float anomaly = m + std::copysign(danbyFactor * e, m);
+        for (int step = 0; step < maxIterations; ++step)
+        {
+            const float delta = (anomaly - e * std::sin(anomaly) - m) / (1.0f - e * std::cos(anomaly));
+            anomaly -= delta;
+            if (std::abs(delta) < tolerance)
+                break;
+        }
+        cosE[i] = std::cos(anomaly);
+        sinE[i] = std::sin(anomaly);
+    }
+}
+
+void KeplerSolver::solveSse(const float *meanAnomaly, const float *eccentricity, int count, float *cosE, float *sinE)
+{
+#if defined(GNSSIS_SIMD_X86)
+    const __m128 signBit = _mm_set1_ps(-0.0f);
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128 degrees = _mm_loadu_ps(meanAnomaly + i);
+        const __m128 turns = _mm_cvtepi32_ps(_mm_cvtps_epi32(_mm_mul_ps(degrees, _mm_set1_ps(1.0f / 360.0f))));
+        const __m128 m = _mm_mul_ps(_mm_sub_ps(degrees, _mm_mul_ps(turns, _mm_set1_ps(360.0f))),
+                                    _mm_set1_ps(degreesToRadians));
+        const __m128 e = _mm_loadu_ps(eccentricity + i);
+
+        __m128 anomaly = _mm_add_ps(m, _mm_or_ps(_mm_mul_ps(e, _mm_set1_ps(danbyFactor)), _mm_and_ps(m, signBit)));
+        __m128 s, c;
+        for (int step = 0; step < maxIterations; ++step)
+        {
+            sinCos4(anomaly, s, c);
+            const __m128 f = _mm_sub_ps(_mm_sub_ps(anomaly, _mm_mul_ps(e, s)), m);
+            const __m128 delta = _mm_div_ps(f, _mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(e, c)));
+            anomaly = _mm_sub_ps(anomaly, delta);
+            // dört şeridin hepsi yakınsadıysa dur
+            if (_mm_movemask_ps(_mm_cmpge_ps(_mm_andnot_ps(signBit, delta), _mm_set1_ps(tolerance))) == 0)
+                break;
+        }
+        sinCos4(anomaly, s, c);
+        _mm_storeu_ps(cosE + i, c);
+        _mm_storeu_ps(sinE + i, s);
+    }
+    solveScalar(meanAnomaly + i, eccentricity + i, count - i, cosE + i, sinE + i);
+#else
+    solveScalar(meanAnomaly, eccentricity, count, cosE, sinE);
+#endif
+}
+
+#if defined(GNSSIS_SIMD_X86)
+GNSSIS_TARGET_AVX2
+#endif
+void KeplerSolver::solveAvx2(const float *meanAnomaly, const float *eccentricity, int count, float *cosE, float *sinE)
+{
+#if defined(GNSSIS_SIMD_X86)
+    const __m256 signBit = _mm256_set1_ps(-0.0f);
+    int i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256 degrees = _mm256_loadu_ps(meanAnomaly + i);
+        const __m256 turns = _mm256_round_ps(_mm256_mul_ps(degrees, _mm256_set1_ps(1.0f / 360.0f)),
+                                             _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        const __m256 m = _mm256_mul_ps(_mm256_fnmadd_ps(turns, _mm256_set1_ps(360.0f), degrees),
+                                       _mm256_set1_ps(degreesToRadians));
+        const __m256 e = _mm256_loadu_ps(eccentricity + i);
+
+        __m256 anomaly = _mm256_add_ps(m, _mm256_or_ps(_mm256_mul_ps(e, _mm256_set1_ps(danbyFactor)),
+                                                       _mm256_and_ps(m, signBit)));
+        __m256 s, c;
+        for (int step = 0; step < maxIterations; ++step)
+        {
+            sinCos8(anomaly, s, c);
+            const __m256 f = _mm256_sub_ps(_mm256_fnmadd_ps(e, s, anomaly), m);
+            const __m256 delta = _mm256_div_ps(f, _mm256_fnmadd_ps(e, c, _mm256_set1_ps(1.0f)));
+            anomaly = _mm256_sub_ps(anomaly, delta);
+            if (_mm256_movemask_ps(_mm256_cmp_ps(_mm256_andnot_ps(signBit, delta), _mm256_set1_ps(tolerance),
+                                                 _CMP_GE_OQ)) == 0)
+                break;
+        }
+        sinCos8(anomaly, s, c);
+        _mm256_storeu_ps(cosE + i, c);
+        _mm256_storeu_ps(sinE + i, s);
+    }
+    solveSse(meanAnomaly + i, eccentricity + i, count - i, cosE + i, sinE + i);
+#else
+    solveScalar(meanAnomaly, eccentricity, count, cosE, sinE);
+#endif
+}
+
+void KeplerSolver::solveNeon(const float *meanAnomaly, const float *eccentricity, int count, float *cosE, float *sinE)
+{
+#if defined(GNSSIS_SIMD_NEON)
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const float32x4_t degrees = vld1q_f32(meanAnomaly + i);
+        const float32x4_t turns = vrndnq_f32(vmulq_n_f32(degrees, 1.0f / 360.0f));
+        const float32x4_t m = vmulq_n_f32(vmlsq_n_f32(degrees, turns, 360.0f), degreesToRadians);
+        const float32x4_t e = vld1q_f32(eccentricity + i);
+
+        // Danby başlangıcı: işaret M'den alınır
+        const float32x4_t offset = vmulq_n_f32(e, danbyFactor);
+        float32x4_t anomaly = vaddq_f32(m, vbslq_f32(vcltq_f32(m, vdupq_n_f32(0.0f)), vnegq_f32(offset), offset));
+        float32x4_t s, c;
+        for (int step = 0; step < maxIterations; ++step)
+        {
+            sinCos4(anomaly, s, c);
+            const float32x4_t f = vsubq_f32(vmlsq_f32(anomaly, e, s), m);
+            const float32x4_t delta = vdivq_f32(f, vmlsq_f32(vdupq_n_f32(1.0f), e, c));
+            anomaly = vsubq_f32(anomaly, delta);
+            if (vmaxvq_f32(vabsq_f32(delta)) < tolerance)
+                break;
+        }
+        sinCos4(anomaly, s, c);
+        vst1q_f32(cosE + i, c);
+        vst1q_f32(sinE + i, s);
+    }
+    solveScalar(meanAnomaly + i, eccentricity + i, count - i, cosE + i, sinE + i);
+#else
+    solveScalar(meanAnomaly, eccentricity, count, cosE, sinE);
+#endif
+}
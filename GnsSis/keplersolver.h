@@ -0,0 +1,26 @@
+#ifndef KEPLERSOLVER_H
+#define KEPLERSOLVER_H
+
+#include "simdmath.h"
+
+// Kepler denklemi M = E - e * sin(E): ortalama anomaliden (M) dış merkezli anomaliyi (E) bulur.
+// Newton yöntemi, Danby başlangıcı E0 = M + 0.85 * e * işaret(sin M) ile başlar; tüm şeritler
+// aynı adımı atar ve en çok maxIterations adımda durur. Yalnızca eliptik yörüngeler (0 <= e < 1).
+class KeplerSolver
+{
+public:
+    static const int maxIterations = 8;
+
+    // meanAnomaly derece (herhangi bir tur); çıktı cos(E) ve sin(E)
+    static void solve(const float *meanAnomaly, const float *eccentricity, int count, float *cosE, float *sinE);
+    static void solve(SimdMath::Variant variant, const float *meanAnomaly, const float *eccentricity, int count,
+                      float *cosE, float *sinE);
+
+private:
+    static void solveScalar(const float *meanAnomaly, const float *eccentricity, int count, float *cosE, float *sinE);
+    static void solveSse(const float *meanAnomaly, const float *eccentricity, int count, float *cosE, float *sinE);
+    static void solveAvx2(const float *meanAnomaly, const float *eccentricity, int count, float *cosE, float *sinE);
+    static void solveNeon(const float *meanAnomaly, const float *eccentricity, int count, float *cosE, float *sinE);
+};
+
+#endif // KEPLERSOLVER_H
@@ -13,6 +13,7 @@ int main(int argc, char *argv[])
     format.setStencilBufferSize(8);
     format.setVersion(4,3);
     format.setProfile(QSurfaceFormat::CoreProfile);
+    format.setSwapInterval(1);  // kare hızı dikey eşitlemeyle sınırlanır (GNSSIS_FPS yoksa)
     QSurfaceFormat::setDefaultFormat(format);
 
     // Ana pencereyi oluştur ve boyutunu ayarla
@@ -0,0 +1,200 @@
+#include "modelmatrixkernel.h"
+#include "simdsincos.h"
+
+#include <cmath>
+
+using namespace SimdMath;
+
+#if defined(GNSSIS_SIMD_X86)
+namespace {
+
+// dört cismin matrisini yazar: a = cos*k, b = sin*k, k = ölçek, tx/ty/tz = öteleme
+inline void store4(float *out, int stride, __m128 a, __m128 b, __m128 k, __m128 tx, __m128 ty, __m128 tz)
+{
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 nb = _mm_sub_ps(zero, b);
+
+    // sütun 0 = (a, 0, -b, 0), sütun 1 = (0, k, 0, 0), sütun 2 = (b, 0, a, 0), sütun 3 = (tx, ty, tz, 1)
+    const __m128 aLo = _mm_unpacklo_ps(a, zero), aHi = _mm_unpackhi_ps(a, zero);
+    const __m128 nbLo = _mm_unpacklo_ps(nb, zero), nbHi = _mm_unpackhi_ps(nb, zero);
+    const __m128 bLo = _mm_unpacklo_ps(b, zero), bHi = _mm_unpackhi_ps(b, zero);
+    const __m128 kLo = _mm_unpacklo_ps(zero, k), kHi = _mm_unpackhi_ps(zero, k);
+    const __m128 txLo = _mm_unpacklo_ps(tx, ty), txHi = _mm_unpackhi_ps(tx, ty);
+    const __m128 tzLo = _mm_unpacklo_ps(tz, _mm_set1_ps(1.0f)), tzHi = _mm_unpackhi_ps(tz, _mm_set1_ps(1.0f));
+
+    float *m0 = out, *m1 = out + stride, *m2 = out + 2 * stride, *m3 = out + 3 * stride;
+    _mm_storeu_ps(m0, _mm_movelh_ps(aLo, nbLo));
+    _mm_storeu_ps(m0 + 4, _mm_movelh_ps(kLo, zero));
+    _mm_storeu_ps(m0 + 8, _mm_movelh_ps(bLo, aLo));
+    _mm_storeu_ps(m0 + 12, _mm_movelh_ps(txLo, tzLo));
+
+    _mm_storeu_ps(m1, _mm_movehl_ps(nbLo, aLo));
+    _mm_storeu_ps(m1 + 4, _mm_movehl_ps(zero, kLo));
+    _mm_storeu_ps(m1 + 8, _mm_movehl_ps(aLo, bLo));
+    _mm_storeu_ps(m1 + 12, _mm_movehl_ps(tzLo, txLo));
+
+    _mm_storeu_ps(m2, _mm_movelh_ps(aHi, nbHi));
+    _mm_storeu_ps(m2 + 4, _mm_movelh_ps(kHi, zero));
+    _mm_storeu_ps(m2 + 8, _mm_movelh_ps(bHi, aHi));
+    _mm_storeu_ps(m2 + 12, _mm_movelh_ps(txHi, tzHi));
+
+    _mm_storeu_ps(m3, _mm_movehl_ps(nbHi, aHi));
+    _mm_storeu_ps(m3 + 4, _mm_movehl_ps(zero, kHi));
+    _mm_storeu_ps(m3 + 8, _mm_movehl_ps(aHi, bHi));
+    _mm_storeu_ps(m3 + 12, _mm_movehl_ps(tzHi, txHi));
+}
+
+}
+#endif
+
+#if defined(GNSSIS_SIMD_NEON)
+namespace {
+
+inline void store4(float *out, int stride, float32x4_t a, float32x4_t b, float32x4_t k,
+                   float32x4_t tx, float32x4_t ty, float32x4_t tz)
+{
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    const float32x4x2_t aZ = vzipq_f32(a, zero);
+    const float32x4x2_t nbZ = vzipq_f32(vnegq_f32(b), zero);
+    const float32x4x2_t bZ = vzipq_f32(b, zero);
+    const float32x4x2_t zK = vzipq_f32(zero, k);
+    const float32x4x2_t txy = vzipq_f32(tx, ty);
+    const float32x4x2_t tzOne = vzipq_f32(tz, vdupq_n_f32(1.0f));
+    const float32x2_t zero2 = vdup_n_f32(0.0f);
+
+    for (int half = 0; half < 2; ++half)
+    {
+        float *m0 = out + 2 * half * stride, *m1 = m0 + stride;
+        vst1q_f32(m0, vcombine_f32(vget_low_f32(aZ.val[half]), vget_low_f32(nbZ.val[half])));
+        vst1q_f32(m0 + 4, vcombine_f32(vget_low_f32(zK.val[half]), zero2));
+        vst1q_f32(m0 + 8, vcombine_f32(vget_low_f32(bZ.val[half]), vget_low_f32(aZ.val[half])));
+        vst1q_f32(m0 + 12, vcombine_f32(vget_low_f32(txy.val[half]), vget_low_f32(tzOne.val[half])));
+
+        vst1q_f32(m1, vcombine_f32(vget_high_f32(aZ.val[half]), vget_high_f32(nbZ.val[half])));
+        vst1q_f32(m1 + 4, vcombine_f32(vget_high_f32(zK.val[half]), zero2));
+        vst1q_f32(m1 + 8, vcombine_f32(vget_high_f32(bZ.val[half]), vget_high_f32(aZ.val[half])));
+        vst1q_f32(m1 + 12, vcombine_f32(vget_high_f32(txy.val[half]), vget_high_f32(tzOne.val[half])));
+    }
+}
+
+}
+#endif
+
+void ModelMatrixKernel::compose(const float *spinAngle, const float *scale, const float *x, const float *y, const float *z,
+                                int count, float *out, int stride)
+{
+    static const Variant variant = best();
+    compose(variant, spinAngle, scale, x, y, z, count, out, stride);
+}
+
+void ModelMatrixKernel::compose(Variant variant, const float *spinAngle, const float *scale,
+                                const float *x, const float *y, const float *z, int count, float *out, int stride)
+{
+    if (!isSupported(variant))
+        variant = Scalar;
+
+    switch (variant)
+    {
+    case Sse:
+        composeSse(spinAngle, scale, x, y, z, count, out, stride);
+        break;
+    case Avx2:
+        composeAvx2(spinAngle, scale, x, y, z, count, out, stride);
+        break;
+    case Neon:
+        composeNeon(spinAngle, scale, x, y, z, count, out, stride);
+        break;
+    default:
+        composeScalar(spinAngle, scale, x, y, z, count, out, stride);
+        break;
+    }
+}
+
+void ModelMatrixKernel::composeScalar(const float *spinAngle, const float *scale, const float *x, const float *y,
+                                      const float *z, int count, float *out, int stride)
+{
+    // referans sürüm; SIMD sürümleri bununla karşılaştırılır ve kalan cisimler için kullanılır
+    for (int i = 0; i < count; ++i)
+    {
+        const float spin = spinAngle[i] * degreesToRadians;
+        const float a = std::cos(spin) * scale[i], b = std::sin(spin) * scale[i];
+
+        float *m = out + size_t(i) * size_t(stride);
+        m[0] = a;     m[1] = 0.0f;     m[2] = -b;    m[3] = 0.0f;
+        m[4] = 0.0f;  m[5] = scale[i]; m[6] = 0.0f;  m[7] = 0.0f;
+        m[8] = b;     m[9] = 0.0f;     m[10] = a;    m[11] = 0.0f;
+        m[12] = x[i]; m[13] = y[i];    m[14] = z[i]; m[15] = 1.0f;
+    }
+}
+
+void ModelMatrixKernel::composeSse(const float *spinAngle, const float *scale, const float *x, const float *y,
+                                   const float *z, int count, float *out, int stride)
+{
+#if defined(GNSSIS_SIMD_X86)
+    const __m128 toRadians = _mm_set1_ps(degreesToRadians);
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 spinSin, spinCos;
+        sinCos4(_mm_mul_ps(_mm_loadu_ps(spinAngle + i), toRadians), spinSin, spinCos);
+
+        const __m128 k = _mm_loadu_ps(scale + i);
+        store4(out + size_t(i) * size_t(stride), stride, _mm_mul_ps(spinCos, k), _mm_mul_ps(spinSin, k), k,
+               _mm_loadu_ps(x + i), _mm_loadu_ps(y + i), _mm_loadu_ps(z + i));
+    }
+    composeScalar(spinAngle + i, scale + i, x + i, y + i, z + i, count - i, out + size_t(i) * size_t(stride), stride);
+#else
+    composeScalar(spinAngle, scale, x, y, z, count, out, stride);
+#endif
+}
+
+#if defined(GNSSIS_SIMD_X86)
+GNSSIS_TARGET_AVX2
+#endif
+void ModelMatrixKernel::composeAvx2(const float *spinAngle, const float *scale, const float *x, const float *y,
+                                    const float *z, int count, float *out, int stride)
+{
+#if defined(GNSSIS_SIMD_X86)
+    const __m256 toRadians = _mm256_set1_ps(degreesToRadians);
+    int i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256 spinSin, spinCos;
+        sinCos8(_mm256_mul_ps(_mm256_loadu_ps(spinAngle + i), toRadians), spinSin, spinCos);
+
+        const __m256 k = _mm256_loadu_ps(scale + i);
+        const __m256 a = _mm256_mul_ps(spinCos, k);
+        const __m256 b = _mm256_mul_ps(spinSin, k);
+
+        // matrisler 4'erli yazılır; 256 bitlik kayıtlar iki yarıya bölünür
+        float *m = out + size_t(i) * size_t(stride);
+        store4(m, stride, _mm256_castps256_ps128(a), _mm256_castps256_ps128(b), _mm256_castps256_ps128(k),
+               _mm_loadu_ps(x + i), _mm_loadu_ps(y + i), _mm_loadu_ps(z + i));
+        store4(m + 4 * stride, stride, _mm256_extractf128_ps(a, 1), _mm256_extractf128_ps(b, 1),
+               _mm256_extractf128_ps(k, 1), _mm_loadu_ps(x + i + 4), _mm_loadu_ps(y + i + 4), _mm_loadu_ps(z + i + 4));
+    }
+    composeSse(spinAngle + i, scale + i, x + i, y + i, z + i, count - i, out + size_t(i) * size_t(stride), stride);
+#else
+    composeScalar(spinAngle, scale, x, y, z, count, out, stride);
+#endif
+}
+
+void ModelMatrixKernel::composeNeon(const float *spinAngle, const float *scale, const float *x, const float *y,
+                                    const float *z, int count, float *out, int stride)
+{
+#if defined(GNSSIS_SIMD_NEON)
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        float32x4_t spinSin, spinCos;
+        sinCos4(vmulq_n_f32(vld1q_f32(spinAngle + i), degreesToRadians), spinSin, spinCos);
+
+        const float32x4_t k = vld1q_f32(scale + i);
+        store4(out + size_t(i) * size_t(stride), stride, vmulq_f32(spinCos, k), vmulq_f32(spinSin, k), k,
+               vld1q_f32(x + i), vld1q_f32(y + i), vld1q_f32(z + i));
+    }
+    composeScalar(spinAngle + i, scale + i, x + i, y + i, z + i, count - i, out + size_t(i) * size_t(stride), stride);
+#else
+    composeScalar(spinAngle, scale, x, y, z, count, out, stride);
+#endif
+}
@@ -0,0 +1,30 @@
+#ifndef MODELMATRIXKERNEL_H
+#define MODELMATRIXKERNEL_H
+
+#include "simdmath.h"
+
+// Cisimler yalnızca Y ekseni etrafında döndüğü için model matrisi açık biçimde yazılabilir:
+//   öteleme (x, y, z) * Ry(spinAngle) * scale
+// Çekirdek bunu açı, ölçek ve konum dizilerinden toplu olarak hesaplar ve sütun
+// öncelikli (column-major) matrisleri doğrudan çıktı tamponuna yazar. Açılar derece.
+class ModelMatrixKernel
+{
+public:
+    // stride: ardışık matrisler arasındaki float sayısı (>= 16), ör. instance yapısının boyu
+    static void compose(const float *spinAngle, const float *scale, const float *x, const float *y, const float *z,
+                        int count, float *out, int stride = 16);
+    static void compose(SimdMath::Variant variant, const float *spinAngle, const float *scale,
+                        const float *x, const float *y, const float *z, int count, float *out, int stride = 16);
+
+private:
+    static void composeScalar(const float *spinAngle, const float *scale, const float *x, const float *y, const float *z,
+                              int count, float *out, int stride);
+    static void composeSse(const float *spinAngle, const float *scale, const float *x, const float *y, const float *z,
+                           int count, float *out, int stride);
+    static void composeAvx2(const float *spinAngle, const float *scale, const float *x, const float *y, const float *z,
+                            int count, float *out, int stride);
+    static void composeNeon(const float *spinAngle, const float *scale, const float *x, const float *y, const float *z,
+                            int count, float *out, int stride);
+};
+
+#endif // MODELMATRIXKERNEL_H
@@ -0,0 +1,268 @@
+#include "nbodysimulation.h"
+
+#include <QElapsedTimer>
+#include <QtConcurrent/QtConcurrentMap>
+
+#include <cmath>
+
+namespace {
+
+// BodyStore ile aynı eşikler: küçük sahnelerde iş parçacığı başlatmak kazançtan pahalı
+const int parallelThreshold = 32768;
+const int chunkSize = 16384;
+
+}
+
+int NBodySimulation::addBody(const QVector3D &position, const QVector3D &velocity, float bodyMass)
+{
+    x.push_back(position.x());
+    y.push_back(position.y());
+    z.push_back(position.z());
+    vx.push_back(velocity.x());
+    vy.push_back(velocity.y());
+    vz.push_back(velocity.z());
+    mass.push_back(bodyMass);
+
+    ax.push_back(0.0f);
+    ay.push_back(0.0f);
+    az.push_back(0.0f);
+    previousX.push_back(position.x());
+    previousY.push_back(position.y());
+    previousZ.push_back(position.z());
+
+    accelerationsValid = false;
+    return size() - 1;
+}
+
+void NBodySimulation::reserve(int count)
+{
+    x.reserve(count);
+    y.reserve(count);
+    z.reserve(count);
+    vx.reserve(count);
+    vy.reserve(count);
+    vz.reserve(count);
+    mass.reserve(count);
+    ax.reserve(count);
+    ay.reserve(count);
+    az.reserve(count);
+    previousX.reserve(count);
+    previousY.reserve(count);
+    previousZ.reserve(count);
+}
+
+void NBodySimulation::clear()
+{
+    x.clear();
+    y.clear();
+    z.clear();
+    vx.clear();
+    vy.clear();
+    vz.clear();
+    mass.clear();
+    ax.clear();
+    ay.clear();
+    az.clear();
+    previousX.clear();
+    previousY.clear();
+    previousZ.clear();
+    accelerationsValid = false;
+}
+
+void NBodySimulation::step()
+{
+    if (size() == 0)
+        return;
+
+    // ilk adımda (ya da cisim eklendikten sonra) başlangıç ivmeleri
+    if (!accelerationsValid)
+        computeAccelerations();
+
+    kick(0.5f * timeStep);
+    drift(timeStep);
+    computeAccelerations();
+    kick(0.5f * timeStep);
+}
+
+void NBodySimulation::computeAccelerations()
+{
+    QElapsedTimer timer;
+    timer.start();
+    octree.build(x.data(), y.data(), z.data(), mass.data(), size());
+    lastBuildNs = timer.nsecsElapsed();
+
+    timer.restart();
+    octree.accelerations(theta, gravity, softening, ax.data(), ay.data(), az.data());
+    lastForceNs = timer.nsecsElapsed();
+    accelerationsValid = true;
+}
+
+void NBodySimulation::kick(float dt)
+{
+    auto kickRange = [this, dt](const std::pair<int, int> &range) {
+        for (int i = range.first; i < range.second; ++i)
+        {
+            vx[i] += ax[i] * dt;
+            vy[i] += ay[i] * dt;
+            vz[i] += az[i] * dt;
+        }
+    };
+
+    const int count = size();
+    if (count >= parallelThreshold)
+    {
+        ranges.clear();
+        for (int begin = 0; begin < count; begin += chunkSize)
+            ranges.emplace_back(begin, qMin(begin + chunkSize, count));
+        QtConcurrent::blockingMap(ranges, kickRange);
+    }
+    else
+    {
+        kickRange(std::make_pair(0, count));
+    }
+}
+
+void NBodySimulation::drift(float dt)
+{
+    auto driftRange = [this, dt](const std::pair<int, int> &range) {
+        for (int i = range.first; i < range.second; ++i)
+        {
+            previousX[i] = x[i];
+            previousY[i] = y[i];
+            previousZ[i] = z[i];
+            x[i] += vx[i] * dt;
+            y[i] += vy[i] * dt;
+            z[i] += vz[i] * dt;
+        }
+    };
+
+    const int count = size();
+    if (count >= parallelThreshold)
+    {
+        ranges.clear();
+        for (int begin = 0; begin < count; begin += chunkSize)
+            ranges.emplace_back(begin, qMin(begin + chunkSize, count));
+        QtConcurrent::blockingMap(ranges, driftRange);
+    }
+    else
+    {
+        driftRange(std::make_pair(0, count));
+    }
+}
+
+void NBodySimulation::interpolate(float alpha, float *outX, float *outY, float *outZ) const
+{
+    const int count = size();
+    for (int i = 0; i < count; ++i)
+    {
+        outX[i] = previousX[i] + (x[i] - previousX[i]) * alpha;
+        outY[i] = previousY[i] + (y[i] - previousY[i]) * alpha;
+        outZ[i] = previousZ[i] + (z[i] - previousZ[i]) * alpha;
+    }
+}
+
+int NBodySimulation::detectCollisions(CollisionDetector &detector, const float *radius) const
+{
+    return detector.detect(previousX.data(), previousY.data(), previousZ.data(),
+                           x.data(), y.data(), z.data(), radius, size());
+}
+
+int NBodySimulation::resolveCollisions(const std::vector<CollisionDetector::Contact> &contacts,
+                                       CollisionDetector::Response response, float *radius, float restitution)
+{
+    if (response == CollisionDetector::Flag)
+        return 0;
+
+    int resolved = 0;
+    for (const CollisionDetector::Contact &contact : contacts)
+    {
+        // yalnızca yakın geçenler ve bu adımda başka bir cisme katılmış olanlar atlanır
+        const int a = contact.first, b = contact.second;
+        if (contact.separation >= 0.0f || radius[a] <= 0.0f || radius[b] <= 0.0f)
+            continue;
+        const float massA = mass[a], massB = mass[b];
+        if (massA + massB <= 0.0f)
+            continue;
+
+        if (response == CollisionDetector::Merge)
+        {
+            // kütlesi büyük olan kalır; eşitse indisi küçük olan
+            const int keep = massB > massA ? b : a, gone = keep == a ? b : a;
+            const float total = massA + massB;
+            const float keepShare = mass[keep] / total, goneShare = mass[gone] / total;
+            x[keep] = x[keep] * keepShare + x[gone] * goneShare;
+            y[keep] = y[keep] * keepShare + y[gone] * goneShare;
+            z[keep] = z[keep] * keepShare + z[gone] * goneShare;
+            vx[keep] = vx[keep] * keepShare + vx[gone] * goneShare;
+            vy[keep] = vy[keep] * keepShare + vy[gone] * goneShare;
+            vz[keep] = vz[keep] * keepShare + vz[gone] * goneShare;
+            mass[keep] = total;
+            radius[keep] = std::cbrt(radius[keep] * radius[keep] * radius[keep]
+                                     + radius[gone] * radius[gone] * radius[gone]);
+
+            // yutulan cisim yerinde kalır ama kimseyi çekmez ve bir daha sınanmaz
+            mass[gone] = 0.0f;
+            radius[gone] = 0.0f;
+            vx[gone] = vy[gone] = vz[gone] = 0.0f;
+            accelerationsValid = false;
+            ++resolved;
+            continue;
+        }
+
+        // Bounce: adım içinde kürelerin ilk değdiği an |d + t m| = ra + rb çözülür,
+        // d başlangıçtaki uzaklık, m göreli yol. Hızlı cisimler adım içinde birbirinin
+        // içinden geçmiş olabilir; adım sonundaki konumlar normal için kullanılamaz.
+        const float dx = previousX[b] - previousX[a], dy = previousY[b] - previousY[a], dz = previousZ[b] - previousZ[a];
+        const float mx = (x[b] - previousX[b]) - (x[a] - previousX[a]);
+        const float my = (y[b] - previousY[b]) - (y[a] - previousY[a]);
+        const float mz = (z[b] - previousZ[b]) - (z[a] - previousZ[a]);
+        const float reach = radius[a] + radius[b];
+        const float moved = mx * mx + my * my + mz * mz;
+        const float along = dx * mx + dy * my + dz * mz;
+        const float outside = dx * dx + dy * dy + dz * dz - reach * reach;
+        float touch = 0.0f;
+        if (outside > 0.0f && moved > 0.0f)
+        {
+            const float discriminant = along * along - moved * outside;
+            touch = discriminant > 0.0f ? qBound(0.0f, (-along - std::sqrt(discriminant)) / moved, 1.0f) : contact.time;
+        }
+
+        float nx = dx + touch * mx, ny = dy + touch * my, nz = dz + touch * mz;
+        const float distance = std::sqrt(nx * nx + ny * ny + nz * nz);
+        if (distance <= 0.0f)
+            continue;
+        nx /= distance;
+        ny /= distance;
+        nz /= distance;
+
+        // kütlesiz cisim sonsuz hafif sayılır: tüm itme ona gider
+        const float inverseA = massA > 0.0f ? 1.0f / massA : (massB > 0.0f ? 1.0e6f / massB : 0.0f);
+        const float inverseB = massB > 0.0f ? 1.0f / massB : (massA > 0.0f ? 1.0e6f / massA : 0.0f);
+        const float inverseSum = inverseA + inverseB;
+
+        const float approach = (vx[b] - vx[a]) * nx + (vy[b] - vy[a]) * ny + (vz[b] - vz[a]) * nz;
+        if (approach >= 0.0f)
+            continue;
+        const float impulse = -(1.0f + restitution) * approach / inverseSum;
+        vx[a] -= impulse * inverseA * nx;
+        vy[a] -= impulse * inverseA * ny;
+        vz[a] -= impulse * inverseA * nz;
+        vx[b] += impulse * inverseB * nx;
+        vy[b] += impulse * inverseB * ny;
+        vz[b] += impulse * inverseB * nz;
+
+        // değme anına geri sarılıp adımın kalanı yeni hızlarla yürünür; adım başında zaten
+        // iç içe olanlar kütleyle ters orantılı ayrılır. Kayma küçük, ivmeler yeniden hesaplanmaz.
+        const float overlap = qMax(0.0f, reach - distance);
+        const float rest = (1.0f - touch) * timeStep;
+        const float pushA = overlap * inverseA / inverseSum, pushB = overlap * inverseB / inverseSum;
+        x[a] = previousX[a] + (x[a] - previousX[a]) * touch + vx[a] * rest - pushA * nx;
+        y[a] = previousY[a] + (y[a] - previousY[a]) * touch + vy[a] * rest - pushA * ny;
+        z[a] = previousZ[a] + (z[a] - previousZ[a]) * touch + vz[a] * rest - pushA * nz;
+        x[b] = previousX[b] + (x[b] - previousX[b]) * touch + vx[b] * rest + pushB * nx;
+        y[b] = previousY[b] + (y[b] - previousY[b]) * touch + vy[b] * rest + pushB * ny;
+        z[b] = previousZ[b] + (z[b] - previousZ[b]) * touch + vz[b] * rest + pushB * nz;
+        ++resolved;
+    }
+    return resolved;
+}
@@ -0,0 +1,74 @@
+#ifndef NBODYSIMULATION_H
+#define NBODYSIMULATION_H
+
+#include <QVector3D>
+
+#include <vector>
+
+#include "barneshuttree.h"
+#include "collisiondetector.h"
+
+// Tüm cisimler arasında karşılıklı kütle çekimi. Her adımda Barnes–Hut ağacı yeniden
+// kurulur, ivmeler ağaçtan bulunur ve cisimler kick-drift-kick leapfrog ile ilerler
+// (sabit adımda enerji uzun süre sapmaz). Konum, hız ve ivme ayrı dizilerde tutulur.
+// Pencere ya da GL bağlamı gerektirmez; NBodyBench aynı sınıfı ekransız çalıştırır.
+class NBodySimulation
+{
+public:
+    int addBody(const QVector3D &position, const QVector3D &velocity, float bodyMass);
+    void reserve(int count);
+    void clear();
+    int size() const { return int(mass.size()); }
+
+    // açılma açısı: 0 doğrudan toplam, büyüdükçe hızlı ve kaba (ör. 0.3 .. 1.0)
+    void setTheta(float value) { theta = value; }
+    float openingAngle() const { return theta; }
+    void setGravity(float value) { gravity = value; }
+    // yakın geçişlerde ivmeyi sınırlar; sahne birimi
+    void setSoftening(float value) { softening = value; }
+    // adım başına süre; QOpenGLPanel'de bir adım = bir simülasyon tick'i
+    void setTimeStep(float value) { timeStep = value; }
+
+    void step();
+    // son iki adım arasında alpha oranında (1: son adım) ara değerlenmiş konumlar
+    void interpolate(float alpha, float *outX, float *outY, float *outZ) const;
+
+    // son adımın başı ve sonu arasında süpürülmüş küreleri sınar; radius cisim başına
+    int detectCollisions(CollisionDetector &detector, const float *radius) const;
+    // İç içe geçen çiftlere tepki. Bounce: çarpışma normali boyunca esneklik katsayılı
+    // itme ve kürelerin ayrılması. Merge: büyük cisim küçüğü yutar (momentum korunur,
+    // hacimler toplanır), yutulanın kütlesi ve yarıçapı 0 olur. Değişen çift sayısını döndürür.
+    int resolveCollisions(const std::vector<CollisionDetector::Contact> &contacts,
+                          CollisionDetector::Response response, float *radius, float restitution = 0.5f);
+
+    const BarnesHutTree &tree() const { return octree; }
+    // son adımın ağaç kurulumu ve kuvvet hesabı süreleri
+    qint64 buildNsecs() const { return lastBuildNs; }
+    qint64 forceNsecs() const { return lastForceNs; }
+
+    std::vector<float> x, y, z;
+    std::vector<float> vx, vy, vz;
+    std::vector<float> mass;
+
+private:
+    void computeAccelerations();
+    // hızlara yarım adım ivme ekler (kick)
+    void kick(float dt);
+    // konumları bir adım ilerletir, öncekileri ara değerleme için saklar (drift)
+    void drift(float dt);
+
+    float theta = 0.5f;
+    float gravity = 1.0f;
+    float softening = 0.01f;
+    float timeStep = 1.0f;
+
+    std::vector<float> ax, ay, az;
+    std::vector<float> previousX, previousY, previousZ;
+    bool accelerationsValid = false;
+
+    BarnesHutTree octree;
+    std::vector<std::pair<int, int>> ranges;    // iş parçacıklarına dağıtılan bloklar
+    qint64 lastBuildNs = 0, lastForceNs = 0;
+};
+
+#endif // NBODYSIMULATION_H
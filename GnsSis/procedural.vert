@@ -0,0 +1,47 @@
+#version 430
+// köşe tamponu yok: küre konumu, normali ve uv'si gl_VertexID'den,
+// cisim verisi gl_InstanceID ile instance tamponundan (SSBO) okunur
+
+// cisim başına (instance) veriler; QOpenGLPanel::BodyInstance ile aynı düzen
+struct BodyInstance {
+   mat4 mvp;                 // projection * camera * translate * model * rotate * scale, CPU'da
+   float layer;
+};
+layout(std430, binding = 0) readonly buffer Instances {
+   BodyInstance instances[];
+};
+
+uniform int segments;        // enlem ve boylam bölüm sayısı (LOD seviyesi)
+uniform int baseInstance;    // 4.3'te gl_BaseInstance yok, grup başı elle verilir
+
+out vec3 outColor;
+
+
+out vec3 outNorm;
+out vec2 outTexCoord;
+flat out float outLayer;
+
+const float PI = 3.14159265359;
+
+void main() {
+   // SphereMeshCache::build ile aynı şerit sırası: her satır (segments + 1) * 2 köşe,
+   // tek satırlar ters yönde ve alt/üst sırası değişik
+   int perRow = (segments + 1) * 2;
+   int row = gl_VertexID / perRow;
+   int k = gl_VertexID - row * perRow;
+   bool oddRow = (row & 1) == 1;
+   int x = oddRow ? segments - k / 2 : k / 2;
+   int y = row + (((k & 1) == 1) != oddRow ? 1 : 0);
+
+   vec2 uv = vec2(float(x), float(y)) / float(segments);
+   float theta = uv.x * 2.0 * PI;
+   float phi = uv.y * PI;
+   vec3 position = vec3(cos(theta) * sin(phi), cos(phi), sin(theta) * sin(phi));
+
+   BodyInstance body = instances[baseInstance + gl_InstanceID];
+   gl_Position = body.mvp * vec4(position, 1.0);
+   outColor = vec3(1.0);
+   outNorm = position;
+   outTexCoord = uv;
+   outLayer = body.layer;
+}
@@ -1,7 +1,152 @@
 #include "qopenglpanel.h"
+#include "simdmath.h"
+
+#include <QPainter>
+#include <QRandomGenerator>
+#include <QtOpenGL/QOpenGLVersionFunctionsFactory>
+
+#include <algorithm>
+#include <cstddef>
+
+namespace {
+
+// sütun öncelikli 4x4 matrisler: out = a * b
+void multiplyMatrices(const float *a, const float *b, float *out)
+{
+    for (int column = 0; column < 4; ++column)
+    {
+        const float *bc = b + 4 * column;
+        for (int row = 0; row < 4; ++row)
+            out[4 * column + row] = a[row] * bc[0] + a[4 + row] * bc[1] + a[8 + row] * bc[2] + a[12 + row] * bc[3];
+    }
+}
+
+}
 
 QOpenGLPanel::QOpenGLPanel(QWidget *parent) :QOpenGLWidget(parent)
 {
+    startupTimer.start();
+    firstFrameLogged = false;
+    fullyTexturedLogged = false;
+
+    gl43 = nullptr;
+    frameTimeSum = 0;
+    frameTimeCount = 0;
+
+    // GNSSIS_RENDER_PATH=perbody eski çizim yolunu seçer (karşılaştırma için)
+    // GNSSIS_RENDER_PATH=procedural köşe tamponu kullanmayan yolu seçer
+    const QByteArray pathName = qgetenv("GNSSIS_RENDER_PATH");
+    renderPath = pathName == "perbody" ? PerBodyPath : pathName == "procedural" ? ProceduralPath : InstancedPath;
+    // GNSSIS_TEXTURES=separate her yüzeyi ayrı doku olarak yükler
+    textureMode = qgetenv("GNSSIS_TEXTURES") == "separate" ? SeparateTextures : ArrayTextures;
+    textureTarget = textureMode == ArrayTextures ? GL_TEXTURE_2D_ARRAY : GL_TEXTURE_2D;
+    // GNSSIS_STATE_CACHE=off aynı durumu yeniden kuran çağrıları da gönderir
+    glState.setEnabled(qgetenv("GNSSIS_STATE_CACHE") != "off");
+
+    // GNSSIS_LOD=off cisimleri sabit 64x64 / 32x32 kürelerle çizer
+    // GNSSIS_LOD_ERROR izin verilen silüet hatası (piksel)
+    levelOfDetail = qgetenv("GNSSIS_LOD") != "off";
+    const float lodError = qgetenv("GNSSIS_LOD_ERROR").toFloat();
+    lodMaxError = lodError > 0.0f ? lodError : 1.0f;
+    lodVertices = 0;
+    fixedVertices = 0;
+    beltBodyCount = qMax(0, qEnvironmentVariableIntValue("GNSSIS_BELT_BODIES"));
+    frustumCulling = qgetenv("GNSSIS_CULLING") != "off";
+    // GNSSIS_BELT_PARTICLES ve GNSSIS_KUIPER_PARTICLES compute shader ile ilerletilen parçacık sayıları
+    asteroidParticleCount = qMax(0, qEnvironmentVariableIntValue("GNSSIS_BELT_PARTICLES"));
+    kuiperParticleCount = qMax(0, qEnvironmentVariableIntValue("GNSSIS_KUIPER_PARTICLES"));
+    // GNSSIS_EPHEMERIS Chebyshev katsayılı konum dosyası (bkz. Ephemeris)
+    ephemerisPath = qEnvironmentVariable("GNSSIS_EPHEMERIS");
+    // GNSSIS_MATRIX_KERNEL=off model matrislerini cisim başına QMatrix4x4 ile kurar
+    bodies.setMatrixKernel(qgetenv("GNSSIS_MATRIX_KERNEL") != "off");
+    if (bodies.matrixKernel())
+        qDebug() << "Orbit and matrix kernels:" << SimdMath::name(SimdMath::best());
+    drawnBodyCount = 0;
+
+    // GNSSIS_SIMULATION=nbody cisimleri karşılıklı kütle çekimiyle hareket ettirir,
+    // GNSSIS_NBODY_THETA Barnes–Hut açılma açısı (varsayılan 0.5)
+    simulationMode = qgetenv("GNSSIS_SIMULATION") == "nbody" ? NBodyMode : KeplerMode;
+    const float theta = qgetenv("GNSSIS_NBODY_THETA").toFloat();
+    if (theta > 0.0f)
+        nbody.setTheta(theta);
+
+    // GNSSIS_COLLISIONS=flag çarpışan ve yakın geçen cisimleri raporlar; bounce ve merge
+    // N-body modunda cisimleri sektirir ya da birleştirir
+    const QByteArray collisionName = qgetenv("GNSSIS_COLLISIONS");
+    collisionDetection = collisionName == "flag" || collisionName == "bounce" || collisionName == "merge";
+    collisionResponse = collisionName == "bounce" ? CollisionDetector::Bounce
+                      : collisionName == "merge" ? CollisionDetector::Merge : CollisionDetector::Flag;
+    overlapTotal = 0;
+    resolvedTotal = 0;
+    collisionChecks = 0;
+
+    // GNSSIS_SIMULATION_THREAD=off simülasyonu paintGL içinde, çizimle sırayla ilerletir
+    threadedSimulation = qgetenv("GNSSIS_SIMULATION_THREAD") != "off";
+    sweepReset = false;
+    scaleVersion = 0;
+    appliedScaleVersion = 0;
+    stateTime = 0.0;
+    simulationStepNsecs = 0;
+
+    // GNSSIS_PROFILER=off bölgeleri ve GPU sorgularını kapatır
+    profiler.setEnabled(qgetenv("GNSSIS_PROFILER") != "off");
+    profilerOverlay = qgetenv("GNSSIS_PROFILER_HUD") == "on";
+
+    // kayıt initializeGL'de başlar; varsayılan 1920x1080, 60 fps
+    capturePreview = true;
+    capturePath = qEnvironmentVariable("GNSSIS_CAPTURE");
+    const QStringList captureParts = qEnvironmentVariable("GNSSIS_CAPTURE_SIZE").split('x');
+    captureSize = QSize(captureParts.value(0).toInt(), captureParts.value(1).toInt());
+    if (captureSize.isEmpty())
+        captureSize = QSize(1920, 1080);
+    captureFps = qEnvironmentVariableIntValue("GNSSIS_CAPTURE_FPS");
+    if (captureFps <= 0)
+        captureFps = 60;
+    const QString tracePath = qEnvironmentVariable("GNSSIS_PROFILER_TRACE");
+    if (!tracePath.isEmpty() && profiler.isEnabled())
+    {
+        // varsayılan ilk 300 kare
+        const QStringList range = qEnvironmentVariable("GNSSIS_PROFILER_TRACE_FRAMES").split('-');
+        const qint64 first = range.value(0).toLongLong();
+        const qint64 last = range.size() > 1 ? range.value(1).toLongLong() : first + 299;
+        profiler.captureTrace(tracePath, first, last);
+    }
+
+    // GNSSIS_TICK_RATE simülasyon adım sıklığını (Hz), GNSSIS_FPS kare sınırını belirler
+    const int tickRate = qEnvironmentVariableIntValue("GNSSIS_TICK_RATE");
+    simulationClock.setTickRate(tickRate > 0 ? tickRate : 60);
+    // GNSSIS_TIME_SCALE gerçek adım başına simülasyon adımı (ör. 1000, -1), GNSSIS_START_TIME
+    // başlangıç anı (adım); yörüngeler zamandan doğrudan hesaplandığı için atlama maliyetsizdir
+    const double startTime = qgetenv("GNSSIS_START_TIME").toDouble();
+    if (startTime != 0.0)
+        setSimulationTime(startTime);
+    const double timeScale = qgetenv("GNSSIS_TIME_SCALE").toDouble();
+    if (timeScale != 0.0)
+        setTimeScale(timeScale);
+    // 1000'in üstü ms'lik zamanlayıcıyla sınırlanamaz
+    const int fps = qEnvironmentVariableIntValue("GNSSIS_FPS");
+    targetFps = fps > 0 ? qMin(fps, maxTargetFps) : 0;
+    if (fps > maxTargetFps)
+        qDebug() << "GNSSIS_FPS" << fps << "is above" << maxTargetFps << "- limiting to" << maxTargetFps;
+    frameIntervalNsecs = targetFps > 0 ? 1000000000 / targetFps : 0;
+    nextFrameNsecs = 0;
+    renderingPaused = true;
+
+    if (targetFps > 0)
+    {
+        pacingTimer.setTimerType(Qt::PreciseTimer);
+        pacingTimer.setSingleShot(true);
+        connect(&pacingTimer, &QTimer::timeout, this, [this]() {
+            update();
+            schedulePacedFrame();
+        });
+    }
+    else
+    {
+        // bir kare ekrana verilince sıradaki istenir; swap dikey eşitlemede bekler
+        connect(this, &QOpenGLWidget::frameSwapped, this, [this]() { scheduleFrame(); });
+    }
+
     resetScene();
 }
 
@@ -38,161 +183,185 @@ void QOpenGLPanel::resetScene()
 
 QOpenGLPanel::~QOpenGLPanel()
 {
-
+    // iş parçacığı panelin üyelerini (nbody, çarpışmalar) kullanır; önce o durur
+    simulationThread.stop();
+    // zamanlayıcı sorguları oluşturuldukları bağlamda silinir; pencere olmadan çizildiyse
+    // (RenderBench) çağıranın bağlamı hâlâ current
+    if (context())
+        makeCurrent();
+    if (capture.isActive())
+        capture.stop(getGLExtraFunctions());
+    profiler.release();
+    if (context())
+        doneCurrent();
 }
 
-void QOpenGLPanel::mousePressEvent(QMouseEvent* event)
+void QOpenGLPanel::setRenderPath(RenderPath path)
 {
-    resetScene();
-
+    // procedural yolla başlanmışsa köşe tamponları hiç oluşturulmadı
+    if (path != ProceduralPath && !meshes.empty() && meshes[0].vao == 0)
+    {
+        qDebug() << "Sphere vertex buffers were not created, staying on the procedural render path";
+        return;
+    }
+    renderPath = path;
+    frameTimeSum = 0;
+    frameTimeCount = 0;
 }
 
+void QOpenGLPanel::showEvent(QShowEvent *event)
+{
+    QOpenGLWidget::showEvent(event);
+    renderingPaused = false;
+    simulationClock.resume();
+    if (targetFps > 0)
+    {
+        pacingClock.start();
+        nextFrameNsecs = 0;
+        schedulePacedFrame();
+    }
+    update();
+}
 
-QOpenGLFunctions* QOpenGLPanel::getGLFunctions()
+void QOpenGLPanel::hideEvent(QHideEvent *event)
 {
-    return QOpenGLContext::currentContext()->functions();
+    // pencere gizlenince ya da simge durumuna küçültülünce hem çizim hem simülasyon durur
+    QOpenGLWidget::hideEvent(event);
+    renderingPaused = true;
+    simulationClock.pause();
+    pacingTimer.stop();
 }
 
-QOpenGLExtraFunctions* QOpenGLPanel::getGLExtraFunctions()
+void QOpenGLPanel::schedulePacedFrame()
 {
-    return QOpenGLContext::currentContext()->extraFunctions();
+    // Zamanlayıcı ms çözünürlüğünde; bekleme ns'lik son tarihe göre yuvarlanır, böylece
+    // aralıklar 16 ile 17 ms arasında değişir ve ortalama tam 1/targetFps olur
+    const qint64 now = pacingClock.nsecsElapsed();
+    nextFrameNsecs += frameIntervalNsecs;
+    // takılmadan sonra kaçırılan kareler art arda çizilmez
+    if (nextFrameNsecs < now)
+        nextFrameNsecs = now;
+    pacingTimer.start(int((nextFrameNsecs - now + 500000) / 1000000));
 }
 
-bool QOpenGLPanel::initializeShaderProgram(QString vertex, QString fragment, QOpenGLFunctions *f)
+void QOpenGLPanel::scheduleFrame()
 {
-    progID = f->glCreateProgram();
+    if (!renderingPaused)
+        update();
+}
 
-    vertID = f->glCreateShader(GL_VERTEX_SHADER);
-    const char* vertSource = readShaderSource(vertex);
-    f->glShaderSource(vertID,1,&vertSource,nullptr);
-    f->glCompileShader(vertID);
-    f->glAttachShader(progID, vertID);
+void QOpenGLPanel::setBeltBodyCount(int count)
+{
+    beltBodyCount = qMax(0, count);
+}
 
-    fragID = f->glCreateShader(GL_FRAGMENT_SHADER);
-    const char* fragSource = readShaderSource(fragment);
-    f->glShaderSource(fragID,1,&fragSource,nullptr);
-    f->glCompileShader(fragID);
-    f->glAttachShader(progID, fragID);
+void QOpenGLPanel::setLevelOfDetail(bool enabled)
+{
+    levelOfDetail = enabled;
+}
 
-    f->glLinkProgram(progID);
+void QOpenGLPanel::setBeltParticleCount(int asteroids, int kuiperObjects)
+{
+    asteroidParticleCount = qMax(0, asteroids);
+    kuiperParticleCount = qMax(0, kuiperObjects);
+}
 
-    return checkGLError(f, "Linking Shader Program");
+void QOpenGLPanel::setEphemerisFile(const QString &path)
+{
+    ephemerisPath = path;
 }
 
-bool QOpenGLPanel::checkGLError(QOpenGLFunctions *f, QString functionCall)
+void QOpenGLPanel::setSimulationMode(SimulationMode mode)
 {
-    GLenum error = f->glGetError();
-    if(error == GL_NO_ERROR){
-        qDebug()<<"No OpenGL Error while "<<functionCall;
-        return true;
-    }else{
-        qDebug()<<"Error "<<error<<" while "<<functionCall;
-        return false;
+    // N-body durumu (nbody, nbodyX/Y/Z) yalnızca initializeGL'de kurulur; meshes de orada dolar
+    // (araçlar initializeGL'i pencere olmadan doğrudan çağırır, isValid() güvenilmez)
+    if (!meshes.empty() && mode != simulationMode)
+    {
+        qDebug() << "Simulation mode can only be set before initialization, staying in"
+                 << (simulationMode == NBodyMode ? "N-body" : "Kepler") << "mode";
+        return;
     }
+    simulationMode = mode;
+    // N-body adım adım integre edilir; hızlandırma ve atlama Kepler modunda
+    if (mode == NBodyMode)
+        simulationClock.setTimeScale(1.0);
 }
 
-const char* QOpenGLPanel::readShaderSource(QString filename)
+void QOpenGLPanel::setTimeScale(double scale)
 {
-    const char* source = nullptr;
-    QFile shaderFile(filename);
-    if(!shaderFile.open(QFile::ReadOnly|QFile::Text)){
-        qDebug()<<"Error while reading shader source file";
-        return source;
+    if (simulationMode == NBodyMode && scale != 1.0)
+    {
+        qDebug() << "Time warp is only available in Kepler mode, N-body runs in real time";
+        return;
     }
-
-    QTextStream in(&shaderFile);
-    QString text = in.readAll();
-    shaderFile.close();
-    QByteArray ba = text.toLocal8Bit();
-    source = ba.data();
-
-    return source;
+    simulationClock.setTimeScale(qBound(-maxTimeScale, scale, maxTimeScale));
 }
 
-GLuint QOpenGLPanel::createSphere(GLuint X_SEGMENTS, GLuint Y_SEGMENTS, GLfloat x_offset, GLfloat y_offset, GLfloat z_offset)
+void QOpenGLPanel::setSimulationTime(double ticks)
 {
-
-    vert.clear();
-    indices.clear();
-
-    positions.clear();
-    uv.clear();
-    normals.clear();
-
-    const float PI = 3.14159265359f;
-    for (GLuint x = 0; x <= X_SEGMENTS; ++x)
+    if (simulationMode == NBodyMode)
     {
-        for (GLuint y = 0; y <= Y_SEGMENTS; ++y)
-        {
-            float xSegment = (float)x / (float)X_SEGMENTS;
-            float ySegment = (float)y / (float)Y_SEGMENTS;
+        qDebug() << "Jumping in time is only available in Kepler mode";
+        return;
+    }
+    simulationClock.setTime(ticks);
+    // süpürme simülasyon tarafında, bir sonraki istekle sıfırlanır
+    sweepReset = true;
+}
 
-            float xPos = (cos(xSegment * 2.0f * PI) * sin(ySegment * PI)) + x_offset;
-            float yPos = (cos(ySegment * PI)) + y_offset;
-            float zPos = (sin(xSegment * 2.0f * PI) * sin(ySegment * PI)) + z_offset;
+void QOpenGLPanel::startSimulation()
+{
+    simulationClock.resume();
+}
 
-            QVector3D vertex(xPos, yPos, zPos);
-            positions.append(vertex);
+void QOpenGLPanel::setNBodyTheta(float theta)
+{
+    nbody.setTheta(theta);
+}
 
-            QVector2D texture(xSegment, ySegment);
-            uv.append(texture);
+void QOpenGLPanel::setCollisionDetection(bool enabled, CollisionDetector::Response response)
+{
+    collisionDetection = enabled;
+    collisionResponse = response;
+}
 
-            QVector3D normal(xPos, yPos, zPos);
-            normals.append(normal);
-        }
-    }
+void QOpenGLPanel::mousePressEvent(QMouseEvent* event)
+{
+    resetScene();
 
-    bool oddRow = false;
-    for (GLuint y = 0; y < Y_SEGMENTS; ++y)
-    {
-        if (!oddRow)
-        {
-            for (GLuint x = 0; x <= X_SEGMENTS; ++x)
-            {
-                indices.push_back(y * (X_SEGMENTS + 1) + x);
-                indices.push_back((y + 1) * (X_SEGMENTS + 1) + x);
-            }
-        }
-        else
-        {
-            for (int x = X_SEGMENTS; x >= 0; --x)
-            {
-                indices.push_back((y + 1) * (X_SEGMENTS + 1) + x);
-                indices.push_back(y * (X_SEGMENTS + 1) + x);
-            }
-        }
-        oddRow = !oddRow;
-    }
-    indexCount = static_cast<GLuint>(indices.size());
+}
 
 
-    for (GLuint i = 0; i < positions.size(); ++i)
-    {
-        vert.push_back(positions[i].x());
-        vert.push_back(positions[i].y());
-        vert.push_back(positions[i].z());
-        if (normals.size() > 0)
-        {
-            vert.push_back(normals[i].x());
-            vert.push_back(normals[i].y());
-            vert.push_back(normals[i].z());
-        }
-        if (uv.size() > 0)
-        {
-            vert.push_back(uv[i].x());
-            vert.push_back(uv[i].y());
-        }
-    }
+QOpenGLFunctions* QOpenGLPanel::getGLFunctions()
+{
+    return QOpenGLContext::currentContext()->functions();
+}
 
-    float vertAndColors[indices.size()];
+QOpenGLExtraFunctions* QOpenGLPanel::getGLExtraFunctions()
+{
+    return QOpenGLContext::currentContext()->extraFunctions();
+}
 
+GLuint QOpenGLPanel::initializeShaderProgram(QString vertex, QString fragment, QOpenGLFunctions *f)
+{
+    // kaynaklar ShaderCache içinde okunur ve glShaderSource boyunca yaşar
+    GLuint program = shaderCache.build(getGLExtraFunctions(), { { GL_VERTEX_SHADER, vertex },
+                                                                { GL_FRAGMENT_SHADER, fragment } });
 
-    for (int i = 0; i < indices.size(); i++)
-    {
-        vertAndColors[i] = vert[i];
-    }
+    checkGLError(f, "Linking Shader Program " + vertex);
+    return program;
+}
 
-    return indexCount;
+bool QOpenGLPanel::checkGLError(QOpenGLFunctions *f, QString functionCall)
+{
+    GLenum error = f->glGetError();
+    if(error == GL_NO_ERROR){
+        qDebug()<<"No OpenGL Error while "<<functionCall;
+        return true;
+    }else{
+        qDebug()<<"Error "<<error<<" while "<<functionCall;
+        return false;
+    }
 }
 
 GLuint QOpenGLPanel::loadTexture(QString fileName){
@@ -233,315 +402,429 @@ void QOpenGLPanel::initializeGL()
     f->initializeOpenGLFunctions();
     QOpenGLExtraFunctions *ef = getGLExtraFunctions();
     ef->initializeOpenGLFunctions();
+    profiler.initialize();
 
     f->glClearColor(0.0, 0.0, 0.0, 0.0);
 
     // derinlik penceresini aktifleştirir
     f->glEnable(GL_DEPTH_TEST);
 
-    initializeShaderProgram(":simple.vert", ":simple.frag",f);
-
-    translateMatrixID = f->glGetUniformLocation(progID,"translateMatrix");
-    rotateMatrixID = f->glGetUniformLocation(progID, "rotateMatrix");
-    scaleMatrixID = f->glGetUniformLocation(progID, "scaleMatrix");
-    cameraMatrixID = f->glGetUniformLocation(progID, "cameraMatrix");
-    projectionMatrixID = f->glGetUniformLocation(progID, "projectionMatrix");
-
-    ef->glGenVertexArrays(2, &sphereVAO[0]);
-
-    f->glGenBuffers(2, &vbo[0]);
-    f->glGenBuffers(2, &ebo[0]);
-
+    const qint64 shadersStarted = profiler.now();
+    QString fragmentShader = textureMode == ArrayTextures ? ":texturearray.frag" : ":simple.frag";
+    progID = initializeShaderProgram(":simple.vert", fragmentShader,f);
+
+    // matrisler uniform olarak gönderilmez: cisim başına MVP instance tamponunda,
+    // görüş ve izdüşüm Frame bloğunda (FrameUniforms)
+    instanceIndexID = f->glGetUniformLocation(progID, "instanceIndex");
+
+    instancedProgID = initializeShaderProgram(":instanced.vert", fragmentShader, f);
+
+    proceduralProgID = initializeShaderProgram(":procedural.vert", fragmentShader, f);
+    proceduralSegmentsID = f->glGetUniformLocation(proceduralProgID, "segments");
+    proceduralBaseInstanceID = f->glGetUniformLocation(proceduralProgID, "baseInstance");
+    profiler.addZone("Shader programs", FrameProfiler::MainTrack, shadersStarted, profiler.now());
+    // çekirdek profilde çizim için bir VAO bağlı olmalı; hiçbir özniteliği yok
+    ef->glGenVertexArrays(1, &proceduralVAO);
+    frameUniforms.create(ef);
+
+    // glDrawElementsInstancedBaseInstance için; yoksa cisim başına yola dönülür
+    gl43 = QOpenGLVersionFunctionsFactory::get<QOpenGLFunctions_4_3_Core>(QOpenGLContext::currentContext());
+    if (gl43)
+        gl43->initializeOpenGLFunctions();
+    else
+        qDebug() << "OpenGL 4.3 functions unavailable, using per-body render path";
+
+    // her LOD seviyesi için bir küre (8x8 .. 256x256); procedural yolda yalnızca köşe sayısı tutulur
+    const bool bufferedMeshes = activeRenderPath() != ProceduralPath;
+    meshes.clear();
+    {
+        FrameProfiler::CpuZone zone(profiler, "Mesh build");
+        for (int level = 0; level < SphereLod::levelCount; ++level)
+        {
+            const int segments = SphereLod::segments(level);
+            if (bufferedMeshes)
+                meshes.push_back(meshCache.get(ef, segments, segments));
+            else
+                meshes.push_back({ 0, 0, 0, SphereMeshCache::stripLength(segments, segments) });
+        }
+    }
 
     checkGLError(f, "Generating and Binding Vertex Arrays");
 
+    {
+        FrameProfiler::CpuZone zone(profiler, "Scene setup");
+        buildSolarSystem();
+        if (simulationMode == NBodyMode)
+            initNBody();
+        initBeltParticles();
+        initEphemeris();
+    }
+    if (threadedSimulation)
+    {
+        FrameProfiler::CpuZone zone(profiler, "Simulation thread start");
+        startSimulationThread();
+    }
 
-    // güneş texture u ekleniyor
-    QString sunTexFileName = ":/img/8k_sun.jpg";
-    sunTexture = loadTexture(sunTexFileName);
-
-    GLuint stride = (3 + 2 + 3) * sizeof(float);
-
-    sunSize = createSphere(64, 64, 0.0f, 0.0f, 0.0f);
-
-
-    ef->glBindVertexArray(sphereVAO[0]);
-    f->glBindBuffer(GL_ARRAY_BUFFER, vbo[0]);
-    f->glBufferData(GL_ARRAY_BUFFER, vert.size() * sizeof(float), &vert[0], GL_STATIC_DRAW);
-
-    f->glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo[0]);
-    f->glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), &indices[0], GL_STATIC_DRAW);
-
-
-    position = f->glGetAttribLocation(progID, "position");
-    f->glVertexAttribPointer(position, 3, GL_FLOAT, GL_FALSE, stride, (void*)0);
-    f->glEnableVertexAttribArray(position);
-
-
-    texture = f->glGetAttribLocation(progID, "aTexCoord");
-    f->glVertexAttribPointer(texture, 2, GL_FLOAT, GL_FALSE, stride, (void*)(6 * sizeof(float)));
-    f->glEnableVertexAttribArray(texture);
-
-
-    // dünya texture u ekleniyor
-    QString earthTexFileName = ":/img/earth2048.bmp";
-    earthTexture = loadTexture(earthTexFileName);
-
-    // ay texture u ekleniyor
-    QString moonTexFileName = ":/img/moon1024.bmp";
-    moonTexture = loadTexture(moonTexFileName);
-
-    //merkür
-    QString mercuryTexFileName = ":/img/2k_mercury.jpg";
-    mercuryTexture = loadTexture(mercuryTexFileName);
-
-    //venus
-    QString venusTexFileName = ":/img/2k_venus_surface.jpg";
-    venusTexture = loadTexture(venusTexFileName);
-
-    //mars
-    QString marsTexFileName = ":/img/2k_mars.jpg";
-    marsTexture = loadTexture(marsTexFileName);
-
-    //jupiter
-    QString jupiterTexFileName = ":/img/2k_jupiter.jpg";
-    jupiterTexture = loadTexture(jupiterTexFileName);
-
-    //saturn
-    QString saturnTexFileName = ":/img/saturn.jpg";
-    saturnTexture = loadTexture(saturnTexFileName);
-
-    //uranus
-    QString uranusTexFileName = ":/img/2k_uranus.jpg";
-    uranusTexture = loadTexture(uranusTexFileName);
-
-    //neptune
-    QString neptuneTexFileName = ":/img/2k_neptune.jpg";
-    neptuneTexture = loadTexture(neptuneTexFileName);
-
-    //Plüton
-    QString plutoTextFileName = ":/img/pluto.jpg";
-    plutoTexture = loadTexture(plutoTextFileName);
+    // soğuk açılışta derleme + bağlama, sıcak açılışta yalnızca ikilinin yüklenmesi
+    qDebug() << "Shader cache:" << shaderCache.loadedPrograms() << "of"
+             << shaderCache.loadedPrograms() + shaderCache.compiledPrograms() << "programs loaded from"
+             << ShaderCache::directory() << "- load" << shaderCache.loadNsecs() / 1.0e6 << "ms, compile"
+             << shaderCache.compileNsecs() / 1.0e6 << "ms";
 
+    // instance tamponu tüm küre VAO'larına bağlanır (konum 4-7: MVP matrisi, 8: doku katmanı)
+    instanceData.resize(bodies.size());
+    f->glGenBuffers(1, &instanceVBO);
+    f->glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    f->glBufferData(GL_ARRAY_BUFFER, instanceData.size() * sizeof(BodyInstance), instanceData.data(), GL_STREAM_DRAW);
 
-    //UYDULAR
+    for (const SphereMeshCache::Mesh &mesh : meshes)
+    {
+        if (mesh.vao == 0)
+            continue;
+        ef->glBindVertexArray(mesh.vao);
+        f->glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+        for (GLuint column = 0; column < 4; ++column)
+        {
+            f->glVertexAttribPointer(4 + column, 4, GL_FLOAT, GL_FALSE, sizeof(BodyInstance), (void*)(column * 4 * sizeof(float)));
+            f->glEnableVertexAttribArray(4 + column);
+            ef->glVertexAttribDivisor(4 + column, 1);
+        }
+        f->glVertexAttribPointer(8, 1, GL_FLOAT, GL_FALSE, sizeof(BodyInstance), (void*)offsetof(BodyInstance, layer));
+        f->glEnableVertexAttribArray(8);
+        ef->glVertexAttribDivisor(8, 1);
+    }
+    ef->glBindVertexArray(0);
 
-    // Mars'ın uyduları
-    QString phobosTexFileName = ":/img/phobos.jpg";
-    phobosTexture = loadTexture(phobosTexFileName);
-    phobosSize = createSphere(32, 32, 0.0f, 0.0f, 0.0f);
+    checkGLError(f, "Enabling and Setting Vertex Attributes");
 
-    QString deimosTexFileName = ":/img/deimos.jpg";
-    deimosTexture = loadTexture(deimosTexFileName);
-    deimosSize = createSphere(32, 32, 0.0f, 0.0f, 0.0f);
+    if (!capturePath.isEmpty())
+        startCapture(capturePath, FrameCapture::formatFor(capturePath), captureSize, captureFps);
+}
 
-    // Jüpiter'in uyduları
-    QString ioTexFileName = ":/img/lo.jpg";
-    ioTexture = loadTexture(ioTexFileName);
-    ioSize = createSphere(32, 32, 0.0f, 0.0f, 0.0f);
+void QOpenGLPanel::buildSolarSystem()
+{
+    // LOD kapalıyken güneş ve gezegenler 64x64, uydular 32x32 küreyle çizilir
+    // açısal hızlar adım başına derece cinsinden (varsayılan 60 adım/s)
+    bodies.clear();
+    bodies.reserve(25 + beltBodyCount);
+
+    auto add = [this](int parent, const OrbitalElements &orbit, float spinSpeed, float scaleMultp,
+                      QString fileName, int segments) {
+        const int mesh = SphereLod::levelForSegments(segments);
+        TextureArrayLoader::Slot surface = loadSurface(fileName);
+        return bodies.addBody(parent, orbit, spinSpeed, scaleMultp, surface.texture, surface.layer, mesh);
+    };
+    // yarı büyük eksen, basıklık, eğim, çıkış düğümü, enberi argümanı, M0 (epoch = başlangıç), ortalama hareket
+    auto orbit = [](float a, float e, float i, float node, float periapsis, float meanAnomaly, float meanMotion) {
+        return OrbitalElements{ a, e, i, node, periapsis, meanAnomaly, 0.0f, meanMotion };
+    };
 
-    QString europaTexFileName = ":/img/Europa.jpg";
-    europaTexture = loadTexture(europaTexFileName);
-    europaSize = createSphere(32, 32, 0.0f, 0.0f, 0.0f);
+    // 🌞 Güneş (merkez)
+    int sun = add(-1, orbit(0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f), 0.5f, 5.0f, ":/img/8k_sun.jpg", 64);
+
+    // 🪐 Gezegenler güneşe bağlı; e, i, Ω, ω ve M0 J2000 değerleri, uzaklık ve hızlar sahne ölçeğinde
+    add(sun, orbit(0.39f * 20.0f, 0.2056f, 7.005f, 48.33f, 29.12f, 174.80f, 1.0f), 0.5f, 0.9f, ":/img/2k_mercury.jpg", 64);
+    add(sun, orbit(0.7f + 22.0f, 0.0068f, 3.395f, 76.68f, 54.85f, 50.45f, 0.9f), 0.5f, 1.0f, ":/img/2k_venus_surface.jpg", 64);
+    int earth = add(sun, orbit(25.0f, 0.0167f, 0.0f, 0.0f, 102.94f, 357.53f, 0.8f), 1.3f, 1.0f, ":/img/earth2048.bmp", 64);
+    int mars = add(sun, orbit(35.0f, 0.0934f, 1.850f, 49.56f, 286.48f, 19.41f, 0.5f), 1.0f, 1.0f, ":/img/2k_mars.jpg", 64);
+    int jupiter = add(sun, orbit(48.0f, 0.0484f, 1.303f, 100.47f, 274.25f, 19.67f, 0.4f), 3.0f, 2.5f, ":/img/2k_jupiter.jpg", 64);
+    int saturn = add(sun, orbit(58.0f, 0.0539f, 2.485f, 113.66f, 338.94f, 317.36f, 0.3f), 3.0f, 2.0f, ":/img/saturn.jpg", 64);
+    int uranus = add(sun, orbit(68.0f, 0.0473f, 0.773f, 74.02f, 96.94f, 142.28f, 0.2f), 2.0f, 1.5f, ":/img/2k_uranus.jpg", 64);
+    int neptune = add(sun, orbit(75.0f, 0.0086f, 1.770f, 131.78f, 273.18f, 259.92f, 0.1f), 2.5f, 1.5f, ":/img/2k_neptune.jpg", 64);
+    int pluto = add(sun, orbit(85.0f, 0.2488f, 17.14f, 110.30f, 113.77f, 14.86f, 0.07f), 0.3f, 0.6f, ":/img/pluto.jpg", 64);
+
+    // 🌍 Ay
+    int moon = add(earth, orbit(3.0f, 0.0549f, 5.145f, 0.0f, 0.0f, 0.0f, 1.0f), 0.5f, 0.4f, ":/img/moon1024.bmp", 32);
+
+    // 🔴 Mars'ın uyduları
+    add(mars, orbit(6.0f, 0.0151f, 1.08f, 0.0f, 0.0f, 0.0f, 2.0f), 0.5f, 0.6f, ":/img/phobos.jpg", 32);
+    add(mars, orbit(10.0f, 0.0002f, 1.79f, 0.0f, 0.0f, 0.0f, 1.2f), 0.5f, 0.6f, ":/img/deimos.jpg", 32);
+
+    // 🟠 Jüpiter'in uyduları; Io eskiden Jüpiter'in içindeydi (1.5 < 2.5)
+    add(jupiter, orbit(4.5f, 0.0041f, 0.05f, 0.0f, 0.0f, 0.0f, 2.0f), 0.5f, 0.6f, ":/img/lo.jpg", 32);
+    add(jupiter, orbit(7.5f, 0.0090f, 0.47f, 0.0f, 0.0f, 0.0f, 1.5f), 0.5f, 0.6f, ":/img/Europa.jpg", 32);
+    add(jupiter, orbit(10.0f, 0.0013f, 0.20f, 0.0f, 0.0f, 0.0f, 1.0f), 0.5f, 0.6f, ":/img/Ganymede.jpg", 32);
+    add(jupiter, orbit(12.5f, 0.0074f, 0.19f, 0.0f, 0.0f, 0.0f, 0.7f), 0.5f, 0.6f, ":/img/Callisto.jpg", 32);
+
+    // 🟡 Satürn'ün uyduları
+    add(saturn, orbit(10.0f, 0.0288f, 0.35f, 0.0f, 0.0f, 0.0f, 0.8f), 0.5f, 0.6f, ":/img/Titan.jpg", 32);
+    add(saturn, orbit(8.0f, 0.0047f, 0.02f, 0.0f, 0.0f, 0.0f, 1.5f), 0.5f, 0.6f, ":/img/Enceladus.jpg", 32);
+
+    // 🔵 Uranüs ve Neptün'ün uyduları
+    add(uranus, orbit(5.0f, 0.0013f, 4.23f, 0.0f, 0.0f, 0.0f, 1.5f), 0.5f, 0.6f, ":/img/Miranda.jpg", 32);
+    add(uranus, orbit(8.0f, 0.0011f, 0.34f, 0.0f, 0.0f, 0.0f, 0.9f), 0.5f, 0.6f, ":/img/Titania.jpg", 32);
+    add(neptune, orbit(6.0f, 0.0f, 156.9f, 0.0f, 0.0f, 0.0f, 1.0f), 0.5f, 0.6f, ":/img/triton.jpg", 32);  // eğim > 90: ters yönde döner
+
+    // 🟤 Plüton'un uydusu
+    add(pluto, orbit(6.0f, 0.0002f, 0.08f, 0.0f, 0.0f, 0.0f, 0.6f), 0.5f, 0.6f, ":/img/Charon.jpg", 32);
+
+    // ☄️ Asteroit kuşağı (yük testi için, varsayılan boş); tümü Ay'ın yüzeyini paylaşır
+    if (beltBodyCount > 0)
+    {
+        QRandomGenerator random(2024);
+        for (int i = 0; i < beltBodyCount; ++i)
+        {
+            // düğüm, enberi ve başlangıç anomalisi dağıtılır, yoksa hepsi aynı doğrultuda dizilir
+            // (argümanların değerlendirme sırası belirsiz; sayılar tek tek çekilir)
+            OrbitalElements belt;
+            belt.semiMajorAxis = 38.0f + 8.0f * float(random.generateDouble());
+            belt.eccentricity = 0.2f * float(random.generateDouble());
+            belt.inclination = 10.0f * float(random.generateDouble());
+            belt.ascendingNode = 360.0f * float(random.generateDouble());
+            belt.periapsisArgument = 360.0f * float(random.generateDouble());
+            belt.meanAnomaly = 360.0f * float(random.generateDouble());
+            belt.epoch = 0.0f;
+            belt.meanMotion = 0.2f + 0.4f * float(random.generateDouble());
+            float scaleMultp = 0.05f + 0.15f * float(random.generateDouble());
+            bodies.addBody(sun, belt, 0.5f, scaleMultp, bodies.texture[moon], bodies.textureLayer[moon],
+                           SphereLod::levelForSegments(32));
+        }
+    }
 
-    QString ganymedeTexFileName = ":/img/Ganymede.jpg";
-    ganymedeTexture = loadTexture(ganymedeTexFileName);
-    ganymedeSize = createSphere(32, 32, 0.0f, 0.0f, 0.0f);
+    fixedVertices = 0;
+    for (int i = 0; i < bodies.size(); ++i)
+        fixedVertices += meshes[bodies.mesh[i]].indexCount;
 
-    QString callistoTexFileName = ":/img/Callisto.jpg";
-    callistoTexture = loadTexture(callistoTexFileName);
-    callistoSize = createSphere(32, 32, 0.0f, 0.0f, 0.0f);
+    // dokular arka planda çözülür; gelene kadar cisimler düz renkte çizilir
+    if (textureMode == ArrayTextures)
+    {
+        textureArrays.start(getGLExtraFunctions());
+        qDebug() << "Decoding" << bodies.size() << "surfaces into" << textureArrays.arrayCount() << "texture arrays";
+    }
+}
 
-    // Satürn'ün uyduları
-    QString titanTexFileName = ":/img/Titan.jpg";
-    titanTexture = loadTexture(titanTexFileName);
-    titanSize = createSphere(32, 32, 0.0f, 0.0f, 0.0f);
+void QOpenGLPanel::initNBody()
+{
+    // Kütleler güneş = 1 biriminde. G, Dünya'nın sahnedeki yörüngesi (a = 25, n = 0.8°/adım)
+    // Kepler'in üçüncü yasasına uysun diye seçildi: G = a^3 n^2. Diğer gezegenlerin sahne
+    // hızları bu yasaya uymaz; başlangıç hızları ebeveynin çekiminden yeniden hesaplanır.
+    const float earthRate = qDegreesToRadians(0.8f);
+    const float gravity = 25.0f * 25.0f * 25.0f * earthRate * earthRate;
+    // gezegen ve uydu kütlesi yarıçapın küpüyle; kuşak cisimleri toplamda küçük bir kütle
+    const float massPerVolume = 1.0e-3f;
+    const float beltMass = beltBodyCount > 0 ? 1.0e-4f / float(beltBodyCount) : 0.0f;
+
+    nbody.clear();
+    nbody.reserve(bodies.size());
+    nbody.setGravity(gravity);
+    nbody.setSoftening(0.05f);
+    nbody.setTimeStep(1.0f);
+
+    // ebeveyn önce geldiği için konumu ve hızı zaten dünya koordinatında
+    for (int i = 0; i < bodies.size(); ++i)
+    {
+        const int parent = bodies.parent[i];
+        const bool beltBody = i >= bodies.size() - beltBodyCount;
+        const float mass = parent < 0 ? 1.0f : beltBody ? beltMass
+                         : massPerVolume * bodies.scale[i] * bodies.scale[i] * bodies.scale[i];
 
-    QString enceladusTexFileName = ":/img/Enceladus.jpg";
-    enceladusTexture = loadTexture(enceladusTexFileName);
-    enceladusSize = createSphere(32, 32, 0.0f, 0.0f, 0.0f);
+        QVector3D position, velocity;
+        if (parent >= 0)
+        {
+            bodies.orbitState(i, gravity * nbody.mass[parent], position, velocity);
+            position += QVector3D(nbody.x[parent], nbody.y[parent], nbody.z[parent]);
+            velocity += QVector3D(nbody.vx[parent], nbody.vy[parent], nbody.vz[parent]);
+        }
+        nbody.addBody(position, velocity, mass);
+    }
 
-    // Uranüs ve Neptün'ün uyduları
-    QString mirandaTexFileName = ":/img/Miranda.jpg";
-    mirandaTexture = loadTexture(mirandaTexFileName);
-    mirandaSize = createSphere(32, 32, 0.0f, 0.0f, 0.0f);
+    // Cisimler artık birbirine bağlı değil: görüş hacmi testi her cismi ayrı sınar.
+    // Sahne ölçeğinde çoğu uydu gezegeninin Hill küresinin dışında kalır ve zamanla güneşin
+    // yörüngesine geçer; bu kasıtlı değil, ölçeğin sonucudur.
+    std::fill(bodies.parent.begin(), bodies.parent.end(), -1);
+    nbodyX.resize(nbody.size());
+    nbodyY.resize(nbody.size());
+    nbodyZ.resize(nbody.size());
+    qDebug() << "N-body simulation:" << nbody.size() << "bodies, theta" << nbody.openingAngle();
+}
 
-    QString titaniaTexFileName = ":/img/Titania.jpg";
-    titaniaTexture = loadTexture(titaniaTexFileName);
-    titaniaSize = createSphere(32, 32, 0.0f, 0.0f, 0.0f);
+void QOpenGLPanel::detectCollisionsKepler(BodyStore &store, float userScale)
+{
+    // yörüngeler sabit, tepki verilmez; çizilen son iki konum arasında süpürülür
+    const int count = store.size();
+    collisionRadius.resize(count);
+    sweepEndX.resize(count);
+    sweepEndY.resize(count);
+    sweepEndZ.resize(count);
+    for (int i = 0; i < count; ++i)
+    {
+        const float *model = store.model(i);
+        sweepEndX[i] = model[12];
+        sweepEndY[i] = model[13];
+        sweepEndZ[i] = model[14];
+        collisionRadius[i] = store.scale[i] * userScale;
+    }
+    // ilk sınamada hareket yok sayılır
+    if (int(sweepStartX.size()) != count)
+    {
+        sweepStartX = sweepEndX;
+        sweepStartY = sweepEndY;
+        sweepStartZ = sweepEndZ;
+    }
 
-    QString tritonTexFileName = ":/img/triton.jpg";
-    tritonTexture = loadTexture(tritonTexFileName);
-    tritonSize = createSphere(32, 32, 0.0f, 0.0f, 0.0f);
+    collisions.detect(sweepStartX.data(), sweepStartY.data(), sweepStartZ.data(),
+                      sweepEndX.data(), sweepEndY.data(), sweepEndZ.data(), collisionRadius.data(), count);
+    sweepStartX.swap(sweepEndX);
+    sweepStartY.swap(sweepEndY);
+    sweepStartZ.swap(sweepEndZ);
+    overlapTotal += collisions.overlapCount();
+    logCollisions();
+}
 
-    // Plüton'un uydusu
-    QString charonTexFileName = ":/img/Charon.jpg";
-    charonTexture = loadTexture(charonTexFileName);
-    charonSize = createSphere(32, 32, 0.0f, 0.0f, 0.0f);
+void QOpenGLPanel::detectCollisionsNBody(BodyStore &store, float userScale, CollisionDetector::Response response)
+{
+    // yarıçap birleşmelerde büyür; ölçek cisim tablosuna geri yazılır
+    const int count = nbody.size();
+    collisionRadius.resize(count);
+    for (int i = 0; i < count; ++i)
+        collisionRadius[i] = store.scale[i] * userScale;
+
+    nbody.detectCollisions(collisions, collisionRadius.data());
+    overlapTotal += collisions.overlapCount();
+    const int resolved = nbody.resolveCollisions(collisions.contacts(), response, collisionRadius.data());
+    resolvedTotal += resolved;
+    if (resolved > 0 && response == CollisionDetector::Merge)
+    {
+        for (int i = 0; i < count; ++i)
+            store.scale[i] = collisionRadius[i] / userScale;
+        // iş parçacığı modunda ölçekler bir sonraki anlık görüntüyle çizime geçer
+        ++scaleVersion;
+    }
+    logCollisions();
+}
 
+void QOpenGLPanel::logCollisions()
+{
+    // her 300 sınamada bir özet
+    if (++collisionChecks % 300 != 0)
+        return;
+
+    const CollisionDetector::Contact closest = collisions.closestApproach();
+    if (closest.first >= 0)
+        qDebug() << "Collisions:" << collisions.overlapCount() << "overlapping," << collisions.contacts().size()
+                 << "within" << collisions.margin() << "- closest" << closest.first << closest.second
+                 << "separation" << closest.separation << "- total" << overlapTotal << "overlaps,"
+                 << resolvedTotal << "resolved," << collisions.detectNsecs() / 1.0e6 << "ms";
+    else
+        qDebug() << "Collisions: none - total" << overlapTotal << "overlaps," << resolvedTotal << "resolved,"
+                 << collisions.detectNsecs() / 1.0e6 << "ms";
+}
 
-    moonSize = createSphere(64, 64, 0.0f, 0.0f, 0.0f);
+void QOpenGLPanel::initBeltParticles()
+{
+    if (asteroidParticleCount == 0 && kuiperParticleCount == 0)
+        return;
+    // compute shader 4.3 ister
+    if (!gl43)
+    {
+        qDebug() << "OpenGL 4.3 functions unavailable, belt particles disabled";
+        return;
+    }
 
-    ef->glBindVertexArray(sphereVAO[1]);
-    f->glBindBuffer(GL_ARRAY_BUFFER, vbo[1]);
-    f->glBufferData(GL_ARRAY_BUFFER, vert.size() * sizeof(float), &vert[0], GL_STATIC_DRAW);
+    // yarı büyük eksen, basıklık, eğim, iç kenarda ortalama hareket (derece/adım), yarıçap, renk
+    // asteroitler Mars ile Jüpiter arasında (buildSolarSystem'deki kuşakla aynı aralık)
+    const BeltParticles::Shape asteroids = { 38.0f, 46.0f, 0.2f, 10.0f, 0.5f, 0.03f, 0.12f, QVector3D(0.55f, 0.5f, 0.45f) };
+    // Kuiper kuşağı Plüton'un ötesinde, daha kalın ve yavaş
+    const BeltParticles::Shape kuiper = { 90.0f, 120.0f, 0.15f, 20.0f, 0.06f, 0.05f, 0.15f, QVector3D(0.6f, 0.65f, 0.75f) };
+    particles.addBelt(asteroids, asteroidParticleCount, 2024);
+    particles.addBelt(kuiper, kuiperParticleCount, 1992);
+
+    QElapsedTimer timer;
+    timer.start();
+    if (particles.initialize(getGLExtraFunctions(), shaderCache))
+        qDebug() << "Belt particles:" << particles.size() << "in" << particles.beltCount() << "belts, uploaded in"
+                 << timer.elapsed() << "ms";
+}
 
-    f->glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo[1]);
-    f->glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), &indices[0], GL_STATIC_DRAW);
+void QOpenGLPanel::initEphemeris()
+{
+    ephemerisBodies.clear();
+    if (ephemerisPath.isEmpty())
+        return;
+    if (!ephemeris.open(ephemerisPath))
+    {
+        qDebug() << "Cannot read ephemeris" << ephemerisPath << "- staying on Kepler orbits";
+        return;
+    }
+    if (simulationMode == NBodyMode)
+        qDebug() << "Ephemeris is ignored in N-body mode";
 
+    // konumlar center'a göre; BodyStore ebeveyne göre konumladığı için ikisi aynı olmalı
+    double start = 0.0, end = 0.0;
+    for (int s = 0; s < ephemeris.seriesCount(); ++s)
+    {
+        const int body = ephemeris.target(s);
+        if (body >= bodies.size() || ephemeris.center(s) != bodies.parent[body])
+        {
+            qDebug() << "Ephemeris series for body" << body << "does not match the scene, skipped";
+            continue;
+        }
+        start = ephemerisBodies.empty() ? ephemeris.startTicks(s) : qMin(start, ephemeris.startTicks(s));
+        end = ephemerisBodies.empty() ? ephemeris.endTicks(s) : qMax(end, ephemeris.endTicks(s));
+        ephemerisBodies.push_back(body);
+        // iş parçacığı konumları simulationBodies'e yazar; çizilen kopyanın cull'ı da bilmeli
+        bodies.placedExternally[body] = 1;
+    }
+    qDebug() << "Ephemeris:" << ephemerisBodies.size() << "of" << ephemeris.seriesCount() << "series, ticks"
+             << start << "to" << end;
+}
 
-    position = f->glGetAttribLocation(progID, "position");
-    f->glVertexAttribPointer(position, 3, GL_FLOAT, GL_FALSE, stride, (void*)0);
-    f->glEnableVertexAttribArray(position);
+void QOpenGLPanel::applyEphemeris(BodyStore &store, double time)
+{
+    // kapsam dışındaki cisimler Kepler yörüngesinde kalır
+    placedBodies.clear();
+    placedX.clear();
+    placedY.clear();
+    placedZ.clear();
+    for (int body : ephemerisBodies)
+    {
+        const int series = ephemeris.seriesOf(body);
+        if (!ephemeris.covers(series, time))
+            continue;
+        const QVector3D position = ephemeris.position(series, time);
+        placedBodies.push_back(body);
+        placedX.push_back(position.x());
+        placedY.push_back(position.y());
+        placedZ.push_back(position.z());
+    }
+    store.setRelativePositions(placedBodies.data(), placedX.data(), placedY.data(), placedZ.data(),
+                               int(placedBodies.size()));
+}
 
-    texture = f->glGetAttribLocation(progID, "aTexCoord");
-    f->glVertexAttribPointer(texture, 2, GL_FLOAT, GL_FALSE, stride, (void*)(6 * sizeof(float)));
-    f->glEnableVertexAttribArray(texture);
+TextureArrayLoader::Slot QOpenGLPanel::loadSurface(QString fileName)
+{
+    if (textureMode == ArrayTextures)
+        return textureArrays.add(fileName);
+    return { loadTexture(fileName), 0 };
+}
 
-    // 🌞 Güneş (merkez)
-    sunRotateMatrix.setToIdentity();
-    sunScaleMatrix.setToIdentity();
-    sunScaleMultp = 3.0f; // Güneş büyük kalacak
-
-    // 🌍 Dünya ve Ay
-    // Dünya için yörünge ve kendi ekseni etrafında dönüş matrislerini başlat
-    earthOrbitMatrix.rotate(earthOrbitAngle, 0.0f, 1.0f, 0.0f);
-    earthOrbitMatrix.translate(-2.5f, 0.0f, 0.0f);
-    earthOrbitAngle = 0.8f; // dünya etrafında dönme açısı
-    earthSelfRotateAngle = 0.0f;    // kendi etrafında dönme açısı
-
-    // Ay için yörünge ve kendi ekseni etrafında dönüş matrislerini başlat
-    moonScaleMatrix.setToIdentity();
-    moonOrbitMatrix.rotate(moonOrbitAngle, 0.0f, 1.0f, 0.0f);
-    moonOrbitMatrix.translate(0.4f, 0.0f, 0.0f);  // Dünya'dan uzaklık
-    moonOrbitAngle = 2.0f;
-    moonSelfRotateAngle = 0.0f;
-
-    // 🪐 Merkür
-    // için yörünge ve kendi ekseni etrafında dönüş matrislerini başlat
-    merkurScaleMatrix.setToIdentity();
-    merkurOrbitMatrix.setToIdentity(); // güneş etrafında dönme matriksi
-    merkurSelfRotateMatrix.setToIdentity();  // kendi etrafında dönme matriksi
-    merkurOrbitAngle = 0.0f; // etrafında dönme açısı
-    merkurSelfRotateAngle = 0.0f;    // kendi etrafında dönme açısı
-
-    // 🪐 Venüs
-    // için yörünge ve kendi ekseni etrafında dönüş matrislerini başlat
-    venusScaleMatrix.setToIdentity();
-    venusOrbitMatrix.setToIdentity(); // güneş etrafında dönme matriksi
-    venusSelfRotateMatrix.setToIdentity();  // kendi etrafında dönme matriksi
-    venusOrbitAngle = 0.0f; // etrafında dönme açısı
-    venusSelfRotateAngle = 0.0f;    // kendi etrafında dönme açısı
-
-    // 🔴 Mars ve Uyduları
-    // için yörünge ve kendi ekseni etrafında dönüş matrislerini başlat
-    marsScaleMatrix.setToIdentity();
-    marsOrbitMatrix.setToIdentity();
-    marsSelfRotateMatrix.setToIdentity();
-    marsOrbitAngle = 0.0f;
-    marsSelfRotateAngle = 0.0f;
-
-    // Phobos ve Deimos Mars'a bağlı olacak
-    phobosScaleMatrix.setToIdentity();
-    phobosOrbitMatrix.setToIdentity();
-    phobosSelfRotateMatrix.setToIdentity();
-    phobosOrbitAngle = 0.0f;
-    phobosSelfRotateAngle = 0.0f;
-
-    deimosScaleMatrix.setToIdentity();
-    deimosOrbitMatrix.setToIdentity();
-    deimosSelfRotateMatrix.setToIdentity();
-    deimosOrbitAngle = 0.0f;
-    deimosSelfRotateAngle = 0.0f;
-
-    // 🟠 Jüpiter ve Uyduları
-    //jupiter
-    // için yörünge ve kendi ekseni etrafında dönüş matrislerini başlat
-    jupiterScaleMatrix.setToIdentity();
-    jupiterOrbitMatrix.setToIdentity(); // güneş etrafında dönme matriksi
-    jupiterSelfRotateMatrix.setToIdentity();  // kendi etrafında dönme matriksi
-    jupiterOrbitAngle = 0.0f; // etrafında dönme açısı
-    jupiterSelfRotateAngle = 0.0f;    // kendi etrafında dönme açısı
-
-    ioScaleMatrix.setToIdentity();
-    ioOrbitMatrix.setToIdentity();
-    ioSelfRotateMatrix.setToIdentity();
-    ioOrbitAngle = 0.0f;
-    ioSelfRotateAngle = 0.0f;
-
-    europaScaleMatrix.setToIdentity();
-    europaOrbitMatrix.setToIdentity();
-    europaSelfRotateMatrix.setToIdentity();
-    europaOrbitAngle = 0.0f;
-    europaSelfRotateAngle = 0.0f;
-
-    ganymedeScaleMatrix.setToIdentity();
-    ganymedeOrbitMatrix.setToIdentity();
-    ganymedeSelfRotateMatrix.setToIdentity();
-    ganymedeOrbitAngle = 0.0f;
-    ganymedeSelfRotateAngle = 0.0f;
-
-    callistoScaleMatrix.setToIdentity();
-    callistoOrbitMatrix.setToIdentity();
-    callistoSelfRotateMatrix.setToIdentity();
-    callistoOrbitAngle = 0.0f;
-    callistoSelfRotateAngle = 0.0f;
-
-    // 🟡 Satürn ve Uyduları
-    //satürn
-    // için yörünge ve kendi ekseni etrafında dönüş matrislerini başlat
-    saturnScaleMatrix.setToIdentity();
-    saturnOrbitMatrix.setToIdentity(); // güneş etrafında dönme matriksi
-    saturnSelfRotateMatrix.setToIdentity();  // kendi etrafında dönme matriksi
-    saturnOrbitAngle = 0.0f; // etrafında dönme açısı
-    saturnSelfRotateAngle = 0.0f;    // kendi etrafında dönme açısı
-
-    titanScaleMatrix.setToIdentity();
-    titanOrbitMatrix.setToIdentity();
-    titanSelfRotateMatrix.setToIdentity();
-    titanOrbitAngle = 0.0f;
-    titanSelfRotateAngle = 0.0f;
-
-    enceladusScaleMatrix.setToIdentity();
-    enceladusOrbitMatrix.setToIdentity();
-    enceladusSelfRotateMatrix.setToIdentity();
-    enceladusOrbitAngle = 0.0f;
-    enceladusSelfRotateAngle = 0.0f;
-
-    // 🔵 Uranüs
-    //uranus
-    // için yörünge ve kendi ekseni etrafında dönüş matrislerini başlat
-    uranusScaleMatrix.setToIdentity();
-    uranusOrbitMatrix.setToIdentity(); // güneş etrafında dönme matriksi
-    uranusSelfRotateMatrix.setToIdentity();  // kendi etrafında dönme matriksi
-    uranusOrbitAngle = 0.0f; // etrafında dönme açısı
-    uranusSelfRotateAngle = 0.0f;    // kendi etrafında dönme açısı
-
-    // 🔵 Neptün
-    //neptune
-    // için yörünge ve kendi ekseni etrafında dönüş matrislerini başlat
-    neptuneScaleMatrix.setToIdentity();
-    neptuneOrbitMatrix.setToIdentity(); // güneş etrafında dönme matriksi
-    neptuneSelfRotateMatrix.setToIdentity();  // kendi etrafında dönme matriksi
-    neptuneOrbitAngle = 0.0f; // etrafında dönme açısı
-    neptuneSelfRotateAngle = 0.0f;    // kendi etrafında dönme açısı
-
-    // 🟤 Plüton ve Uydusu (Charon)
-    //Plüton
-    plutoScaleMatrix.setToIdentity();
-    plutoOrbitMatrix.setToIdentity();
-    plutoSelfRotateMatrix.setToIdentity();
-    plutoOrbitAngle = 0.0f;
-    plutoSelfRotateAngle = 0.0f;
-
-    charonScaleMatrix.setToIdentity();
-    charonOrbitMatrix.setToIdentity();
-    charonSelfRotateMatrix.setToIdentity();
-    charonOrbitAngle = 0.0f;
-    charonSelfRotateAngle = 0.0f;
+void QOpenGLPanel::finishTextureLoading()
+{
+    FrameProfiler::CpuZone zone(profiler, "Texture load");
+    if (textureMode == ArrayTextures)
+        textureArrays.finish(getGLExtraFunctions());
+}
 
+float QOpenGLPanel::surfaceLayer(int body) const
+{
+    // -1: doku henüz yüklenmedi, shader düz renk kullanır
+    if (!textureArrays.isReady(bodies.texture[body], bodies.textureLayer[body]))
+        return -1.0f;
+    return float(bodies.textureLayer[body]);
+}
 
-    checkGLError(f, "Enabling and Setting Vertex Attributes");
+void QOpenGLPanel::logStartupTimes()
+{
+    if (!firstFrameLogged)
+    {
+        qDebug() << "Time to first frame:" << startupTimer.elapsed() << "ms";
+        firstFrameLogged = true;
+    }
+    if (!fullyTexturedLogged && textureArrays.isComplete())
+    {
+        qDebug() << "Time to fully textured:" << startupTimer.elapsed() << "ms";
+        fullyTexturedLogged = true;
+    }
 }
 
 void QOpenGLPanel::translate(float x, float y, float z)
@@ -584,483 +867,411 @@ void QOpenGLPanel::perspective( float angle,  float ratio,  float nearp,  float
 
 void QOpenGLPanel::paintGL()
 {
+    frameTimer.start();
+    profiler.beginFrame();
+
     QOpenGLFunctions *f = getGLFunctions();
     QOpenGLExtraFunctions *ef = getGLExtraFunctions();
-    f->glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-    f->glUseProgram(progID);
-
-    f->glUniformMatrix4fv(translateMatrixID,1,GL_FALSE,translateMatrix.constData());
-    f->glUniformMatrix4fv(scaleMatrixID,1,GL_FALSE,scaleMatrix.constData());
-    f->glUniformMatrix4fv(cameraMatrixID,1,GL_FALSE,cameraMatrix.constData());
-    f->glUniformMatrix4fv(projectionMatrixID,1,GL_FALSE,projectionMatrix.constData());
 
+    // kayıtta sahne kayıt FBO'suna çizilir; hedef (pencere ya da çağıranın FBO'su) sonra geri bağlanır
+    GLint targetFramebuffer = 0;
+    GLint targetViewport[4] = { 0, 0, 0, 0 };
+    if (capture.isActive())
     {
-        // Güneş işlemleri
-
-        sunScaleMatrix.setToIdentity();
-        sunScaleMultp = 5.0f;
-        sunScaleMatrix.scale(sunScaleMultp, sunScaleMultp, sunScaleMultp);
-
-        sunSelfRotateAngle += 0.5f;
-        sunRotateMatrix.setToIdentity();
-        sunRotateMatrix.rotate(sunSelfRotateAngle, 0.0f, 1.0f, 0.0f); // Yörüngede Y ekseninde döndür
-
-        QMatrix4x4 sunModelMatrix = sunRotateMatrix * rotateMatrix;
-        f->glUniformMatrix4fv(rotateMatrixID, 1, GL_FALSE, sunModelMatrix.constData());
-
-        // güneş çizimi
-        f->glUniformMatrix4fv(scaleMatrixID,1,GL_FALSE,sunScaleMatrix.constData());
-
-        // güneş texture u etkinleştiriliyor
-        f->glBindTexture(GL_TEXTURE_2D, sunTexture);
-
-        ef->glBindVertexArray(sphereVAO[0]);
-        f->glDrawElements(GL_TRIANGLE_STRIP, sunSize, GL_UNSIGNED_INT, 0);
+        f->glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &targetFramebuffer);
+        f->glGetIntegerv(GL_VIEWPORT, targetViewport);
+        capture.bind(ef);
     }
+    f->glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
+    // çözülmüş dokulardan kare başına en fazla ikisini yükle
+    if (!textureArrays.isComplete())
     {
-        // Merkür işlemleri
-
-        merkurScaleMatrix.setToIdentity();
-        float MerkurScaleMulp = 0.9f;
-        merkurScaleMatrix.scale(MerkurScaleMulp, MerkurScaleMulp, MerkurScaleMulp);
-
-
-
-        // için dönüş açılarını günceller
-        merkurOrbitAngle += 1.0f; // Güneş etrafında yörünge hareketi
-        merkurSelfRotateAngle += 0.5f; //kendi ekseni etrafında dönüşü
-
-
-        //yörünge matrisini günceller
-        merkurOrbitMatrix.setToIdentity();
-        merkurOrbitMatrix.rotate(merkurOrbitAngle, 0.0f, 5.0f, 0.0f); // Yörüngede Y ekseninde döndür
-        merkurOrbitMatrix.translate(0.39f * 20.0f, 0.0f, 0.0f);
-
-        // kendi ekseni etrafında dönüş matrisini günceller
-        merkurSelfRotateMatrix.setToIdentity();
-        merkurSelfRotateMatrix.rotate(merkurSelfRotateAngle, 0.0f, 1.0f, 0.0f); // Kendi etrafında Y ekseninde döndür
-
-
-        // model matrisini oluşturuluyor ve çiziliyor
-        QMatrix4x4 merkurModelMatrix = merkurOrbitMatrix * merkurSelfRotateMatrix * rotateMatrix;
-        f->glUniformMatrix4fv(scaleMatrixID,1,GL_FALSE,merkurScaleMatrix.constData());
-        f->glUniformMatrix4fv(rotateMatrixID, 1, GL_FALSE, merkurModelMatrix.constData());
-
-
-        // texture u etkinleştiriliyor
-        f->glBindTexture(GL_TEXTURE_2D, mercuryTexture);
-
-        ef->glBindVertexArray(sphereVAO[0]);
-        f->glDrawElements(GL_TRIANGLE_STRIP, sunSize, GL_UNSIGNED_INT, 0);
+        FrameProfiler::CpuZone zone(profiler, "Texture upload");
+        textureArrays.uploadPending(ef, 2);
     }
 
+    // geçen gerçek süreye düşen adımlar ve karenin simülasyon zamanı
+    const int ticks = simulationClock.advance();
+    const SimulationThread::Request request = simulationRequest(ticks, simulationClock.alpha());
+    sweepReset = false;
+    if (simulationThread.isRunning())
     {
-        // Venus işlemleri
-        venusScaleMatrix.setToIdentity();
-        float venusScaleMulp = 1.0f;
-        venusScaleMatrix.scale(venusScaleMulp, venusScaleMulp, venusScaleMulp);
-
-        // için dönüş açılarını günceller
-        venusOrbitAngle += 0.9f; // Güneş etrafında yörünge hareketi
-        venusSelfRotateAngle += 0.8f; //kendi ekseni etrafında dönüşü
-
-
-        // yörünge matrisini günceller
-        venusOrbitMatrix.setToIdentity();
-        venusOrbitMatrix.rotate(venusOrbitAngle, 0.0f, 1.0f, 0.0f); // Yörüngede Y ekseninde döndür
-        venusOrbitMatrix.translate(0.7f + 22.0f, 0.0f, 0.0f);
-
-        // kendi ekseni etrafında dönüş matrisini günceller
-        venusSelfRotateMatrix.setToIdentity();
-        venusSelfRotateMatrix.rotate(merkurSelfRotateAngle, 0.0f, 1.0f, 0.0f); // Kendi etrafında Y ekseninde döndür
-
-
-        // model matrisini oluşturuluyor ve çiziliyor
-        QMatrix4x4 venusModelMatrix = venusOrbitMatrix * venusSelfRotateMatrix * rotateMatrix;
-        f->glUniformMatrix4fv(scaleMatrixID,1,GL_FALSE,venusScaleMatrix.constData());
-        f->glUniformMatrix4fv(rotateMatrixID, 1, GL_FALSE, venusModelMatrix.constData());
-
-        // texture u etkinleştiriliyor
-        f->glBindTexture(GL_TEXTURE_2D, venusTexture);
-
-        ef->glBindVertexArray(sphereVAO[0]);
-        f->glDrawElements(GL_TRIANGLE_STRIP, sunSize, GL_UNSIGNED_INT, 0);
+        // beklenmez: iş parçacığı bu isteği işlerken son tamamlanan durum çizilir
+        FrameProfiler::CpuZone zone(profiler, "Simulation sync");
+        simulationThread.request(request);
+        if (simulationThread.acquire())
+            applySnapshot(simulationThread.snapshot());
     }
-
-
+    else
     {
-        // Dünya işlemleri
-        earthScaleMatrix.setToIdentity();
-        float earthScaleMulp = 1.0f;
-        earthScaleMatrix.scale(earthScaleMulp, earthScaleMulp, earthScaleMulp);
-
-        // Dünya için dönüş açılarını günceller
-        earthOrbitAngle += 0.8f; // Dünya'nın Güneş etrafında yörünge hareketi
-        earthSelfRotateAngle += 1.3f; // Dünya'nın kendi ekseni etrafında dönüşü
-
-
-        // Dünya'nın yörünge matrisini günceller
-        earthOrbitMatrix.setToIdentity();
-        earthOrbitMatrix.rotate(earthOrbitAngle, 0.0f, 1.0f, 0.0f); // Yörüngede Y ekseninde döndür
-        earthOrbitMatrix.translate(-1.0f * 25.0f, 0.0f);
-
-        // Dünya'nın kendi ekseni etrafında dönüş matrisini günceller
-        earthSelfRotateMatrix.setToIdentity();
-        earthSelfRotateMatrix.rotate(earthSelfRotateAngle, 0.0f, 1.0f, 0.0f); // Kendi etrafında Y ekseninde döndür
-
-
-        // Dünya'nın model matrisini oluşturuluyor ve çiziliyor
-        QMatrix4x4 earthModelMatrix = earthOrbitMatrix * earthSelfRotateMatrix * rotateMatrix;
-        f->glUniformMatrix4fv(scaleMatrixID,1,GL_FALSE,earthScaleMatrix.constData());
-        f->glUniformMatrix4fv(rotateMatrixID, 1, GL_FALSE, earthModelMatrix.constData());
-
-        // dünya texture u etkinleştiriliyor
-        f->glBindTexture(GL_TEXTURE_2D, earthTexture);
-
-        ef->glBindVertexArray(sphereVAO[0]);
-        f->glDrawElements(GL_TRIANGLE_STRIP, sunSize, GL_UNSIGNED_INT, 0);
+        const qint64 stepStarted = profiler.now();
+        stepSimulation(bodies, request);
+        stateTime = request.time;
+        simulationStepNsecs = profiler.now() - stepStarted;
+        profiler.addZone("Simulation step", FrameProfiler::MainTrack, stepStarted, stepStarted + simulationStepNsecs);
     }
 
-
+    // parçacıklar GPU'da cisimlerle aynı zamandan hesaplanır; CPU yalnızca zamanı verir
     {
-        // Ay işlemleri
-        moonScaleMatrix.setToIdentity();
-        float moonScaleMulp = 0.4f;
-        moonScaleMatrix.scale(moonScaleMulp, moonScaleMulp, moonScaleMulp);
-
-        // Ay için dönüş açılarını güncelleniyor
-        moonOrbitAngle += 1.0f; // Ay'ın Dünya etrafında yörünge hareketi
-        moonSelfRotateAngle += 0.5f; // Ay'ın kendi ekseni etrafında dönüşü
-
-        // Ay'ın yörünge matrisini güncelleniyor
-        moonOrbitMatrix.setToIdentity();
-        moonOrbitMatrix.rotate(moonOrbitAngle, 0.0f, 1.0f, 0.0f); // Y ekseninde döndür
-        moonOrbitMatrix.translate(3.0f, 0.0f, 0.0f);
-
-        // Ay'ın kendi ekseni etrafında dönüş matrisini güncelleniyor
-        moonSelfRotateMatrix.setToIdentity();
-        moonSelfRotateMatrix.rotate(moonSelfRotateAngle, 0.0f, 1.0f, 0.0f); // Y ekseninde döndür
-
-
-        // Dünya'nın model matrisini oluşturuluyor ve çiziliyoe
-        QMatrix4x4 moonMatrix = earthOrbitMatrix * moonOrbitMatrix * moonSelfRotateMatrix * rotateMatrix;
-        f->glUniformMatrix4fv(rotateMatrixID, 1, GL_FALSE, moonMatrix.constData());
-        f->glUniformMatrix4fv(scaleMatrixID,1,GL_FALSE,moonScaleMatrix.constData());
+        FrameProfiler::GpuZone gpuZone(profiler, "Belt update (GPU)");
+        particles.update(ef, stateTime);
+    }
 
-        // ay texture u etkinleştiriliyor
-        f->glBindTexture(GL_TEXTURE_2D, moonTexture);
+    // kamera kare başına tek tampon yüklemesi; çizim yolları ve kuşaklar buradan okur
+    const float pixelScale = 0.5f * framebufferHeight() * projectionMatrix(1, 1);
+    frameUniforms.update(ef, cameraMatrix * translateMatrix, projectionMatrix, pixelScale);
 
-        ef->glBindVertexArray(sphereVAO[1]);
-        f->glDrawElements(GL_TRIANGLE_STRIP, moonSize, GL_UNSIGNED_INT, 0);
+    // gezegen + uydu sistemleri görüş hacmine karşı test edilir; dışarıdaki alt ağaçlar atlanır
+    {
+        FrameProfiler::CpuZone zone(profiler, "Culling");
+        if (frustumCulling)
+            drawnBodyCount = bodies.cull(Frustum(frameUniforms.viewProjection()), geometryScale());
+        else
+            drawnBodyCount = bodies.size();
     }
 
+    if (levelOfDetail)
     {
-        // Mars işlemleri
-
-        marsScaleMatrix.setToIdentity();
-        float marsScaleMulp = 1.0f;
-        marsScaleMatrix.scale(marsScaleMulp, marsScaleMulp, marsScaleMulp);
-
-        // için dönüş açılarını günceller
-        marsOrbitAngle += 0.5f; // Güneş etrafında yörünge hareketi
-        marsSelfRotateAngle += 1.0f; //kendi ekseni etrafında dönüşü
-
-
-        // yörünge matrisini günceller
-        marsOrbitMatrix.setToIdentity();
-        marsOrbitMatrix.rotate(marsOrbitAngle, 0.0f, 1.0f, 0.0f); // Yörüngede Y ekseninde döndür
-        marsOrbitMatrix.translate(-1.0f * 35.0f, 0.0f, 0.0f);
-
-        // kendi ekseni etrafında dönüş matrisini günceller
-        marsSelfRotateMatrix.setToIdentity();
-        marsSelfRotateMatrix.rotate(marsSelfRotateAngle, 0.0f, 1.0f, 0.0f); // Kendi etrafında Y ekseninde döndür
-
-
-        // model matrisini oluşturuluyor ve çiziliyor
-        QMatrix4x4 marsModelMatrix = marsOrbitMatrix * marsSelfRotateMatrix * rotateMatrix;
-        f->glUniformMatrix4fv(scaleMatrixID,1,GL_FALSE,marsScaleMatrix.constData());
-        f->glUniformMatrix4fv(rotateMatrixID, 1, GL_FALSE, marsModelMatrix.constData());
-
-        // texture u etkinleştiriliyor
-        f->glBindTexture(GL_TEXTURE_2D, marsTexture);
-
-        ef->glBindVertexArray(sphereVAO[0]);
-        f->glDrawElements(GL_TRIANGLE_STRIP, sunSize, GL_UNSIGNED_INT, 0);
+        FrameProfiler::CpuZone zone(profiler, "LOD selection");
+        selectLevelsOfDetail();
     }
-
-
-
-
+    else
     {
-        // jupiter işlemleri
-
-        jupiterScaleMatrix.setToIdentity();
-        float jupiteScaleMulp = 2.5f;
-        jupiterScaleMatrix.scale(jupiteScaleMulp, jupiteScaleMulp, jupiteScaleMulp);
-
-        // dönüş açılarını günceller
-        jupiterOrbitAngle += 0.4f;
-        jupiterSelfRotateAngle += 3.0f;
-
-
-        // yörünge matrisini günceller
-        jupiterOrbitMatrix.setToIdentity();
-        jupiterOrbitMatrix.rotate(jupiterOrbitAngle, 0.0f, 1.0f, 0.0f); // Yörüngede Y ekseninde döndür
-        jupiterOrbitMatrix.translate(1.0f * 48.0f, 0.0f, 0.0f);
-
-        // jupiter'in kendi ekseni etrafında dönüş matrisini günceller
-        jupiterSelfRotateMatrix.setToIdentity();
-        jupiterSelfRotateMatrix.rotate(jupiterSelfRotateAngle, 0.0f, 1.0f, 0.0f); // Kendi etrafında Y ekseninde döndür
-
-
-        //  model matrisini oluşturuluyor ve çiziliyor
-        QMatrix4x4 jupiterModelMatrix = jupiterOrbitMatrix * jupiterSelfRotateMatrix * rotateMatrix;
-        f->glUniformMatrix4fv(scaleMatrixID,1,GL_FALSE,jupiterScaleMatrix.constData());
-        f->glUniformMatrix4fv(rotateMatrixID, 1, GL_FALSE, jupiterModelMatrix.constData());
-
-        //  texture u etkinleştiriliyor
-        f->glBindTexture(GL_TEXTURE_2D, jupiterTexture);
-
-        ef->glBindVertexArray(sphereVAO[0]);
-        f->glDrawElements(GL_TRIANGLE_STRIP, sunSize, GL_UNSIGNED_INT, 0);
+        lodVertices = fixedVertices;
     }
 
+    // doku yükleme ve kuşak parçacıkları önbelleğin dışında bağlar; her karede sıfırdan
+    glState.invalidate();
+    glState.resetCounters();
     {
-        // saturn işlemleri
-
-        saturnScaleMatrix.setToIdentity();
-        float saturnScaleMulp = 2.0f;
-        saturnScaleMatrix.scale(saturnScaleMulp, saturnScaleMulp, saturnScaleMulp);
-
-        //  için dönüş açılarını günceller
-        saturnOrbitAngle += 0.3f; //  Güneş etrafında yörünge hareketi
-        saturnSelfRotateAngle += 2.7f; //  kendi ekseni etrafında dönüşü
-
-
-        // yörünge matrisini günceller
-        saturnOrbitMatrix.setToIdentity();
-        saturnOrbitMatrix.rotate(saturnOrbitAngle, 0.0f, 1.0f, 0.0f); // Yörüngede Y ekseninde döndür
-        saturnOrbitMatrix.translate(-1.0f * 58.0f, 0.0f, 0.0f);
-
-        //  kendi ekseni etrafında dönüş matrisini günceller
-        saturnSelfRotateMatrix.setToIdentity();
-        saturnSelfRotateMatrix.rotate(jupiterSelfRotateAngle, 0.0f, 1.0f, 0.0f); // Kendi etrafında Y ekseninde döndür
-
-
-        // model matrisini oluşturuluyor ve çiziliyor
-        QMatrix4x4 saturnModelMatrix = saturnOrbitMatrix * saturnSelfRotateMatrix * rotateMatrix;
-        f->glUniformMatrix4fv(scaleMatrixID,1,GL_FALSE,saturnScaleMatrix.constData());
-        f->glUniformMatrix4fv(rotateMatrixID, 1, GL_FALSE, saturnModelMatrix.constData());
+        FrameProfiler::CpuZone zone(profiler, "Draw submission");
+        {
+            FrameProfiler::GpuZone gpuZone(profiler, "Bodies (GPU)");
+            switch (activeRenderPath())
+            {
+            case ProceduralPath:
+                drawBodiesProcedural(f, ef);
+                break;
+            case InstancedPath:
+                drawBodiesInstanced(f, ef);
+                break;
+            case PerBodyPath:
+                drawBodiesPerBody(f, ef);
+                break;
+            }
+        }
+        // kuşaklar güneşin çevresinde; N-body modunda güneş de hareket eder
+        if (particles.isReady())
+        {
+            FrameProfiler::GpuZone gpuZone(profiler, "Belt draw (GPU)");
+            particles.draw(ef, frameUniforms, bodies.position(0), geometryScale());
+        }
+    }
 
-        // texture u etkinleştiriliyor
-        f->glBindTexture(GL_TEXTURE_2D, saturnTexture);
+    // okuma PBO halkasına sıralanır, beklenmez; önizleme hedefe ölçeklenerek kopyalanır
+    if (capture.isActive())
+    {
+        FrameProfiler::CpuZone zone(profiler, "Frame capture");
+        capture.capture(ef);
+        if (capturePreview)
+        {
+            capture.present(ef, GLuint(targetFramebuffer), QSize(targetViewport[2], targetViewport[3]));
+        }
+        else
+        {
+            ef->glBindFramebuffer(GL_FRAMEBUFFER, GLuint(targetFramebuffer));
+            f->glViewport(targetViewport[0], targetViewport[1], targetViewport[2], targetViewport[3]);
+        }
+    }
 
-        ef->glBindVertexArray(sphereVAO[0]);
-        f->glDrawElements(GL_TRIANGLE_STRIP, sunSize, GL_UNSIGNED_INT, 0);
+    // QPainter kendi GL durumunu kurar; derinlik testi ve karışım (blend) geri alınır
+    if (profilerOverlay && profiler.isEnabled() && isVisible())
+    {
+        FrameProfiler::CpuZone zone(profiler, "Profiler overlay");
+        QPainter painter(this);
+        profiler.drawOverlay(painter, QRect(8, 8, qMin(width() - 16, 480), qMin(height() - 16, 260)));
+        painter.end();
+        f->glDisable(GL_BLEND);
+        f->glEnable(GL_DEPTH_TEST);
     }
 
+    profiler.endFrame();
+    logFrameTime(frameTimer.nsecsElapsed());
+    if (!fullyTexturedLogged)
+        logStartupTimes();
+}
 
+void QOpenGLPanel::stepSimulation(BodyStore &store, const SimulationThread::Request &request)
+{
+    // atlama bir hareket değildir; çarpışma süpürmesi yeni konumlardan başlar
+    if (request.resetSweep)
+        sweepStartX.clear();
+
+    // açılar zamandan doğrudan hesaplanır, böylece ara değerleme gerekmez ve hız ne olursa
+    // olsun iş cisim başına sabittir
+    store.setTime(request.time);
+    if (request.nbody)
     {
-        // uranus işlemleri
-        uranusScaleMatrix.setToIdentity();
-        float uranusScaleMulp = 1.5f;
-        uranusScaleMatrix.scale(uranusScaleMulp, uranusScaleMulp, uranusScaleMulp);
-
-        //  için dönüş açılarını günceller
-        uranusOrbitAngle += 0.2f; //  Güneş etrafında yörünge hareketi
-        uranusSelfRotateAngle += 2.0f; //  kendi ekseni etrafında dönüşü
+        // her adımda ağaç yeniden kurulur; BodyStore yalnızca dönüş açılarını verir
+        for (int tick = 0; tick < request.ticks; ++tick)
+        {
+            nbody.step();
+            if (request.detectCollisions)
+                detectCollisionsNBody(store, request.bodyScale, request.collisionResponse);
+        }
+        nbody.interpolate(request.alpha, nbodyX.data(), nbodyY.data(), nbodyZ.data());
+        store.placeBodies(nbodyX.data(), nbodyY.data(), nbodyZ.data());
+    }
+    else
+    {
+        store.updateMatrices();
+        if (!ephemerisBodies.empty())
+            applyEphemeris(store, request.time);
+        if (request.detectCollisions && request.ticks != 0)
+            detectCollisionsKepler(store, request.bodyScale);
+    }
+}
 
+SimulationThread::Request QOpenGLPanel::simulationRequest(int ticks, float alpha) const
+{
+    return { simulationClock.time(), ticks, alpha, geometryScale(), sweepReset,
+             simulationMode == NBodyMode, collisionDetection, collisionResponse };
+}
 
-        // yörünge matrisini günceller
-        uranusOrbitMatrix.setToIdentity();
-        uranusOrbitMatrix.rotate(uranusOrbitAngle, 0.0f, 1.0f, 0.0f); // Yörüngede Y ekseninde döndür
-        uranusOrbitMatrix.translate(1.0f * 68.0f, 0.0f, 0.0f);
+void QOpenGLPanel::startSimulationThread()
+{
+    // iş parçacığı kendi cisim tablosu kopyasını ilerletir; çizim tablosuna (bodies) yalnızca
+    // anlık görüntülerdeki matrisler ve ölçekler geçer, cull ve LOD çizim tarafında kalır
+    simulationBodies = bodies;
+    simulationThread.start([this](const SimulationThread::Request &request, SimulationThread::Snapshot &snapshot) {
+        snapshot.stepStarted = profiler.now();
+        stepSimulation(simulationBodies, request);
+        snapshot.models.assign(simulationBodies.modelData.begin(), simulationBodies.modelData.end());
+        if (snapshot.scaleVersion != scaleVersion)
+        {
+            snapshot.scale = simulationBodies.scale;
+            snapshot.scaleVersion = scaleVersion;
+        }
+    });
 
-        //  kendi ekseni etrafında dönüş matrisini günceller
-        uranusSelfRotateMatrix.setToIdentity();
-        uranusSelfRotateMatrix.rotate(uranusSelfRotateAngle, 0.0f, 1.0f, 0.0f); // Kendi etrafında Y ekseninde döndür
+    // ilk kare boş çizilmesin
+    simulationThread.request(simulationRequest(0, 1.0f));
+    simulationThread.waitForSnapshot();
+    applySnapshot(simulationThread.snapshot());
+    qDebug() << "Simulation thread started," << bodies.size() << "bodies";
+}
 
+void QOpenGLPanel::applySnapshot(SimulationThread::Snapshot &snapshot)
+{
+    // yuva bir sonraki acquire'a kadar yalnızca bizim; kopyalamak yerine tamponlar değiş tokuş
+    // edilir, eski matrisler yazara boş yuva olarak döner
+    bodies.modelData.swap(snapshot.models);
+    if (snapshot.scaleVersion != appliedScaleVersion)
+    {
+        bodies.scale = snapshot.scale;
+        appliedScaleVersion = snapshot.scaleVersion;
+    }
+    stateTime = snapshot.time;
+    simulationStepNsecs = snapshot.stepNsecs;
+    // iş parçacığı kayıt yapmaz; adım çizime alındığında kendi izine yazılır
+    profiler.addZone("Simulation step", FrameProfiler::SimulationTrack, snapshot.stepStarted,
+                     snapshot.stepStarted + snapshot.stepNsecs);
+}
 
-        // model matrisini oluşturuluyor ve çiziliyor
-        QMatrix4x4 uranusModelMatrix = uranusOrbitMatrix * uranusSelfRotateMatrix * rotateMatrix;
-        f->glUniformMatrix4fv(scaleMatrixID,1,GL_FALSE,uranusScaleMatrix.constData());
-        f->glUniformMatrix4fv(rotateMatrixID, 1, GL_FALSE, uranusModelMatrix.constData());
+void QOpenGLPanel::finishSimulation()
+{
+    simulationThread.stop();
+}
 
-        // texture u etkinleştiriliyor
-        f->glBindTexture(GL_TEXTURE_2D, uranusTexture);
+void QOpenGLPanel::drawBodiesPerBody(QOpenGLFunctions *f, QOpenGLExtraFunctions *ef)
+{
+    // instanced yolla aynı tampon; cisim başına yalnızca tampondaki sırası gönderilir
+    prepareInstances(f, ef, progID);
 
-        ef->glBindVertexArray(sphereVAO[0]);
-        f->glDrawElements(GL_TRIANGLE_STRIP, sunSize, GL_UNSIGNED_INT, 0);
+    // her cisim tüm durumunu ister; sıralı kuyrukta art arda gelen aynı VAO ve doku
+    // bağlamaları önbellekte kalır
+    for (int k = 0; k < renderQueue.size(); ++k)
+    {
+        const quint64 key = renderQueue[k].key;
+        const SphereMeshCache::Mesh &mesh = meshes[renderQueue.mesh(key)];
+        glState.useProgram(ef, renderQueue.program(key));
+        glState.bindTexture(ef, textureTarget, renderQueue.texture(key));
+        glState.bindVertexArray(ef, mesh.vao);
+        glState.uniform1i(ef, instanceIndexID, k);
+        f->glDrawElements(GL_TRIANGLE_STRIP, mesh.indexCount, GL_UNSIGNED_INT, 0);
+        glState.countDraw();
     }
+}
 
-
+void QOpenGLPanel::prepareInstances(QOpenGLFunctions *f, QOpenGLExtraFunctions *ef, GLuint program)
+{
+    // görünen cisimler (program, mesh, doku, derinlik) anahtarıyla sıralanır; aynı durumdaki
+    // ardışık cisimler bir grup olur ve grup içinde yakından uzağa çizilir
+    const float *view = frameUniforms.view().constData();
+    renderQueue.setDepthRange(nearPlane, farPlane);
+    renderQueue.clear();
+    for (int i = 0; i < bodies.size(); ++i)
     {
-        // neptune işlemleri
-        neptuneScaleMatrix.setToIdentity();
-        float neptuneScaleMulp = 1.5f;
-        neptuneScaleMatrix.scale(neptuneScaleMulp, neptuneScaleMulp, neptuneScaleMulp);
-
-        //  için dönüş açılarını günceller
-        neptuneOrbitAngle += 0.1f; //  Güneş etrafında yörünge hareketi
-        neptuneSelfRotateAngle += 2.5f; //  kendi ekseni etrafında dönüşü
+        if (!bodies.visible[i])
+            continue;
+        const float *model = bodies.model(i);
+        const float depth = -(view[2] * model[12] + view[6] * model[13] + view[10] * model[14] + view[14]);
+        renderQueue.submit(program, bodies.mesh[i], bodies.texture[i], depth, i);
+    }
+    renderQueue.sort();
 
+    instanceData.resize(renderQueue.size());
+    instanceBatches.clear();
 
-        // yörünge matrisini günceller
-        neptuneOrbitMatrix.setToIdentity();
-        neptuneOrbitMatrix.rotate(neptuneOrbitAngle, 0.0f, 1.0f, 0.0f); // Yörüngede Y ekseninde döndür
-        neptuneOrbitMatrix.translate(-1.0f * 75.0f, 0.0f, 0.0f);
+    // MVP = (projection * camera * translate) * model * (rotate * scale); kare başına sabit
+    // kısımlar bir kez çarpılır, köşe shader'ı cisim başına tek matrisle çarpar
+    const float *viewProjection = frameUniforms.viewProjection().constData();
+    const QMatrix4x4 objectMatrix = rotateMatrix * scaleMatrix;
+    const bool objectIdentity = objectMatrix.isIdentity();
 
-        //  kendi ekseni etrafında dönüş matrisini günceller
-        neptuneSelfRotateMatrix.setToIdentity();
-        neptuneSelfRotateMatrix.rotate(neptuneSelfRotateAngle, 0.0f, 1.0f, 0.0f); // Kendi etrafında Y ekseninde döndür
+    GLuint next = 0;
+    quint64 batchState = 0;
+    for (int k = 0; k < renderQueue.size(); ++k)
+    {
+        const quint64 key = renderQueue[k].key;
+        const int i = renderQueue[k].body;
+        if (instanceBatches.empty() || RenderQueue::stateOf(key) != batchState)
+        {
+            instanceBatches.push_back({ renderQueue.mesh(key), renderQueue.texture(key), next, 0 });
+            batchState = RenderQueue::stateOf(key);
+        }
+        instanceBatches.back().count++;
 
+        BodyInstance &instance = instanceData[next++];
+        if (objectIdentity)
+        {
+            multiplyMatrices(viewProjection, bodies.model(i), instance.mvp);
+        }
+        else
+        {
+            float viewModel[16];
+            multiplyMatrices(viewProjection, bodies.model(i), viewModel);
+            multiplyMatrices(viewModel, objectMatrix.constData(), instance.mvp);
+        }
+        instance.layer = surfaceLayer(i);
+    }
 
-        // model matrisini oluşturuluyor ve çiziliyor
-        QMatrix4x4 neptuneModelMatrix = neptuneOrbitMatrix * neptuneSelfRotateMatrix * rotateMatrix;
-        f->glUniformMatrix4fv(scaleMatrixID,1,GL_FALSE, neptuneScaleMatrix.constData());
-        f->glUniformMatrix4fv(rotateMatrixID, 1, GL_FALSE, neptuneModelMatrix.constData());
+    // tamponu her karede yeniden ayırmak sürücünün önceki kareyi beklemesini önler
+    f->glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    f->glBufferData(GL_ARRAY_BUFFER, instanceData.size() * sizeof(BodyInstance), nullptr, GL_STREAM_DRAW);
+    f->glBufferSubData(GL_ARRAY_BUFFER, 0, instanceData.size() * sizeof(BodyInstance), instanceData.data());
+    // per-body ve procedural yollar aynı tamponu SSBO olarak okur (kuşak compute geçişi 0'ı da kullanır)
+    ef->glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, instanceVBO);
+}
 
-        // texture u etkinleştiriliyor
-        f->glBindTexture(GL_TEXTURE_2D, neptuneTexture);
+QOpenGLPanel::RenderPath QOpenGLPanel::activeRenderPath() const
+{
+    // instanced ve procedural yollar 4.3 gerektirir
+    return gl43 ? renderPath : PerBodyPath;
+}
 
-        ef->glBindVertexArray(sphereVAO[0]);
-        f->glDrawElements(GL_TRIANGLE_STRIP, sunSize, GL_UNSIGNED_INT, 0);
-    }
+void QOpenGLPanel::drawBodiesInstanced(QOpenGLFunctions *f, QOpenGLExtraFunctions *ef)
+{
+    prepareInstances(f, ef, instancedProgID);
 
+    glState.useProgram(ef, instancedProgID);
+    for (const InstanceBatch &batch : instanceBatches)
     {
-        // Plüton işlemleri
-        plutoScaleMatrix.setToIdentity();
-        float plutoScaleMulp = 0.6f;  // Plüton'un boyutu
-        plutoScaleMatrix.scale(plutoScaleMulp, plutoScaleMulp, plutoScaleMulp);
-
-        // Plüton'un dönüş açılarını güncelle
-        plutoOrbitAngle += 0.07f;  // Yavaş hareket etsin (gerçekçi olacak şekilde)
-        plutoSelfRotateAngle += 0.3f;
-
-        // Plüton'un yörünge matrisini güncelle
-        plutoOrbitMatrix.setToIdentity();
-        plutoOrbitMatrix.rotate(plutoOrbitAngle, 0.0f, 1.0f, 0.0f); // Güneş etrafında dönüş
-        plutoOrbitMatrix.translate(-1.0f * 85.0f, 0.0f, 0.0f);  // Güneş'e uzaklığı
-
-        // Plüton'un kendi ekseni etrafında dönüş matrisini güncelle
-        plutoSelfRotateMatrix.setToIdentity();
-        plutoSelfRotateMatrix.rotate(plutoSelfRotateAngle, 0.0f, 1.0f, 0.0f);
-
-        // Plüton'un model matrisini oluştur ve çiz
-        QMatrix4x4 plutoModelMatrix = plutoOrbitMatrix * plutoSelfRotateMatrix * rotateMatrix;
-        f->glUniformMatrix4fv(scaleMatrixID, 1, GL_FALSE, plutoScaleMatrix.constData());
-        f->glUniformMatrix4fv(rotateMatrixID, 1, GL_FALSE, plutoModelMatrix.constData());
-
-        // Plüton'un dokusunu etkinleştir
-        f->glBindTexture(GL_TEXTURE_2D, plutoTexture);
-
-        ef->glBindVertexArray(sphereVAO[0]);
-        f->glDrawElements(GL_TRIANGLE_STRIP, sunSize, GL_UNSIGNED_INT, 0);
+        const SphereMeshCache::Mesh &mesh = meshes[batch.mesh];
+        glState.bindTexture(ef, textureTarget, batch.texture);
+        glState.bindVertexArray(ef, mesh.vao);
+        gl43->glDrawElementsInstancedBaseInstance(GL_TRIANGLE_STRIP, mesh.indexCount, GL_UNSIGNED_INT, 0,
+                                                  batch.count, batch.first);
+        glState.countDraw();
     }
+}
 
+void QOpenGLPanel::drawBodiesProcedural(QOpenGLFunctions *f, QOpenGLExtraFunctions *ef)
+{
+    prepareInstances(f, ef, proceduralProgID);
 
-    // MARS'ın uyduları: Phobos ve Deimos
+    glState.useProgram(ef, proceduralProgID);
+    glState.bindVertexArray(ef, proceduralVAO);
+    for (const InstanceBatch &batch : instanceBatches)
     {
-        // Phobos
-        phobosOrbitMatrix.setToIdentity();
-        phobosOrbitMatrix.rotate(phobosOrbitAngle, 0.0f, 1.2f, 0.0f);
-        phobosOrbitMatrix.translate(6.0f, 0.0f, 0.0f);
-        phobosSelfRotateMatrix.setToIdentity();
-        phobosSelfRotateMatrix.rotate(phobosSelfRotateAngle, 0.0f, 1.2f, 0.0f);
-        QMatrix4x4 phobosModelMatrix = marsOrbitMatrix * phobosOrbitMatrix * phobosSelfRotateMatrix;
-        f->glUniformMatrix4fv(rotateMatrixID, 1, GL_FALSE, phobosModelMatrix.constData());
-        f->glBindTexture(GL_TEXTURE_2D, phobosTexture);
-        ef->glBindVertexArray(sphereVAO[1]);
-        f->glDrawElements(GL_TRIANGLE_STRIP, phobosSize, GL_UNSIGNED_INT, 0);
-
-        // Deimos
-        deimosOrbitMatrix.setToIdentity();
-        deimosOrbitMatrix.rotate(deimosOrbitAngle, 0.0f, 0.8f, 0.0f);
-        deimosOrbitMatrix.translate(10.0f, 0.0f, 0.0f);
-        deimosSelfRotateMatrix.setToIdentity();
-        deimosSelfRotateMatrix.rotate(deimosSelfRotateAngle, 0.0f, 0.8f, 0.0f);
-        QMatrix4x4 deimosModelMatrix = marsOrbitMatrix * deimosOrbitMatrix * deimosSelfRotateMatrix;
-        f->glUniformMatrix4fv(rotateMatrixID, 1, GL_FALSE, deimosModelMatrix.constData());
-        f->glBindTexture(GL_TEXTURE_2D, deimosTexture);
-        ef->glBindVertexArray(sphereVAO[1]);
-        f->glDrawElements(GL_TRIANGLE_STRIP, deimosSize, GL_UNSIGNED_INT, 0);
+        glState.bindTexture(ef, textureTarget, batch.texture);
+        glState.uniform1i(ef, proceduralSegmentsID, SphereLod::segments(batch.mesh));
+        glState.uniform1i(ef, proceduralBaseInstanceID, GLint(batch.first));
+        ef->glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, meshes[batch.mesh].indexCount, batch.count);
+        glState.countDraw();
     }
+}
 
-    // JÜPİTER'in uyduları: Io, Europa, Ganymede, Callisto
-    {
-        struct JupiterMoon {
-            QMatrix4x4& orbitMatrix;
-            QMatrix4x4& selfRotateMatrix;
-            float orbitAngle;
-            float selfRotateAngle;
-            float distance;
-            GLuint texture;
-            GLuint size;
-        } moons[] = {
-            { ioOrbitMatrix, ioSelfRotateMatrix, ioOrbitAngle, ioSelfRotateAngle, 1.5f, ioTexture, ioSize },
-            { europaOrbitMatrix, europaSelfRotateMatrix, europaOrbitAngle, europaSelfRotateAngle, 7.5f, europaTexture, europaSize },
-            { ganymedeOrbitMatrix, ganymedeSelfRotateMatrix, ganymedeOrbitAngle, ganymedeSelfRotateAngle, 10.0f, ganymedeTexture, ganymedeSize },
-            { callistoOrbitMatrix, callistoSelfRotateMatrix, callistoOrbitAngle, callistoSelfRotateAngle, 12.5f, callistoTexture, callistoSize }
-        };
-
-        for (const auto& moon : moons) {
-            moon.orbitMatrix.setToIdentity();
-            moon.orbitMatrix.rotate(moon.orbitAngle, 0.0f, 1.0f, 0.0f);
-            moon.orbitMatrix.translate(moon.distance, 0.0f, 0.0f);
-            moon.selfRotateMatrix.setToIdentity();
-            moon.selfRotateMatrix.rotate(moon.selfRotateAngle, 0.0f, 1.0f, 0.0f);
-            QMatrix4x4 moonModelMatrix = jupiterOrbitMatrix * moon.orbitMatrix * moon.selfRotateMatrix;
-            f->glUniformMatrix4fv(rotateMatrixID, 1, GL_FALSE, moonModelMatrix.constData());
-            f->glBindTexture(GL_TEXTURE_2D, moon.texture);
-            ef->glBindVertexArray(sphereVAO[1]);
-            f->glDrawElements(GL_TRIANGLE_STRIP, moon.size, GL_UNSIGNED_INT, 0);
-        }
-    }
+void QOpenGLPanel::selectLevelsOfDetail()
+{
+    // cismin sınırlayıcı küresi ekrana izdüşürülür: piksel yarıçap = r * P[1][1] / derinlik * yükseklik / 2
+    const QMatrix4x4 view = cameraMatrix * translateMatrix;
+    const float pixelScale = 0.5f * framebufferHeight() * projectionMatrix(1, 1);
+    const float userScale = geometryScale();
 
-    // SATÜRN'ün uyduları: Titan ve Enceladus
+    lodVertices = 0;
+    for (int i = 0; i < bodies.size(); ++i)
     {
-        // Titan
-        titanOrbitMatrix.setToIdentity();
-        titanOrbitMatrix.rotate(titanOrbitAngle, 0.0f, 1.0f, 0.0f);
-        titanOrbitMatrix.translate(10.0f, 0.0f, 0.0f);
-        titanSelfRotateMatrix.setToIdentity();
-        titanSelfRotateMatrix.rotate(titanSelfRotateAngle, 0.0f, 1.0f, 0.0f);
-        QMatrix4x4 titanModelMatrix = saturnOrbitMatrix * titanOrbitMatrix * titanSelfRotateMatrix;
-        f->glUniformMatrix4fv(rotateMatrixID, 1, GL_FALSE, titanModelMatrix.constData());
-        f->glBindTexture(GL_TEXTURE_2D, titanTexture);
-        ef->glBindVertexArray(sphereVAO[1]);
-        f->glDrawElements(GL_TRIANGLE_STRIP, titanSize, GL_UNSIGNED_INT, 0);
-
-        // Enceladus
-        enceladusOrbitMatrix.setToIdentity();
-        enceladusOrbitMatrix.rotate(enceladusOrbitAngle, 0.0f, 1.4f, 0.0f);
-        enceladusOrbitMatrix.translate(8.0f, 0.0f, 0.0f);
-        enceladusSelfRotateMatrix.setToIdentity();
-        enceladusSelfRotateMatrix.rotate(enceladusSelfRotateAngle, 0.0f, 1.4f, 0.0f);
-        QMatrix4x4 enceladusModelMatrix = saturnOrbitMatrix * enceladusOrbitMatrix * enceladusSelfRotateMatrix;
-        f->glUniformMatrix4fv(rotateMatrixID, 1, GL_FALSE, enceladusModelMatrix.constData());
-        f->glBindTexture(GL_TEXTURE_2D, enceladusTexture);
-        ef->glBindVertexArray(sphereVAO[1]);
-        f->glDrawElements(GL_TRIANGLE_STRIP, enceladusSize, GL_UNSIGNED_INT, 0);
-    }
+        if (!bodies.visible[i])
+            continue;
 
-    // PLÜTON'un uydusu: Charon
-    {
-        charonOrbitMatrix.setToIdentity();
-        charonOrbitMatrix.rotate(charonOrbitAngle, 0.0f, 1.0f, 0.0f);
-        charonOrbitMatrix.translate(6.0f, 0.0f, 0.0f);        charonSelfRotateMatrix.setToIdentity();
-        charonSelfRotateMatrix.rotate(charonSelfRotateAngle, 0.0f, 1.0f, 0.0f);
-        QMatrix4x4 charonModelMatrix = plutoOrbitMatrix * charonOrbitMatrix * charonSelfRotateMatrix;
-        f->glUniformMatrix4fv(rotateMatrixID, 1, GL_FALSE, charonModelMatrix.constData());
-        f->glBindTexture(GL_TEXTURE_2D, charonTexture);
-        ef->glBindVertexArray(sphereVAO[1]);
-        f->glDrawElements(GL_TRIANGLE_STRIP, charonSize, GL_UNSIGNED_INT, 0);
+        const QVector3D center = view.map(bodies.position(i));
+        const float radius = bodies.scale[i] * userScale;
+        const float depth = -center.z();
+
+        // kamera kürenin içindeyse ya da çok yakınsa en ince seviye
+        const float projectedRadius = depth > radius ? radius * pixelScale / depth : 1.0e6f;
+        bodies.mesh[i] = SphereLod::selectLevel(projectedRadius, lodMaxError, bodies.mesh[i]);
+        lodVertices += meshes[bodies.mesh[i]].indexCount;
     }
+}
+
+float QOpenGLPanel::geometryScale() const
+{
+    // scaleMatrix küre geometrisini büyütür; sınırlayıcı küreler en büyük eksene göre alınır
+    return qMax(qMax(scaleMatrix.column(0).toVector3D().length(),
+                     scaleMatrix.column(1).toVector3D().length()),
+                scaleMatrix.column(2).toVector3D().length());
+}
 
+float QOpenGLPanel::framebufferHeight() const
+{
+    return capture.isActive() ? float(capture.size().height()) : float(height() * devicePixelRatioF());
+}
 
-    update();
+bool QOpenGLPanel::startCapture(const QString &path, FrameCapture::Format format, QSize size, int fps)
+{
+    // pencerede bağlam paintGL dışında current değildir
+    if (context())
+        makeCurrent();
+    return capture.start(getGLExtraFunctions(), path, format, size, fps);
+}
+
+void QOpenGLPanel::stopCapture()
+{
+    if (!capture.isActive())
+        return;
+    if (context())
+        makeCurrent();
+    capture.stop(getGLExtraFunctions());
+}
+
+void QOpenGLPanel::logFrameTime(qint64 nsecs)
+{
+    // her 300 karede bir ortalama CPU kare süresini yazar
+    frameTimeSum += nsecs;
+    if (++frameTimeCount < 300)
+        return;
+
+    static const char *const pathNames[] = { "Per-body", "Instanced", "Procedural" };
+    qDebug() << pathNames[activeRenderPath()]
+             << "render path, average CPU frame time:" << double(frameTimeSum) / frameTimeCount / 1.0e6 << "ms,"
+             << "GL calls per frame:" << glState.issuedCalls() << "(" << glState.skippedCalls() << "redundant skipped),"
+             << "vertices per frame:" << lodVertices << "of" << fixedVertices << "without LOD,"
+             << "bodies drawn:" << drawnBodyCount << "culled:" << bodies.size() - drawnBodyCount;
+    frameTimeSum = 0;
+    frameTimeCount = 0;
 }
 
 void QOpenGLPanel::resizeGL(int width, int height)
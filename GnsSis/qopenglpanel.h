@@ -7,6 +7,7 @@
 #include <QtOpenGLWidgets/QOpenGLWidget>
 #include <QtOpenGL/QOpenGLVertexArrayObject>
 #include <QtOpenGL/QOpenGLBuffer>
+#include <QtOpenGL/QOpenGLFunctions_4_3_Core>
 #include <QFile>
 #include <QMatrix4x4>
 #include <QtMath>
@@ -15,10 +16,37 @@
 #include <QOpenGLTexture>
 
 #include <QFileInfo>
+#include <QElapsedTimer>
+#include <QTimer>
+
+#include "beltparticles.h"
+#include "bodystore.h"
+#include "collisiondetector.h"
+#include "ephemeris.h"
+#include "framecapture.h"
+#include "frameprofiler.h"
+#include "frameuniforms.h"
+#include "glstatecache.h"
+#include "renderqueue.h"
+#include "shadercache.h"
+#include "nbodysimulation.h"
+#include "simulationclock.h"
+#include "simulationthread.h"
+#include "spherelod.h"
+#include "spheremeshcache.h"
+#include "texturearrayloader.h"
 
 class QOpenGLPanel : public QOpenGLWidget
 {
 public:
+    // cisimleri çizme yolu: her cisim için ayrı çağrı, mesh başına instanced çağrı ya da
+    // köşe tamponu olmadan shader'da üretilen küre (procedural.vert)
+    enum RenderPath { PerBodyPath, InstancedPath, ProceduralPath };
+    // yüzey dokuları: her biri ayrı GL_TEXTURE_2D ya da çözünürlük sınıfı başına bir dizi
+    enum TextureMode { SeparateTextures, ArrayTextures };
+    // cisimlerin hareketi: sabit Kepler yörüngeleri ya da karşılıklı kütle çekimi (Barnes–Hut)
+    enum SimulationMode { KeplerMode, NBodyMode };
+
     QOpenGLPanel(QWidget *parent = nullptr);
     ~QOpenGLPanel();
     void setCameraMatrix();
@@ -29,28 +57,127 @@ public:
     void lookAt(GLfloat ex, GLfloat ey, GLfloat ez, GLfloat cx, GLfloat cy, GLfloat cz, GLfloat ux, GLfloat uy, GLfloat uz);
     void perspective(GLfloat angle, GLfloat ratio, GLfloat near, GLfloat far);
     void resetScene();
+    void setRenderPath(RenderPath path);
     void mousePressEvent(QMouseEvent* event) override;
 
-    GLuint createSphere(GLuint X_SEGMENTS, GLuint Y_SEGMENT, GLfloat x_offset, GLfloat y_offset, GLfloat z_offset);
     unsigned char* getObjectTextureData();
     GLuint loadTexture(QString fileName);
 
-private:
-
+    // pencere olmadan da (ör. RenderBench, QOffscreenSurface + FBO) çağrılabilir;
+    // çağıran tarafın bağlamı current ve hedef framebuffer bağlı olmalı
     void initializeGL() override;
     void paintGL() override;
     void resizeGL(int width, int height) override;
-    const char* readShaderSource(QString filename);
+    // çözülmekte olan tüm dokuların bitmesini bekler
+    void finishTextureLoading();
+
+    // Mars ile Jüpiter arasına eklenecek küçük cisim sayısı; initializeGL'den önce çağrılmalı
+    void setBeltBodyCount(int count);
+    void setLevelOfDetail(bool enabled);
+    // GPU'da ilerletilen kuşak parçacıkları (asteroit, Kuiper); initializeGL'den önce çağrılmalı
+    void setBeltParticleCount(int asteroids, int kuiperObjects);
+    const BeltParticles &beltParticles() const { return particles; }
+    // Kepler modunda dosyada serisi olan cisimler Chebyshev tablosundan konumlanır;
+    // initializeGL'den önce çağrılmalı
+    void setEphemerisFile(const QString &path);
+    const Ephemeris &ephemerisData() const { return ephemeris; }
+    // initializeGL'den önce çağrılmalı; sonrasında mod değişmez
+    void setSimulationMode(SimulationMode mode);
+    void setNBodyTheta(float theta);
+    const NBodySimulation &nBodySimulation() const { return nbody; }
+    // gerçek adım başına simülasyon adımı (-maxTimeScale..maxTimeScale; negatif geri akar)
+    // ve simülasyon zamanı (adım); ikisi de yalnızca Kepler modunda değiştirilebilir
+    static constexpr double maxTimeScale = 1.0e6;
+    void setTimeScale(double scale);
+    double timeScale() const { return simulationClock.timeScale(); }
+    void setSimulationTime(double ticks);
+    double simulationTime() const { return simulationClock.time(); }
+    // saat ilk gösterimde başlar; pencere olmadan çizenler (RenderBench) kendileri başlatır
+    void startSimulation();
+    // simülasyon ayrı iş parçacığında (varsayılan) ya da paintGL içinde; initializeGL'den önce
+    void setSimulationThread(bool enabled) { threadedSimulation = enabled; }
+    bool simulationThreadRunning() const { return simulationThread.isRunning(); }
+    // iş parçacığını durdurur; sonrasında N-body ve çarpışma durumu GUI'den güvenle okunur
+    void finishSimulation();
+    // çizilen durumu üreten son simülasyon adımının süresi
+    double simulationStepMs() const { return simulationStepNsecs / 1.0e6; }
+    // her adımda sınırlayıcı küreler sınanır; tepki (Bounce, Merge) yalnızca N-body modunda
+    void setCollisionDetection(bool enabled, CollisionDetector::Response response = CollisionDetector::Flag);
+    const CollisionDetector &collisionDetector() const { return collisions; }
+    // açılıştan bu yana iç içe bulunan ve tepki verilen çift sayısı
+    qint64 totalOverlaps() const { return overlapTotal; }
+    qint64 resolvedCollisions() const { return resolvedTotal; }
+    // sınama yapılan adım sayısı; 0 ise sayaçlar hiçbir şey ölçmemiştir (ör. saat durmuş)
+    int collisionTests() const { return collisionChecks; }
+    // son karede çizilen köşe sayısı ve LOD kapalıyken çizilecek olan
+    qint64 drawnVertices() const { return lodVertices; }
+    qint64 fullDetailVertices() const { return fixedVertices; }
+    // son karede görüş hacmi testinden geçen ve elenen cisimler
+    int drawnBodies() const { return drawnBodyCount; }
+    int culledBodies() const { return bodies.size() - drawnBodyCount; }
+    // son karede cisimler için GL'ye giden durum/çizim çağrıları ve aynı durumu yeniden
+    // kurduğu için atlananlar (önbelleksiz çağrı sayısı ikisinin toplamı)
+    void setStateCache(bool enabled) { glState.setEnabled(enabled); }
+    int glCalls() const { return glState.issuedCalls(); }
+    int skippedGlCalls() const { return glState.skippedCalls(); }
+    // CPU bölgeleri ve GPU geçişlerinin süreleri; GNSSIS_PROFILER=off kapatır
+    FrameProfiler &frameProfiler() { return profiler; }
+    // son karelerin grafiği ve bölge ortalamaları pencerenin sol üstünde (GNSSIS_PROFILER_HUD=on)
+    void setProfilerOverlay(bool enabled) { profilerOverlay = enabled; }
+    // sahne size çözünürlüğünde ayrı bir FBO'ya çizilip kaydedilir (bkz. FrameCapture); pencerede
+    // ölçeklenmiş önizleme gösterilir. Pencere yoksa (CaptureRenderer) çağıranın bağlamı current olmalı
+    bool startCapture(const QString &path, FrameCapture::Format format, QSize size, int fps = 60);
+    void stopCapture();
+    const FrameCapture &frameCapture() const { return capture; }
+    // pencere olmadan kayıtta önizleme kopyası atlanır
+    void setCapturePreview(bool enabled) { capturePreview = enabled; }
+
+private:
+
+    void showEvent(QShowEvent *event) override;
+    void hideEvent(QHideEvent *event) override;
+    void scheduleFrame();
+    void schedulePacedFrame();
     QOpenGLFunctions* getGLFunctions();
     QOpenGLExtraFunctions* getGLExtraFunctions();
-    bool initializeShaderProgram(QString vertex, QString fragment, QOpenGLFunctions *f);
+    GLuint initializeShaderProgram(QString vertex, QString fragment, QOpenGLFunctions *f);
     bool checkGLError(QOpenGLFunctions *f, QString functionCall);
+    void buildSolarSystem();
+    void initNBody();
+    void initBeltParticles();
+    void initEphemeris();
+    // simülasyon fonksiyonları verilen tabloda çalışır: iş parçacığı modunda simulationBodies,
+    // aksi halde bodies
+    void stepSimulation(BodyStore &store, const SimulationThread::Request &request);
+    // GUI tarafındaki zaman ve ayarlar; iş parçacığı bunlardan başka durum okumaz
+    SimulationThread::Request simulationRequest(int ticks, float alpha) const;
+    void startSimulationThread();
+    void applySnapshot(SimulationThread::Snapshot &snapshot);
+    void applyEphemeris(BodyStore &store, double time);
+    void detectCollisionsKepler(BodyStore &store, float userScale);
+    void detectCollisionsNBody(BodyStore &store, float userScale, CollisionDetector::Response response);
+    void logCollisions();
+    TextureArrayLoader::Slot loadSurface(QString fileName);
+    float surfaceLayer(int body) const;
+    void logStartupTimes();
+    void drawBodiesPerBody(QOpenGLFunctions *f, QOpenGLExtraFunctions *ef);
+    void prepareInstances(QOpenGLFunctions *f, QOpenGLExtraFunctions *ef, GLuint program);
+    void drawBodiesInstanced(QOpenGLFunctions *f, QOpenGLExtraFunctions *ef);
+    void drawBodiesProcedural(QOpenGLFunctions *f, QOpenGLExtraFunctions *ef);
+    RenderPath activeRenderPath() const;
+    void logFrameTime(qint64 nsecs);
+    void selectLevelsOfDetail();
+    float geometryScale() const;
+    // LOD ve nokta boyutu için çizim hedefinin piksel yüksekliği (kayıtta FBO'nunki)
+    float framebufferHeight() const;
 
-    GLuint progID, vertID, fragID;
+    // bağlanmış programların diskteki ikili kopyaları; ikinci açılıştan itibaren derleme yok
+    ShaderCache shaderCache;
+    GLuint progID;
+    GLuint instanceIndexID;
     GLuint arrays, triangleData;
     GLuint position, color, normal, texture;
 
-    GLuint translateMatrixID, rotateMatrixID, scaleMatrixID;
     QMatrix4x4 translateMatrix, rotateMatrix, scaleMatrix;
     GLfloat tX, tY, tZ;
     float rDegree;
@@ -59,8 +186,9 @@ private:
     GLfloat reX, reY, reZ;
 
 
-    GLuint projectionMatrixID, cameraMatrixID;
     QMatrix4x4 projectionMatrix, cameraMatrix;
+    // görüş ve izdüşüm matrisleri kare başına bir kez uniform tampona yüklenir
+    FrameUniforms frameUniforms;
     GLfloat camEyeX, camEyeY, camEyeZ;
     QVector3D cameraEye;
     GLfloat camCenterX, camCenterY, camCenterZ;
@@ -69,80 +197,124 @@ private:
     QVector3D cameraUp;
     GLfloat verticalAngle, aspectRatio, nearPlane, farPlane;
 
-    std::vector<float> vert;
-    GLuint sphereVAO[2], vbo[2], ebo[2];
-    GLuint indexCount;
-
-    QList<QVector3D> positions;
-    QList<QVector2D> uv;
-    QList<QVector3D> normals;
-
-    std::vector<unsigned int> indices;
-
-    QMatrix4x4 sunScaleMatrix;
-    QMatrix4x4 sunRotateMatrix;
-
-    QMatrix4x4 earthScaleMatrix, moonScaleMatrix, merkurScaleMatrix, venusScaleMatrix, marsScaleMatrix, jupiterScaleMatrix, saturnScaleMatrix, uranusScaleMatrix, neptuneScaleMatrix;
-    QMatrix4x4 earthOrbitMatrix, moonOrbitMatrix, merkurOrbitMatrix, jupiterOrbitMatrix, venusOrbitMatrix, marsOrbitMatrix, saturnOrbitMatrix, uranusOrbitMatrix, neptuneOrbitMatrix;
-
-    QMatrix4x4 earthSelfRotateMatrix, moonSelfRotateMatrix, merkurSelfRotateMatrix, jupiterSelfRotateMatrix, venusSelfRotateMatrix, marsSelfRotateMatrix, saturnSelfRotateMatrix, uranusSelfRotateMatrix, neptuneSelfRotateMatrix;
-    QMatrix4x4 plutoScaleMatrix, plutoOrbitMatrix, plutoSelfRotateMatrix;
-
-    // 🌑 Mars'ın Uyduları
-    QMatrix4x4 phobosScaleMatrix, deimosScaleMatrix;
-    QMatrix4x4 phobosOrbitMatrix, phobosSelfRotateMatrix, deimosOrbitMatrix, deimosSelfRotateMatrix;
-
-    // 🟠 Jüpiter'in Uyduları
-    QMatrix4x4 ioScaleMatrix, europaScaleMatrix, ganymedeScaleMatrix, callistoScaleMatrix;
-    QMatrix4x4 ioOrbitMatrix, ioSelfRotateMatrix, europaOrbitMatrix, europaSelfRotateMatrix;
-    QMatrix4x4 ganymedeOrbitMatrix, ganymedeSelfRotateMatrix, callistoOrbitMatrix, callistoSelfRotateMatrix;
-
-    // 🟡 Satürn'ün Uyduları
-    QMatrix4x4 titanScaleMatrix, enceladusScaleMatrix;
-    QMatrix4x4 titanOrbitMatrix, titanSelfRotateMatrix, enceladusOrbitMatrix, enceladusSelfRotateMatrix;
-
-    // 🔵 Uranüs ve Neptün'ün Uyduları
-    QMatrix4x4 mirandaScaleMatrix, titaniaScaleMatrix, tritonScaleMatrix;
-    QMatrix4x4 mirandaOrbitMatrix, mirandaSelfRotateMatrix, titaniaOrbitMatrix, titaniaSelfRotateMatrix;
-    QMatrix4x4 tritonOrbitMatrix, tritonSelfRotateMatrix;
-
-    // 🟤 Plüton'un Uydusu
-    QMatrix4x4 charonScaleMatrix;
-    QMatrix4x4 charonOrbitMatrix, charonSelfRotateMatrix;
-
-    float sunScaleMultp;
-    float earthOrbitAngle, moonOrbitAngle, merkurOrbitAngle, jupiterOrbitAngle, venusOrbitAngle, marsOrbitAngle, saturnOrbitAngle, uranusOrbitAngle, neptuneOrbitAngle;
-    float sunSelfRotateAngle, earthSelfRotateAngle, moonSelfRotateAngle, merkurSelfRotateAngle, jupiterSelfRotateAngle, venusSelfRotateAngle, marsSelfRotateAngle, saturnSelfRotateAngle, uranusSelfRotateAngle, neptuneSelfRotateAngle;
-    float plutoOrbitAngle, plutoSelfRotateAngle;
-    float phobosOrbitAngle, phobosSelfRotateAngle, deimosOrbitAngle, deimosSelfRotateAngle;
-    float ioOrbitAngle, ioSelfRotateAngle, europaOrbitAngle, europaSelfRotateAngle;
-    float ganymedeOrbitAngle, ganymedeSelfRotateAngle, callistoOrbitAngle, callistoSelfRotateAngle;
-    float titanOrbitAngle, titanSelfRotateAngle, enceladusOrbitAngle, enceladusSelfRotateAngle;
-    float mirandaOrbitAngle, mirandaSelfRotateAngle, titaniaOrbitAngle, titaniaSelfRotateAngle;
-    float tritonOrbitAngle, tritonSelfRotateAngle;
-    float charonOrbitAngle, charonSelfRotateAngle;
-
-    GLuint sunSize;
-    GLuint moonSize;
-    GLuint earthSize, merkurSize, jupiterSize, venusSize, marsSize, saturnSize, uranusSize, neptuneSize;
-    GLuint plutoSize;
-    GLuint plutoTexture;
-    GLuint phobosSize, deimosSize;
-    GLuint phobosTexture, deimosTexture;
-    GLuint ioSize, europaSize, ganymedeSize, callistoSize;
-    GLuint ioTexture, europaTexture, ganymedeTexture, callistoTexture;
-    GLuint titanSize, enceladusSize;
-    GLuint titanTexture, enceladusTexture;
-    GLuint mirandaSize, titaniaSize, tritonSize;
-    GLuint mirandaTexture, titaniaTexture, tritonTexture;
-    GLuint charonSize;
-    GLuint charonTexture;
+    // küreler bölümleme başına bir kez üretilir; meshes[l] SphereLod seviyesi l,
+    // bodies.mesh her karede ekrandaki boyuta göre seçilir
+    SphereMeshCache meshCache;
+    std::vector<SphereMeshCache::Mesh> meshes;
+    bool levelOfDetail;
+    float lodMaxError;          // piksel
+    qint64 lodVertices, fixedVertices;
+    int beltBodyCount;
+
+    // ekran dışındaki cisimler (ve uydu sistemleri) çizilmez; GNSSIS_CULLING=off kapatır
+    bool frustumCulling;
+    int drawnBodyCount;
+
+    // 🌞🪐🛰️ Güneş, gezegenler ve uydular tek tabloda
+    BodyStore bodies;
+
+    // ☄️ kuşak parçacıkları; veriler yalnızca GPU'da, BodyStore'a girmez
+    BeltParticles particles;
+    int asteroidParticleCount, kuiperParticleCount;
+
+    // GNSSIS_EPHEMERIS: Kepler yörüngesi yerine tablodan konumlanan cisimler (kapsam içindeyken)
+    QString ephemerisPath;
+    Ephemeris ephemeris;
+    std::vector<int> ephemerisBodies;
+    std::vector<int> placedBodies;
+    std::vector<float> placedX, placedY, placedZ;
+
+    // N-body modunda konumlar buradan gelir; BodyStore yalnızca dönüş ve çizim bilgisini tutar
+    SimulationMode simulationMode;
+    NBodySimulation nbody;
+    std::vector<float> nbodyX, nbodyY, nbodyZ;
+
+    // GNSSIS_COLLISIONS=flag|bounce|merge; Kepler modunda yalnızca raporlanır
+    bool collisionDetection;
+    CollisionDetector::Response collisionResponse;
+    CollisionDetector collisions;
+    std::vector<float> collisionRadius;
+    // Kepler modunda bir önceki sınamadaki konumlar; küreler oradan bu kareye süpürülür
+    std::vector<float> sweepStartX, sweepStartY, sweepStartZ, sweepEndX, sweepEndY, sweepEndZ;
+    qint64 overlapTotal, resolvedTotal;
+    int collisionChecks;
+
+    // cisim başına önceden çarpılmış MVP matrisi ve doku katmanı; her üç yolda da shader
+    // tek çarpım yapar (instanced: köşe özniteliği, per-body ve procedural: SSBO)
+    struct BodyInstance {
+        GLfloat mvp[16];
+        GLfloat layer;
+        GLfloat padding[3];
+    };
+    // aynı mesh ve dokuyu paylaşan ardışık cisimler tek çağrıda çizilir
+    struct InstanceBatch {
+        int mesh;
+        GLuint texture;
+        GLuint first;
+        GLsizei count;
+    };
+    RenderPath renderPath;
+    QOpenGLFunctions_4_3_Core *gl43;
+    GLuint instancedProgID;
+    GLuint instanceVBO;
+    std::vector<BodyInstance> instanceData;
+    std::vector<InstanceBatch> instanceBatches;
+    // görünen cisimler GL durumuna göre sıralanır; çağrılar durum önbelleğinden geçer
+    RenderQueue renderQueue;
+    GLStateCache glState;
+
+    // procedural yol: boş VAO, instance tamponu SSBO olarak okunur
+    GLuint proceduralProgID, proceduralVAO;
+    GLuint proceduralSegmentsID, proceduralBaseInstanceID;
+
+    TextureMode textureMode;
+    GLenum textureTarget;
+    TextureArrayLoader textureArrays;
+
+    // açılış ölçümleri: ilk kare ve tüm dokuların yüklenmesi
+    QElapsedTimer startupTimer;
+    bool firstFrameLogged, fullyTexturedLogged;
+
+    // simülasyon saniyede sabit sayıda adım ilerler, çizim adımlar arasında ara değerlenir
+    SimulationClock simulationClock;
+    // GUI istenen zamanı bırakır, iş parçacığı simulationBodies'i ilerletip matrisleri anlık
+    // görüntü olarak yayınlar; paintGL yalnızca son tamamlananı bodies'e alır
+    bool threadedSimulation;
+    SimulationThread simulationThread;
+    BodyStore simulationBodies;
+    bool sweepReset;
+    // merge tepkisi ölçekleri değiştirdikçe artar (simülasyon tarafı) / çizime alınan sürüm
+    quint64 scaleVersion, appliedScaleVersion;
+    double stateTime;               // çizilen durumun simülasyon zamanı
+    qint64 simulationStepNsecs;
+    // targetFps > 0 ise kareler zamanlayıcıyla sınırlanır, 0 ise dikey eşitlemeye (vsync) bağlıdır
+    static const int maxTargetFps = 1000;
+    int targetFps;
+    QTimer pacingTimer;
+    QElapsedTimer pacingClock;
+    qint64 frameIntervalNsecs, nextFrameNsecs;   // sıradaki karenin son tarihi pacingClock'a göre
+    bool renderingPaused;
+
+    // GNSSIS_PROFILER_TRACE=dosya ve GNSSIS_PROFILER_TRACE_FRAMES=ilk-son seçilen kareleri
+    // Chrome trace olarak yazar
+    FrameProfiler profiler;
+    bool profilerOverlay;
+
+    // GNSSIS_CAPTURE=klasör|dosya.y4m|dosya.yuv, GNSSIS_CAPTURE_SIZE=1920x1080, GNSSIS_CAPTURE_FPS
+    FrameCapture capture;
+    bool capturePreview;
+    QString capturePath;
+    QSize captureSize;
+    int captureFps;
+
+    QElapsedTimer frameTimer;
+    qint64 frameTimeSum;
+    int frameTimeCount;
 
     // QOpenGLTexture *texture;
     GLuint textureID;
 
     QImage Texture;
-    GLuint sunTexture, earthTexture, moonTexture, mercuryTexture, jupiterTexture, venusTexture, marsTexture, saturnTexture, uranusTexture, neptuneTexture;
 };
 
 #endif // QOPENGLPANEL_H
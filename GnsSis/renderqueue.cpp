@@ -0,0 +1,75 @@
+#include "renderqueue.h"
+
+#include <QtMath>
+
+#include <algorithm>
+#include <cmath>
+
+void RenderQueue::setDepthRange(float nearDepth, float farDepth)
+{
+    depthNear = qMax(nearDepth, 1.0e-6f);
+    depthScale = float((1 << depthBits) - 1) / std::log2(qMax(farDepth / depthNear, 1.0f + 1.0e-6f));
+}
+
+quint32 RenderQueue::slot(std::vector<GLuint> &names, GLuint name, int &last)
+{
+    // art arda gelen cisimler çoğunlukla aynı dokuyu kullanır; tablo küçük, doğrusal arama yeter
+    if (last < int(names.size()) && names[last] == name)
+        return quint32(last);
+    const auto found = std::find(names.begin(), names.end(), name);
+    last = int(found - names.begin());
+    if (found == names.end())
+        names.push_back(name);
+    return quint32(last);
+}
+
+void RenderQueue::submit(GLuint program, int mesh, GLuint texture, float depth, int body)
+{
+    const quint64 programSlot = slot(programs, program, lastProgram);
+    const quint64 textureSlot = slot(textures, texture, lastTexture);
+    Q_ASSERT(programSlot < (1u << programBits) && textureSlot < (1u << textureBits) && mesh < (1 << meshBits));
+
+    // kameranın arkası ve near'dan yakını 0, far'ın ötesi en büyük değer
+    const float scaled = depth > depthNear ? std::log2(depth / depthNear) * depthScale : 0.0f;
+    const quint64 depthKey = quint64(qMin(scaled, float((1 << depthBits) - 1)));
+
+    const quint64 key = (programSlot << (depthBits + textureBits + meshBits))
+                      | (quint64(mesh) << (depthBits + textureBits))
+                      | (textureSlot << depthBits)
+                      | depthKey;
+    items.push_back({ key, body });
+}
+
+void RenderQueue::sort()
+{
+    // LSD radix sort, 8 bitlik basamaklar; tüm histogramlar tek geçişte çıkarılır ve
+    // tüm elemanların aynı değeri taşıdığı basamaklar (ör. tek program) atlanır
+    const int digits = (keyBits + 7) / 8;
+    const size_t count = items.size();
+    if (count < 2)
+        return;
+
+    std::vector<quint32> histograms(size_t(digits) * 256, 0);
+    for (const Item &item : items)
+        for (int d = 0; d < digits; ++d)
+            ++histograms[size_t(d) * 256 + ((item.key >> (8 * d)) & 0xff)];
+
+    scratch.resize(count);
+    for (int d = 0; d < digits; ++d)
+    {
+        quint32 *histogram = histograms.data() + size_t(d) * 256;
+        if (histogram[(items[0].key >> (8 * d)) & 0xff] == count)
+            continue;
+
+        quint32 offset = 0;
+        for (int bucket = 0; bucket < 256; ++bucket)
+        {
+            const quint32 n = histogram[bucket];
+            histogram[bucket] = offset;
+            offset += n;
+        }
+        for (const Item &item : items)
+            scratch[histogram[(item.key >> (8 * d)) & 0xff]++] = item;
+        items.swap(scratch);
+    }
+}
@@ -0,0 +1,51 @@
+#ifndef RENDERQUEUE_H
+#define RENDERQUEUE_H
+
+#include <QOpenGLFunctions>
+
+#include <vector>
+
+// Görünen cisimler her karede kısa bir sıralama anahtarıyla kuyruğa girer ve radix sort ile
+// GL durumuna göre sıralanır: önce program, sonra mesh (VAO), doku ve en sonda derinlik
+// (yakından uzağa; erken derinlik testi arkadaki parçaları atar). Aynı durumdaki ardışık
+// cisimler tek grupta çizilir, durum değişiklikleri en aza iner.
+//
+// Anahtar (düşük bitten yükseğe): derinlik 16 | doku 16 | mesh 6 | program 4 bit.
+// Program ve doku GL adları kuyruğun küçük tablolarındaki sıralarıyla (slot) kodlanır.
+class RenderQueue
+{
+public:
+    static const int depthBits = 16, textureBits = 16, meshBits = 6, programBits = 4;
+    static const int keyBits = depthBits + textureBits + meshBits + programBits;
+
+    struct Item {
+        quint64 key;
+        int body;
+    };
+
+    // derinlik near..far aralığında logaritmik olarak nicelenir
+    void setDepthRange(float nearDepth, float farDepth);
+    void clear() { items.clear(); }
+    void submit(GLuint program, int mesh, GLuint texture, float depth, int body);
+    // kararlı; aynı anahtarlı cisimler ekleme sırasını korur
+    void sort();
+
+    int size() const { return int(items.size()); }
+    const Item &operator[](int index) const { return items[index]; }
+
+    // derinlik dışındaki bitler: aynıysa aynı GL durumu
+    static quint64 stateOf(quint64 key) { return key >> depthBits; }
+    GLuint program(quint64 key) const { return programs[key >> (depthBits + textureBits + meshBits)]; }
+    int mesh(quint64 key) const { return int((key >> (depthBits + textureBits)) & ((1u << meshBits) - 1)); }
+    GLuint texture(quint64 key) const { return textures[(key >> depthBits) & ((1u << textureBits) - 1)]; }
+
+private:
+    static quint32 slot(std::vector<GLuint> &names, GLuint name, int &last);
+
+    std::vector<Item> items, scratch;
+    std::vector<GLuint> programs, textures;
+    int lastProgram = 0, lastTexture = 0;
+    float depthNear = 0.1f, depthScale = 1.0f;
+};
+
+#endif // RENDERQUEUE_H
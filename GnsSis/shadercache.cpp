@@ -0,0 +1,206 @@
+#include "shadercache.h"
+
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+#include <cstring>
+
+namespace {
+
+// dosya: magic, u32 ikili biçim (binaryFormat), program ikilisi
+const char magic[8] = { 'G', 'N', 'S', 'P', 'R', 'G', '0', '1' };
+const int headerSize = 8 + 4;
+
+QByteArray glString(QOpenGLExtraFunctions *ef, GLenum name)
+{
+    return QByteArray(reinterpret_cast<const char *>(ef->glGetString(name)));
+}
+
+}
+
+QString ShaderCache::directory()
+{
+    // varsayılan çalıştırılabilir dosyanın yanı (texturecache/ gibi)
+    QString dir = qEnvironmentVariable("GNSSIS_SHADER_CACHE");
+    if (dir.isEmpty())
+        dir = QCoreApplication::applicationDirPath() + "/shadercache";
+    return dir;
+}
+
+QByteArray ShaderCache::readSource(const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QFile::ReadOnly))
+    {
+        qDebug() << "Error while reading shader source file" << fileName;
+        return QByteArray();
+    }
+    return file.readAll();
+}
+
+bool ShaderCache::enabled(QOpenGLExtraFunctions *ef)
+{
+    if (binaryFormats < 0)
+    {
+        cacheDirectory = directory();
+        binaryFormats = 0;
+        if (cacheDirectory != "off")
+            ef->glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &binaryFormats);
+        if (binaryFormats == 0 && cacheDirectory != "off")
+            qDebug() << "Driver has no program binary formats, shader cache disabled";
+    }
+    return binaryFormats > 0;
+}
+
+QByteArray ShaderCache::key(QOpenGLExtraFunctions *ef, const Stages &stages, const std::vector<QByteArray> &sources) const
+{
+    // aynı kaynak farklı sürücüde farklı ikili üretir; sürücü sürümü de anahtara girer
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(glString(ef, GL_VENDOR));
+    hash.addData(glString(ef, GL_RENDERER));
+    hash.addData(glString(ef, GL_VERSION));
+    for (size_t i = 0; i < stages.size(); ++i)
+    {
+        const quint32 type = stages[i].first;
+        hash.addData(QByteArray(reinterpret_cast<const char *>(&type), sizeof(type)));
+        hash.addData(sources[i]);
+    }
+    return hash.result().toHex();
+}
+
+GLuint ShaderCache::build(QOpenGLExtraFunctions *ef, const Stages &stages)
+{
+    // kaynaklar glShaderSource çağrısı boyunca yaşamalı; burada tutulur
+    std::vector<QByteArray> sources;
+    for (const auto &stage : stages)
+    {
+        sources.push_back(readSource(stage.second));
+        if (sources.back().isEmpty())
+            return 0;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    const bool useCache = enabled(ef);
+    const QString path = useCache ? cacheDirectory + "/" + QString::fromLatin1(key(ef, stages, sources)) + ".bin" : QString();
+    if (useCache)
+    {
+        const GLuint program = load(ef, path);
+        if (program != 0)
+        {
+            const qint64 nsecs = timer.nsecsElapsed();
+            loadTime += nsecs;
+            ++loadedCount;
+            qDebug() << "Shader program" << QFileInfo(stages.front().second).fileName()
+                     << "loaded from cache in" << nsecs / 1.0e6 << "ms";
+            return program;
+        }
+    }
+
+    const GLuint program = compile(ef, stages, sources, useCache);
+    if (program == 0)
+        return 0;
+    if (useCache)
+        store(ef, program, path);
+    const qint64 nsecs = timer.nsecsElapsed();
+    compileTime += nsecs;
+    ++compiledCount;
+    qDebug() << "Shader program" << QFileInfo(stages.front().second).fileName()
+             << "compiled and linked in" << nsecs / 1.0e6 << "ms";
+    return program;
+}
+
+GLuint ShaderCache::load(QOpenGLExtraFunctions *ef, const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QFile::ReadOnly))
+        return 0;
+    const QByteArray data = file.readAll();
+    if (data.size() <= headerSize || std::memcmp(data.constData(), magic, 8) != 0)
+        return 0;
+    quint32 format;
+    std::memcpy(&format, data.constData() + 8, sizeof(format));
+
+    GLuint program = ef->glCreateProgram();
+    ef->glProgramBinary(program, GLenum(format), data.constData() + headerSize, GLsizei(data.size() - headerSize));
+    GLint linked = GL_FALSE;
+    ef->glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (!linked)
+    {
+        // sürücü bu ikiliyi artık kabul etmiyor; kaynaktan derlenip üzerine yazılacak
+        qDebug() << "Shader cache entry" << QFileInfo(path).fileName() << "rejected by the driver";
+        ef->glDeleteProgram(program);
+        return 0;
+    }
+    return program;
+}
+
+GLuint ShaderCache::compile(QOpenGLExtraFunctions *ef, const Stages &stages, const std::vector<QByteArray> &sources,
+                            bool retrievable)
+{
+    GLuint program = ef->glCreateProgram();
+    for (size_t i = 0; i < stages.size(); ++i)
+    {
+        const char *text = sources[i].constData();
+        GLuint shader = ef->glCreateShader(stages[i].first);
+        ef->glShaderSource(shader, 1, &text, nullptr);
+        ef->glCompileShader(shader);
+        GLint compiled = GL_FALSE;
+        ef->glGetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
+        if (!compiled)
+        {
+            char log[1024];
+            ef->glGetShaderInfoLog(shader, sizeof(log), nullptr, log);
+            qDebug() << "Compiling" << stages[i].second << "failed:" << log;
+            ef->glDeleteShader(shader);
+            ef->glDeleteProgram(program);
+            return 0;
+        }
+        ef->glAttachShader(program, shader);
+        // program bağlandıktan sonra silinir
+        ef->glDeleteShader(shader);
+    }
+
+    // bazı sürücüler ikiliyi yalnızca bağlamadan önce istenirse saklar
+    if (retrievable)
+        ef->glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    ef->glLinkProgram(program);
+    GLint linked = GL_FALSE;
+    ef->glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (!linked)
+    {
+        char log[1024];
+        ef->glGetProgramInfoLog(program, sizeof(log), nullptr, log);
+        qDebug() << "Linking" << stages.front().second << "failed:" << log;
+        ef->glDeleteProgram(program);
+        return 0;
+    }
+    return program;
+}
+
+void ShaderCache::store(QOpenGLExtraFunctions *ef, GLuint program, const QString &path)
+{
+    GLint length = 0;
+    ef->glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+        return;
+
+    QByteArray data(headerSize + length, Qt::Uninitialized);
+    GLenum format = 0;
+    ef->glGetProgramBinary(program, length, nullptr, &format, data.data() + headerSize);
+    const quint32 storedFormat = format;
+    std::memcpy(data.data(), magic, 8);
+    std::memcpy(data.data() + 8, &storedFormat, sizeof(storedFormat));
+
+    // yarım yazılmış dosya bırakmamak için QSaveFile
+    QDir().mkpath(cacheDirectory);
+    QSaveFile file(path);
+    if (!file.open(QFile::WriteOnly) || file.write(data) != data.size() || !file.commit())
+        qDebug() << "Cannot write shader cache entry" << path;
+}
@@ -0,0 +1,49 @@
+#ifndef SHADERCACHE_H
+#define SHADERCACHE_H
+
+#include <QByteArray>
+#include <QOpenGLExtraFunctions>
+#include <QString>
+
+#include <utility>
+#include <vector>
+
+// Bağlanmış (link) shader programlarının diskteki ikili kopyaları (glGetProgramBinary).
+// Anahtar tüm aşamaların kaynak özeti ile sürücü ve GPU adıdır; kaynak ya da sürücü
+// değişince eski dosya kullanılmaz. Sonraki açılışlarda derleme ve bağlama atlanır.
+// Sürücü ikiliyi reddederse (ör. güncelleme sonrası) kaynaktan derlenip dosya yenilenir.
+class ShaderCache
+{
+public:
+    // aşama türü (GL_VERTEX_SHADER, ...) ve kaynak dosyası (ör. ":simple.vert")
+    using Stages = std::vector<std::pair<GLenum, QString>>;
+
+    // GNSSIS_SHADER_CACHE başka bir klasör seçer, "off" önbelleği kapatır
+    static QString directory();
+    // kaynak dosyanın içeriği; okunamazsa boş
+    static QByteArray readSource(const QString &fileName);
+
+    // bağlam current olmalı; hata olursa 0
+    GLuint build(QOpenGLExtraFunctions *ef, const Stages &stages);
+
+    // bu nesneyle kurulan programlar: önbellekten yüklenen ve derlenen sayısı, harcanan süre
+    int loadedPrograms() const { return loadedCount; }
+    int compiledPrograms() const { return compiledCount; }
+    qint64 loadNsecs() const { return loadTime; }
+    qint64 compileNsecs() const { return compileTime; }
+
+private:
+    bool enabled(QOpenGLExtraFunctions *ef);
+    QByteArray key(QOpenGLExtraFunctions *ef, const Stages &stages, const std::vector<QByteArray> &sources) const;
+    GLuint load(QOpenGLExtraFunctions *ef, const QString &path);
+    GLuint compile(QOpenGLExtraFunctions *ef, const Stages &stages, const std::vector<QByteArray> &sources, bool retrievable);
+    void store(QOpenGLExtraFunctions *ef, GLuint program, const QString &path);
+
+    // -1: henüz bakılmadı
+    int binaryFormats = -1;
+    QString cacheDirectory;
+    int loadedCount = 0, compiledCount = 0;
+    qint64 loadTime = 0, compileTime = 0;
+};
+
+#endif // SHADERCACHE_H
@@ -0,0 +1,54 @@
+#include "simdmath.h"
+#include "simdsincos.h"
+
+SimdMath::Variant SimdMath::best()
+{
+    if (isSupported(Avx2))
+        return Avx2;
+    if (isSupported(Sse))
+        return Sse;
+    if (isSupported(Neon))
+        return Neon;
+    return Scalar;
+}
+
+bool SimdMath::isSupported(Variant variant)
+{
+    switch (variant)
+    {
+    case Scalar:
+        return true;
+#if defined(GNSSIS_SIMD_X86)
+    case Sse:
+        return true;
+    case Avx2:
+    {
+#if defined(_MSC_VER)
+        // AVX2 (7/EBX bit 5), FMA (1/ECX bit 12) ve işletim sisteminin YMM kayıtlarını saklaması
+        int info[4];
+        __cpuid(info, 1);
+        const bool fma = (info[2] & (1 << 12)) != 0;
+        const bool osxsave = (info[2] & (1 << 27)) != 0;
+        __cpuidex(info, 7, 0);
+        const bool avx2 = (info[1] & (1 << 5)) != 0;
+        return fma && avx2 && osxsave && (_xgetbv(0) & 6) == 6;
+#else
+        static const bool supported = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+        return supported;
+#endif
+    }
+#endif
+#if defined(GNSSIS_SIMD_NEON)
+    case Neon:
+        return true;
+#endif
+    default:
+        return false;
+    }
+}
+
+const char *SimdMath::name(Variant variant)
+{
+    static const char *const names[] = { "scalar", "sse", "avx2", "neon" };
+    return names[variant];
+}
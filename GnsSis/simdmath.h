@@ -0,0 +1,16 @@
+#ifndef SIMDMATH_H
+#define SIMDMATH_H
+
+// Toplu hesap çekirdeklerinin (ModelMatrixKernel, KeplerSolver) ortak SIMD sürüm seçimi.
+// x86'da SSE2 her zaman vardır, AVX2 (+FMA) çalışırken denetlenir; NEON yalnızca AArch64.
+namespace SimdMath
+{
+enum Variant { Scalar, Sse, Avx2, Neon };
+
+// bu işlemcide çalışabilen en hızlı sürüm
+Variant best();
+bool isSupported(Variant variant);
+const char *name(Variant variant);
+}
+
+#endif // SIMDMATH_H
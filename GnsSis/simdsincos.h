@@ -0,0 +1,125 @@
+#ifndef SIMDSINCOS_H
+#define SIMDSINCOS_H
+
+// SimdMath çekirdeklerinin ortak iç yardımcıları; yalnızca .cpp dosyalarından eklenir.
+// sin/cos: açı pi/2 katlarına indirgenir (Cody-Waite), [-pi/4, pi/4] aralığında polinom.
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define GNSSIS_SIMD_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define GNSSIS_TARGET_AVX2
+#else
+#define GNSSIS_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#endif
+#endif
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+#define GNSSIS_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+namespace SimdMath {
+
+const float degreesToRadians = 0.0174532925199432958f;
+const float twoOverPi = 0.636619772367581343f;
+
+// pi/2'nin üç parçası (Cody-Waite); büyük açılarda indirgeme hatasını küçük tutar
+const float halfPi1 = 1.5703125f;
+const float halfPi2 = 4.837512969970703125e-4f;
+const float halfPi3 = 7.54978995489188216e-8f;
+
+// [-pi/4, pi/4] aralığında sin ve cos polinomları
+const float sin1 = -1.6666654611e-1f, sin2 = 8.3321608736e-3f, sin3 = -1.9515295891e-4f;
+const float cos1 = 4.166664568298827e-2f, cos2 = -1.388731625493765e-3f, cos3 = 2.443315711809948e-5f;
+
+#if defined(GNSSIS_SIMD_X86)
+// x radyan; açı pi/2 katlarına indirgenir, çeyreğe göre sin/cos yer ve işaret değiştirir
+inline void sinCos4(__m128 x, __m128 &s, __m128 &c)
+{
+    const __m128i j = _mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(twoOverPi)));
+    const __m128 jf = _mm_cvtepi32_ps(j);
+    __m128 y = _mm_sub_ps(x, _mm_mul_ps(jf, _mm_set1_ps(halfPi1)));
+    y = _mm_sub_ps(y, _mm_mul_ps(jf, _mm_set1_ps(halfPi2)));
+    y = _mm_sub_ps(y, _mm_mul_ps(jf, _mm_set1_ps(halfPi3)));
+    const __m128 z = _mm_mul_ps(y, y);
+
+    __m128 sp = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(sin3), z), _mm_set1_ps(sin2));
+    sp = _mm_add_ps(_mm_mul_ps(sp, z), _mm_set1_ps(sin1));
+    sp = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(sp, z), y), y);
+
+    __m128 cp = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(cos3), z), _mm_set1_ps(cos2));
+    cp = _mm_add_ps(_mm_mul_ps(cp, z), _mm_set1_ps(cos1));
+    cp = _mm_mul_ps(_mm_mul_ps(cp, z), z);
+    cp = _mm_add_ps(_mm_sub_ps(cp, _mm_mul_ps(_mm_set1_ps(0.5f), z)), _mm_set1_ps(1.0f));
+
+    const __m128i one = _mm_set1_epi32(1), two = _mm_set1_epi32(2);
+    const __m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(j, one), one));
+    const __m128 sinSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(j, two), 30));
+    const __m128 cosSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(j, one), two), 30));
+
+    s = _mm_xor_ps(_mm_or_ps(_mm_and_ps(swap, cp), _mm_andnot_ps(swap, sp)), sinSign);
+    c = _mm_xor_ps(_mm_or_ps(_mm_and_ps(swap, sp), _mm_andnot_ps(swap, cp)), cosSign);
+}
+
+GNSSIS_TARGET_AVX2 inline void sinCos8(__m256 x, __m256 &s, __m256 &c)
+{
+    const __m256i j = _mm256_cvtps_epi32(_mm256_mul_ps(x, _mm256_set1_ps(twoOverPi)));
+    const __m256 jf = _mm256_cvtepi32_ps(j);
+    __m256 y = _mm256_fnmadd_ps(jf, _mm256_set1_ps(halfPi1), x);
+    y = _mm256_fnmadd_ps(jf, _mm256_set1_ps(halfPi2), y);
+    y = _mm256_fnmadd_ps(jf, _mm256_set1_ps(halfPi3), y);
+    const __m256 z = _mm256_mul_ps(y, y);
+
+    __m256 sp = _mm256_fmadd_ps(_mm256_set1_ps(sin3), z, _mm256_set1_ps(sin2));
+    sp = _mm256_fmadd_ps(sp, z, _mm256_set1_ps(sin1));
+    sp = _mm256_fmadd_ps(_mm256_mul_ps(sp, z), y, y);
+
+    __m256 cp = _mm256_fmadd_ps(_mm256_set1_ps(cos3), z, _mm256_set1_ps(cos2));
+    cp = _mm256_fmadd_ps(cp, z, _mm256_set1_ps(cos1));
+    cp = _mm256_mul_ps(_mm256_mul_ps(cp, z), z);
+    cp = _mm256_add_ps(_mm256_fnmadd_ps(_mm256_set1_ps(0.5f), z, cp), _mm256_set1_ps(1.0f));
+
+    const __m256i one = _mm256_set1_epi32(1), two = _mm256_set1_epi32(2);
+    const __m256 swap = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(j, one), one));
+    const __m256 sinSign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(j, two), 30));
+    const __m256 cosSign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(_mm256_add_epi32(j, one), two), 30));
+
+    s = _mm256_xor_ps(_mm256_blendv_ps(sp, cp, swap), sinSign);
+    c = _mm256_xor_ps(_mm256_blendv_ps(cp, sp, swap), cosSign);
+}
+#endif
+
+#if defined(GNSSIS_SIMD_NEON)
+inline void sinCos4(float32x4_t x, float32x4_t &s, float32x4_t &c)
+{
+    const int32x4_t j = vcvtnq_s32_f32(vmulq_n_f32(x, twoOverPi));
+    const float32x4_t jf = vcvtq_f32_s32(j);
+    float32x4_t y = vmlsq_n_f32(x, jf, halfPi1);
+    y = vmlsq_n_f32(y, jf, halfPi2);
+    y = vmlsq_n_f32(y, jf, halfPi3);
+    const float32x4_t z = vmulq_f32(y, y);
+
+    float32x4_t sp = vmlaq_n_f32(vdupq_n_f32(sin2), z, sin3);
+    sp = vmlaq_f32(vdupq_n_f32(sin1), sp, z);
+    sp = vmlaq_f32(y, vmulq_f32(sp, z), y);
+
+    float32x4_t cp = vmlaq_n_f32(vdupq_n_f32(cos2), z, cos3);
+    cp = vmlaq_f32(vdupq_n_f32(cos1), cp, z);
+    cp = vmulq_f32(vmulq_f32(cp, z), z);
+    cp = vaddq_f32(vmlsq_n_f32(cp, z, 0.5f), vdupq_n_f32(1.0f));
+
+    const uint32x4_t q = vreinterpretq_u32_s32(j);
+    const uint32x4_t swap = vceqq_u32(vandq_u32(q, vdupq_n_u32(1)), vdupq_n_u32(1));
+    const uint32x4_t sinSign = vshlq_n_u32(vandq_u32(q, vdupq_n_u32(2)), 30);
+    const uint32x4_t cosSign = vshlq_n_u32(vandq_u32(vaddq_u32(q, vdupq_n_u32(1)), vdupq_n_u32(2)), 30);
+
+    s = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(vbslq_f32(swap, cp, sp)), sinSign));
+    c = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(vbslq_f32(swap, sp, cp)), cosSign));
+}
+#endif
+
+}
+
+#endif // SIMDSINCOS_H
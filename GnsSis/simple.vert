@@ -6,20 +6,28 @@ layout(location = 2) in vec3 aNormCoord;
 layout(location = 3) in vec2 aTexCoord;
 
 
-uniform mat4 translateMatrix;
-uniform mat4 rotateMatrix;
-uniform mat4 scaleMatrix;
-uniform mat4 cameraMatrix;
-uniform mat4 projectionMatrix;
+// cisim başına (instance) veriler; QOpenGLPanel::BodyInstance ile aynı düzen
+struct BodyInstance {
+   mat4 mvp;                 // projection * camera * translate * model * rotate * scale, CPU'da
+   float layer;
+};
+layout(std430, binding = 0) readonly buffer Instances {
+   BodyInstance instances[];
+};
+
+uniform int instanceIndex;   // çizilen cismin tampondaki sırası; çizim başına tek uniform
 out vec3 outColor;
 
 
 out vec3 outNorm;
 out vec2 outTexCoord;
+flat out float outLayer;
 
 void main() {
-   gl_Position = projectionMatrix * cameraMatrix * translateMatrix * rotateMatrix * scaleMatrix *  vec4(position, 1.0);
+   BodyInstance body = instances[instanceIndex];
+   gl_Position = body.mvp * vec4(position, 1.0);
    outColor = color;
    outNorm = aNormCoord;
    outTexCoord = aTexCoord;
+   outLayer = body.layer;
 }
@@ -0,0 +1,104 @@
+#include "simulationclock.h"
+
+#include <QtGlobal>
+
+#include <cmath>
+
+SimulationClock::SimulationClock(double ticksPerSecond)
+{
+    lastNs = 0;
+    baseNs = 0;
+    baseTime = 0.0;
+    currentTime = 0.0;
+    lastTick = 0.0;
+    scale = 1.0;
+    paused = true;
+    setTickRate(ticksPerSecond);
+}
+
+void SimulationClock::setTickRate(double ticksPerSecond)
+{
+    rebase();
+    tickNs = qMax<qint64>(1, qint64(1.0e9 / ticksPerSecond));
+}
+
+double SimulationClock::tickRate() const
+{
+    return 1.0e9 / double(tickNs);
+}
+
+void SimulationClock::setTimeScale(double timeScale)
+{
+    rebase();
+    scale = timeScale;
+}
+
+void SimulationClock::setTime(double ticks)
+{
+    baseTime = ticks;
+    baseNs = lastNs;
+    currentTime = ticks;
+    lastTick = std::floor(ticks);
+}
+
+void SimulationClock::rebase()
+{
+    // bundan sonraki süre yeni hızla (ya da adım süresiyle) ölçülür
+    baseTime = currentTime;
+    baseNs = lastNs;
+}
+
+void SimulationClock::start()
+{
+    // simülasyon zamanı korunur; baştan almak için setTime(0)
+    timer.start();
+    lastNs = 0;
+    paused = false;
+    setTime(currentTime);
+}
+
+void SimulationClock::pause()
+{
+    if (paused)
+        return;
+    advance();
+    paused = true;
+}
+
+void SimulationClock::resume()
+{
+    if (!timer.isValid())
+    {
+        start();
+        return;
+    }
+    // duraklatılan süre simülasyona eklenmez
+    const qint64 now = timer.nsecsElapsed();
+    baseNs += now - lastNs;
+    lastNs = now;
+    paused = false;
+}
+
+int SimulationClock::advance()
+{
+    if (paused)
+        return 0;
+
+    // takılmada maxTicksPerAdvance adımdan uzun gerçek süre yok sayılır
+    const qint64 now = timer.nsecsElapsed();
+    const qint64 limit = maxTicksPerAdvance * tickNs;
+    if (now - lastNs > limit)
+        baseNs += now - lastNs - limit;
+    lastNs = now;
+
+    currentTime = baseTime + scale * double(now - baseNs) / double(tickNs);
+    const double tick = std::floor(currentTime);
+    const double ticks = tick - lastTick;
+    lastTick = tick;
+    return int(qBound(-1.0e9, ticks, 1.0e9));
+}
+
+float SimulationClock::alpha() const
+{
+    return float(currentTime - lastTick);
+}
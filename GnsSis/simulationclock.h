@@ -0,0 +1,55 @@
+#ifndef SIMULATIONCLOCK_H
+#define SIMULATIONCLOCK_H
+
+#include <QElapsedTimer>
+
+// Simülasyonu gerçek geçen süreye göre sabit adımlarla (tick) ilerletir.
+// Çizim kaç karede bir gelirse gelsin adım sayısı saniyede tickRate olur;
+// alpha() son adımdan bu yana geçen süreyi adım oranı olarak verir (ara değerleme için).
+// time() simülasyon zamanını double olarak adım cinsinden verir. Zaman her çağrıda son
+// hız değişikliğinden bu yana geçen gerçek süreden yeniden hesaplanır (biriktirilmez);
+// timeScale ile hızlandırılabilir, negatif ölçekle geri akar, setTime ile herhangi bir ana atlanır.
+class SimulationClock
+{
+public:
+    // uzun bir takılmadan sonra simülasyonun yetişmeye çalışırken kilitlenmemesi için
+    // advance() en çok bu kadar adımlık gerçek süre sayar
+    static const int maxTicksPerAdvance = 10;
+
+    explicit SimulationClock(double ticksPerSecond = 60.0);
+
+    void setTickRate(double ticksPerSecond);
+    double tickRate() const;
+    // gerçek adım başına simülasyon adımı; 1 gerçek zaman, -1 geri, 1e6 hızlı ileri
+    void setTimeScale(double scale);
+    double timeScale() const { return scale; }
+    // simülasyon zamanını ticks adımına taşır; atlanan adımlar advance()'ta sayılmaz
+    void setTime(double ticks);
+
+    // simülasyon zamanını sıfırlamaz
+    void start();
+    void pause();
+    void resume();
+    bool isPaused() const { return paused; }
+
+    // son çağrıdan bu yana geçilen tam adım sayısı; zaman geri akıyorsa negatif
+    int advance();
+    float alpha() const;
+    // son advance() anındaki simülasyon zamanı (adım)
+    double time() const { return currentTime; }
+
+private:
+    void rebase();
+
+    QElapsedTimer timer;
+    qint64 lastNs;
+    qint64 baseNs;          // baseTime'ın geçerli olduğu gerçek an
+    double baseTime;
+    double currentTime;
+    double lastTick;        // currentTime'ın altındaki son tam adım
+    double scale;
+    qint64 tickNs;
+    bool paused;
+};
+
+#endif // SIMULATIONCLOCK_H
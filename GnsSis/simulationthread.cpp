@@ -0,0 +1,90 @@
+#include "simulationthread.h"
+#include "simulationclock.h"
+
+#include <QElapsedTimer>
+#include <QMutexLocker>
+
+SimulationThread::~SimulationThread()
+{
+    stop();
+}
+
+void SimulationThread::start(StepFunction step)
+{
+    stop();
+    stepFunction = std::move(step);
+    stopping = false;
+    hasPending = false;
+    thread.reset(QThread::create([this]() { run(); }));
+    thread->setObjectName("Simulation");
+    thread->start();
+}
+
+void SimulationThread::stop()
+{
+    if (!thread)
+        return;
+    {
+        QMutexLocker locker(&mutex);
+        stopping = true;
+        requested.wakeAll();
+    }
+    thread->wait();
+    thread.reset();
+}
+
+void SimulationThread::request(const Request &request)
+{
+    QMutexLocker locker(&mutex);
+    // birikmiş adımlar da saatin sınırını aşmaz; fazlası atılır, yoksa yavaş bir adım
+    // sonrakini daha da uzatır
+    const int maxTicks = SimulationClock::maxTicksPerAdvance;
+    const int ticks = qBound(-maxTicks, hasPending ? pending.ticks + request.ticks : request.ticks, maxTicks);
+    const bool resetSweep = hasPending && pending.resetSweep;
+    pending = request;
+    pending.ticks = ticks;
+    pending.resetSweep = pending.resetSweep || resetSweep;
+    hasPending = true;
+    requested.wakeAll();
+}
+
+bool SimulationThread::acquire()
+{
+    return buffer.acquire();
+}
+
+void SimulationThread::waitForSnapshot()
+{
+    // yazar yayınladıktan sonra kilidi alıp uyandırır; uyanma kaybolmaz
+    QMutexLocker locker(&mutex);
+    while (!buffer.acquire() && thread)
+        published.wait(&mutex);
+}
+
+void SimulationThread::run()
+{
+    QElapsedTimer timer;
+    for (;;)
+    {
+        Request request;
+        {
+            QMutexLocker locker(&mutex);
+            while (!hasPending && !stopping)
+                requested.wait(&mutex);
+            if (stopping)
+                return;
+            request = pending;
+            hasPending = false;
+        }
+
+        timer.start();
+        Snapshot &snapshot = buffer.back();
+        stepFunction(request, snapshot);
+        snapshot.time = request.time;
+        snapshot.stepNsecs = timer.nsecsElapsed();
+        buffer.publish();
+
+        QMutexLocker locker(&mutex);
+        published.wakeAll();
+    }
+}
@@ -0,0 +1,76 @@
+#ifndef SIMULATIONTHREAD_H
+#define SIMULATIONTHREAD_H
+
+#include <QMutex>
+#include <QThread>
+#include <QWaitCondition>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "collisiondetector.h"
+#include "triplebuffer.h"
+
+// Simülasyonu (açılar, Kepler çözümü, matrisler, N-body adımları, çarpışmalar) GUI iş
+// parçacığından ayırır. GUI her karede istenen simülasyon zamanını request() ile bırakır
+// ve hiç beklemeden acquire() ile son tamamlanan anlık görüntüyü (snapshot) alır; ağır bir
+// adım olay döngüsünü ve çizimi durdurmaz, yalnızca çizilen durum bir iki kare eskir.
+// Anlık görüntüler kilitsiz bir üçlü tamponla (TripleBuffer) aktarılır; istek tarafı
+// küçük olduğu için kısa bir kilit kullanır. GUI'den değiştirilebilen ayarlar da isteğe
+// kopyalanır; adım fonksiyonu GUI'nin üyelerini okumaz.
+class SimulationThread
+{
+public:
+    struct Request {
+        double time;        // ulaşılacak simülasyon zamanı (adım)
+        int ticks;          // son istekten bu yana geçilen tam adım (N-body integrasyonu)
+        float alpha;        // son adımdan bu yana geçen adım oranı
+        float bodyScale;    // geometriye uygulanan kullanıcı ölçeği (çarpışma yarıçapları)
+        bool resetSweep;    // zamanda atlandı; çarpışma süpürmesi yeniden başlar
+        bool nbody;         // N-body integrasyonu; aksi halde Kepler yörüngeleri
+        bool detectCollisions;
+        CollisionDetector::Response collisionResponse;
+    };
+    // değiştirilmez; okur yuvayı acquire'dan sonraki acquire'a kadar tek başına kullanır
+    struct Snapshot {
+        double time = 0.0;
+        std::vector<float> models;      // BodyStore::modelData düzeninde
+        std::vector<float> scale;       // yalnızca scaleVersion değişince kopyalanır
+        quint64 scaleVersion = 0;
+        qint64 stepNsecs = 0;           // bu durumu üreten adımın süresi
+        qint64 stepStarted = 0;         // StepFunction'ın yazdığı başlangıç anı (ör. profilci saati)
+    };
+    // iş parçacığında çalışır: isteği uygular ve back yuvasını doldurur
+    using StepFunction = std::function<void(const Request &request, Snapshot &snapshot)>;
+
+    ~SimulationThread();
+
+    void start(StepFunction step);
+    // bekleyen adımı bitirip iş parçacığını durdurur
+    void stop();
+    bool isRunning() const { return thread != nullptr; }
+
+    // bir önceki istek henüz alınmadıysa birleştirilir: adımlar toplanır, zaman en yenisi
+    void request(const Request &request);
+    // yeni bir anlık görüntü varsa snapshot()'a alır; beklemez
+    bool acquire();
+    // ilk anlık görüntü için (açılışta)
+    void waitForSnapshot();
+    Snapshot &snapshot() { return buffer.front(); }
+
+private:
+    void run();
+
+    StepFunction stepFunction;
+    TripleBuffer<Snapshot> buffer;
+    std::unique_ptr<QThread> thread;
+
+    QMutex mutex;
+    QWaitCondition requested, published;
+    Request pending = { 0.0, 0, 1.0f, 1.0f, false, false, false, CollisionDetector::Flag };
+    bool hasPending = false;
+    bool stopping = false;
+};
+
+#endif // SIMULATIONTHREAD_H
@@ -0,0 +1,42 @@
+#include "spherelod.h"
+
+#include <QtMath>
+
+// kabalaştırma için hata eşiğin bu oranının altında olmalı
+static const float coarsenRatio = 0.5f;
+
+int SphereLod::levelForSegments(int segments)
+{
+    int level = 0;
+    while (level < levelCount - 1 && SphereLod::segments(level) < segments)
+        ++level;
+    return level;
+}
+
+float SphereLod::silhouetteError(float projectedRadius, int level)
+{
+    // kenar ortası ile çember arasındaki uzaklık (sagitta): r * (1 - cos(pi / N))
+    return projectedRadius * (1.0f - std::cos(float(M_PI) / float(segments(level))));
+}
+
+int SphereLod::selectLevel(float projectedRadius, float maxError, int currentLevel)
+{
+    int target = levelCount - 1;
+    for (int level = 0; level < levelCount; ++level)
+    {
+        if (silhouetteError(projectedRadius, level) <= maxError)
+        {
+            target = level;
+            break;
+        }
+    }
+
+    currentLevel = qBound(0, currentLevel, levelCount - 1);
+    if (target >= currentLevel)
+        return target;
+
+    int level = currentLevel;
+    while (level > target && silhouetteError(projectedRadius, level - 1) <= maxError * coarsenRatio)
+        --level;
+    return level;
+}
@@ -0,0 +1,23 @@
+#ifndef SPHERELOD_H
+#define SPHERELOD_H
+
+// Küre ayrıntı seviyeleri (LOD): seviye l, (8 << l) x (8 << l) bölümlü küredir (8..256).
+// Seviye, ekrandaki yarıçapa göre silüet hatası piksel eşiğinin altında kalan en kaba küredir.
+class SphereLod
+{
+public:
+    static const int levelCount = 6;
+
+    static int segments(int level) { return 8 << level; }
+    // verilen bölümlemeye en yakın seviye
+    static int levelForSegments(int segments);
+
+    // N bölümlü çokgen silüetin gerçek çemberden en büyük sapması (piksel)
+    static float silhouetteError(float projectedRadius, int level);
+
+    // inceltme hemen yapılır; kabalaştırma yalnızca kaba seviye eşiğin yarısının
+    // altında kalıyorsa yapılır, böylece sınırdaki cisimler her karede seviye değiştirmez
+    static int selectLevel(float projectedRadius, float maxError, int currentLevel);
+};
+
+#endif // SPHERELOD_H
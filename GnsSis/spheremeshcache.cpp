@@ -0,0 +1,93 @@
+#include "spheremeshcache.h"
+
+#include <QtMath>
+
+const SphereMeshCache::Mesh &SphereMeshCache::get(QOpenGLExtraFunctions *ef, int xSegments, int ySegments)
+{
+    auto found = meshes.find({ xSegments, ySegments });
+    if (found != meshes.end())
+        return found->second;
+
+    std::vector<float> vertices;
+    std::vector<GLuint> indices;
+    build(xSegments, ySegments, vertices, indices);
+
+    Mesh mesh;
+    mesh.indexCount = GLsizei(indices.size());
+    ef->glGenVertexArrays(1, &mesh.vao);
+    ef->glGenBuffers(1, &mesh.vbo);
+    ef->glGenBuffers(1, &mesh.ebo);
+
+    ef->glBindVertexArray(mesh.vao);
+    ef->glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
+    ef->glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+    ef->glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.ebo);
+    ef->glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), indices.data(), GL_STATIC_DRAW);
+
+    const GLsizei stride = 8 * sizeof(float);
+    ef->glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void*)0);
+    ef->glEnableVertexAttribArray(0);
+    ef->glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, stride, (void*)(3 * sizeof(float)));
+    ef->glEnableVertexAttribArray(2);
+    ef->glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, stride, (void*)(6 * sizeof(float)));
+    ef->glEnableVertexAttribArray(3);
+    ef->glBindVertexArray(0);
+
+    return meshes.emplace(std::make_pair(xSegments, ySegments), mesh).first->second;
+}
+
+void SphereMeshCache::build(int xSegments, int ySegments, std::vector<float> &vertices, std::vector<GLuint> &indices)
+{
+    // sin/cos her boylam ve enlem için bir kez hesaplanır, köşe başına değil
+    std::vector<float> cosTheta(xSegments + 1), sinTheta(xSegments + 1);
+    std::vector<float> cosPhi(ySegments + 1), sinPhi(ySegments + 1);
+    for (int x = 0; x <= xSegments; ++x)
+    {
+        const float theta = float(x) / float(xSegments) * 2.0f * float(M_PI);
+        cosTheta[x] = std::cos(theta);
+        sinTheta[x] = std::sin(theta);
+    }
+    for (int y = 0; y <= ySegments; ++y)
+    {
+        const float phi = float(y) / float(ySegments) * float(M_PI);
+        cosPhi[y] = std::cos(phi);
+        sinPhi[y] = std::sin(phi);
+    }
+
+    // köşeler satır satır (enlem), doğrudan son tampona yazılır
+    const int rowLength = xSegments + 1;
+    vertices.resize(size_t(rowLength) * size_t(ySegments + 1) * 8);
+    float *out = vertices.data();
+    for (int y = 0; y <= ySegments; ++y)
+    {
+        for (int x = 0; x <= xSegments; ++x)
+        {
+            const float px = cosTheta[x] * sinPhi[y];
+            const float py = cosPhi[y];
+            const float pz = sinTheta[x] * sinPhi[y];
+
+            // birim kürede normal konumla aynı
+            out[0] = px; out[1] = py; out[2] = pz;
+            out[3] = px; out[4] = py; out[5] = pz;
+            out[6] = float(x) / float(xSegments);
+            out[7] = float(y) / float(ySegments);
+            out += 8;
+        }
+    }
+
+    // her satır çifti bir şerit; tek satırlar ters yönde dolaşılır
+    indices.resize(size_t(stripLength(xSegments, ySegments)));
+    GLuint *index = indices.data();
+    for (int y = 0; y < ySegments; ++y)
+    {
+        const bool oddRow = y % 2 == 1;
+        for (int i = 0; i <= xSegments; ++i)
+        {
+            const int x = oddRow ? xSegments - i : i;
+            const GLuint top = GLuint(y * rowLength + x);
+            const GLuint bottom = GLuint((y + 1) * rowLength + x);
+            *index++ = oddRow ? bottom : top;
+            *index++ = oddRow ? top : bottom;
+        }
+    }
+}
@@ -0,0 +1,34 @@
+#ifndef SPHEREMESHCACHE_H
+#define SPHEREMESHCACHE_H
+
+#include <QOpenGLExtraFunctions>
+
+#include <map>
+#include <utility>
+#include <vector>
+
+// Birim küre mesh'lerini bölümleme (segment sayısı) başına bir kez üretir ve
+// aynı VAO/VBO/EBO'yu isteyen herkese verir. Köşe düzeni shader'larla aynıdır:
+// konum 0 (vec3), normal 2 (vec3), doku koordinatı 3 (vec2); indisler GL_TRIANGLE_STRIP.
+class SphereMeshCache
+{
+public:
+    struct Mesh {
+        GLuint vao, vbo, ebo;
+        GLsizei indexCount;
+    };
+
+    // bağlam current olmalı; ilk istekte mesh üretilip yüklenir
+    const Mesh &get(QOpenGLExtraFunctions *ef, int xSegments, int ySegments);
+    int size() const { return int(meshes.size()); }
+
+    // build() üretecek şeridin indis sayısı
+    static GLsizei stripLength(int xSegments, int ySegments) { return GLsizei(ySegments * (xSegments + 1) * 2); }
+    // köşe başına 8 float: konum, normal, uv
+    static void build(int xSegments, int ySegments, std::vector<float> &vertices, std::vector<GLuint> &indices);
+
+private:
+    std::map<std::pair<int, int>, Mesh> meshes;
+};
+
+#endif // SPHEREMESHCACHE_H
@@ -0,0 +1,20 @@
+#version 430
+in vec3 outColor;
+in vec3 outNorm;
+in vec2 outTexCoord;
+flat in float outLayer;
+
+out vec4 fragColor;
+
+// aynı çözünürlük sınıfındaki tüm yüzeyler tek dizide, katman cisimden gelir
+uniform sampler2DArray texture1;
+
+// doku yüklenene kadar kullanılan düz renk
+const vec3 placeholderColor = vec3(0.35, 0.35, 0.4);
+
+void main() {
+   if (outLayer < 0.0)
+      fragColor = vec4(placeholderColor, 1.0);
+   else
+      fragColor = texture(texture1, vec3(outTexCoord, outLayer));
+}
@@ -0,0 +1,265 @@
+#include "texturearrayloader.h"
+
+#include <QDebug>
+#include <QImageReader>
+#include <QMutexLocker>
+#include <QOpenGLContext>
+
+#include <cstring>
+#include <iterator>
+
+TextureArrayLoader::TextureArrayLoader()
+{
+    // TextureCache::classSize ile aynı sınıflar, büyükten küçüğe
+    classes.push_back({ 4096, 2048, 0, QStringList(), {}, 0, false });
+    classes.push_back({ 2048, 1024, 0, QStringList(), {}, 0, false });
+    classes.push_back({ 1024, 512, 0, QStringList(), {}, 0, false });
+
+    remainingLayers = 0;
+    pixelBuffers[0] = pixelBuffers[1] = 0;
+    nextPixelBuffer = 0;
+}
+
+TextureArrayLoader::~TextureArrayLoader()
+{
+    // henüz başlamamış çözme işlerini iptal et, çalışanları bekle
+    decodePool.clear();
+    decodePool.waitForDone();
+}
+
+TextureArrayLoader::Slot TextureArrayLoader::add(const QString &fileName)
+{
+    // yalnızca başlık okunur, görüntü burada çözülmez
+    QSize size = QImageReader(fileName).size();
+    if (!size.isValid())
+        qDebug() << "Failed to read texture size from" << fileName;
+
+    const int width = TextureCache::classSize(size).width();
+    size_t index = classes.size() - 1;
+    for (size_t i = 0; i < classes.size(); ++i)
+    {
+        if (classes[i].width == width)
+            index = i;
+    }
+
+    ResolutionClass &resolution = classes[index];
+    if (resolution.texture == 0)
+        QOpenGLContext::currentContext()->functions()->glGenTextures(1, &resolution.texture);
+
+    resolution.files.append(fileName);
+    resolution.ready.push_back(false);
+    ++remainingLayers;
+    return { resolution.texture, GLint(resolution.files.size() - 1) };
+}
+
+void TextureArrayLoader::start(QOpenGLExtraFunctions *ef)
+{
+    ef->glGenBuffers(2, pixelBuffers);
+
+    const bool canUseCache = QOpenGLContext::currentContext()->hasExtension("GL_EXT_texture_compression_s3tc");
+    const QString cacheDirectory = TextureCache::directory();
+    int cachedLayers = 0;
+
+    for (size_t c = 0; c < classes.size(); ++c)
+    {
+        ResolutionClass &resolution = classes[c];
+        if (resolution.files.isEmpty())
+            continue;
+
+        const QSize size(resolution.width, resolution.height);
+        const int levels = TextureCache::levelCount(size);
+
+        // sınıf yalnızca tüm katmanların önbelleği güncelse sıkıştırılmış olarak ayrılır
+        std::vector<std::shared_ptr<TextureCache::Entry>> entries;
+        for (int layer = 0; canUseCache && layer < resolution.files.size(); ++layer)
+        {
+            const QString &file = resolution.files[layer];
+            std::shared_ptr<TextureCache::Entry> entry = TextureCache::map(TextureCache::cachePath(file, cacheDirectory),
+                                                                           TextureCache::fingerprint(file), size);
+            if (!entry)
+                break;
+            entries.push_back(entry);
+        }
+        resolution.compressed = canUseCache && int(entries.size()) == resolution.files.size();
+
+        ef->glBindTexture(GL_TEXTURE_2D_ARRAY, resolution.texture);
+        ef->glTexStorage3D(GL_TEXTURE_2D_ARRAY, levels, resolution.compressed ? TextureCache::compressedFormat : GL_RGB8,
+                           resolution.width, resolution.height, GLsizei(resolution.files.size()));
+
+        ef->glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        ef->glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        ef->glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        ef->glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+        if (resolution.compressed)
+        {
+            // önbellekte tüm seviyeler hazır; çözme işi gerekmez
+            QMutexLocker locker(&decodedMutex);
+            for (int layer = 0; layer < resolution.files.size(); ++layer)
+                decoded.push_back({ int(c), layer, QImage(), entries[layer] });
+            cachedLayers += resolution.files.size();
+            continue;
+        }
+
+        // mipmap'ler sınıfın tüm katmanları gelince üretilir; o zamana kadar yalnızca 0. seviye
+        ef->glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, 0);
+
+        for (int layer = 0; layer < resolution.files.size(); ++layer)
+            decodePool.start([this, c, layer]() { decode(int(c), layer); });
+    }
+
+    qDebug() << "Texture cache:" << cachedLayers << "of" << remainingLayers << "surfaces loaded from" << cacheDirectory;
+}
+
+void TextureArrayLoader::decode(int classIndex, int layer)
+{
+    // işçi iş parçacığında çalışır: çözme, yeniden örnekleme ve RGB888 dönüşümü
+    const ResolutionClass &resolution = classes[classIndex];
+
+    QImage image(resolution.files[layer]);
+    if (image.isNull())
+    {
+        qDebug() << "Failed to load texture from" << resolution.files[layer];
+        image = QImage(resolution.width, resolution.height, QImage::Format_RGB888);
+        image.fill(QColor(128, 128, 128));
+    }
+    if (image.width() != resolution.width || image.height() != resolution.height)
+        image = image.scaled(resolution.width, resolution.height, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+
+    DecodedLayer result = { classIndex, layer, image.convertToFormat(QImage::Format_RGB888), nullptr };
+
+    QMutexLocker locker(&decodedMutex);
+    decoded.push_back(result);
+}
+
+int TextureArrayLoader::uploadPending(QOpenGLExtraFunctions *ef, int maxLayers)
+{
+    std::vector<DecodedLayer> batch;
+    {
+        QMutexLocker locker(&decodedMutex);
+        const int count = qMin(maxLayers, int(decoded.size()));
+        batch.assign(decoded.begin(), decoded.begin() + count);
+        decoded.erase(decoded.begin(), decoded.begin() + count);
+    }
+
+    int uploaded = 0;
+    std::vector<DecodedLayer> failed;
+    for (DecodedLayer &layer : batch)
+    {
+        if (uploadLayer(ef, layer))
+            ++uploaded;
+        else
+            failed.push_back(std::move(layer));
+    }
+    if (!failed.empty())
+    {
+        // sıra korunur: yüklenemeyenler kuyruğun başına döner
+        QMutexLocker locker(&decodedMutex);
+        decoded.insert(decoded.begin(), std::make_move_iterator(failed.begin()), std::make_move_iterator(failed.end()));
+    }
+
+    return uploaded;
+}
+
+bool TextureArrayLoader::uploadLayer(QOpenGLExtraFunctions *ef, DecodedLayer &layer)
+{
+    ResolutionClass &resolution = classes[layer.classIndex];
+    const GLsizeiptr size = layer.cached ? GLsizeiptr(layer.cached->payloadSize) : layer.image.sizeInBytes();
+
+    // iki PBO sırayla kullanılır; yeniden ayırmak önceki kopyanın bitmesini beklemeyi önler
+    GLuint pixelBuffer = pixelBuffers[nextPixelBuffer];
+    nextPixelBuffer = 1 - nextPixelBuffer;
+
+    ef->glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pixelBuffer);
+    ef->glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+    uchar *mapped = static_cast<uchar *>(ef->glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size,
+                                                              GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+    bool filled = false;
+    if (mapped)
+    {
+        if (layer.cached)
+        {
+            // seviyeler PBO içinde art arda dizilir
+            size_t offset = 0;
+            for (size_t level = 0; level < layer.cached->levelSizes.size(); ++level)
+            {
+                std::memcpy(mapped + offset, layer.cached->data + layer.cached->levelOffsets[level], layer.cached->levelSizes[level]);
+                offset += layer.cached->levelSizes[level];
+            }
+        }
+        else
+        {
+            std::memcpy(mapped, layer.image.constBits(), size_t(size));
+        }
+        // GL_FALSE: eşleme sırasında içerik bozuldu
+        filled = ef->glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER) == GL_TRUE;
+    }
+    if (!filled)
+    {
+        // PBO'da çöp var; katman yüklenmez, cisim hazır olana kadar düz renkte çizilir
+        ef->glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        if (layer.failedMaps++ == 0)
+            qDebug() << "Cannot map pixel buffer for" << resolution.files[layer.layer] << "- retrying next frame";
+        return false;
+    }
+
+    ef->glBindTexture(GL_TEXTURE_2D_ARRAY, resolution.texture);
+    if (layer.cached)
+    {
+        size_t offset = 0;
+        int width = resolution.width, height = resolution.height;
+        for (size_t level = 0; level < layer.cached->levelSizes.size(); ++level)
+        {
+            ef->glCompressedTexSubImage3D(GL_TEXTURE_2D_ARRAY, GLint(level), 0, 0, layer.layer, width, height, 1,
+                                          TextureCache::compressedFormat, GLsizei(layer.cached->levelSizes[level]),
+                                          reinterpret_cast<const void *>(offset));
+            offset += layer.cached->levelSizes[level];
+            width = qMax(1, width / 2);
+            height = qMax(1, height / 2);
+        }
+    }
+    else
+    {
+        ef->glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer.layer, resolution.width, resolution.height, 1,
+                            GL_RGB, GL_UNSIGNED_BYTE, nullptr);
+    }
+    ef->glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    resolution.ready[layer.layer] = true;
+    --remainingLayers;
+
+    if (++resolution.readyCount == resolution.files.size() && !resolution.compressed)
+    {
+        const int levels = TextureCache::levelCount(QSize(resolution.width, resolution.height));
+        ef->glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, levels - 1);
+        ef->glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+    }
+    return true;
+}
+
+void TextureArrayLoader::finish(QOpenGLExtraFunctions *ef)
+{
+    decodePool.waitForDone();
+    uploadPending(ef, remainingLayers);
+}
+
+bool TextureArrayLoader::isReady(GLuint texture, GLint layer) const
+{
+    if (remainingLayers == 0)
+        return true;
+
+    for (const ResolutionClass &resolution : classes)
+    {
+        if (resolution.texture == texture)
+            return resolution.ready[layer];
+    }
+    return false;
+}
+
+int TextureArrayLoader::arrayCount() const
+{
+    int count = 0;
+    for (const ResolutionClass &resolution : classes)
+        count += resolution.files.isEmpty() ? 0 : 1;
+    return count;
+}
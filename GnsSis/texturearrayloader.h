@@ -0,0 +1,83 @@
+#ifndef TEXTUREARRAYLOADER_H
+#define TEXTUREARRAYLOADER_H
+
+#include <QOpenGLExtraFunctions>
+#include <QImage>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+#include <QThreadPool>
+
+#include <memory>
+#include <vector>
+
+#include "texturecache.h"
+
+// Gezegen ve uydu yüzeylerini çözünürlük sınıflarına ayırıp her sınıfı tek bir
+// GL_TEXTURE_2D_ARRAY içine yeniden örnekler. Cisim, dokusunu (dizi, katman)
+// çifti olarak alır; böylece bir karede her dizi yalnızca bir kez bağlanır.
+//
+// Görüntüler iş parçacığı havuzunda çözülür ve dönüştürülür; GUI iş parçacığı
+// hazır olanları her karede pixel buffer object üzerinden katmanlara yükler.
+// Bir sınıfın tüm katmanları için güncel sıkıştırılmış önbellek (TextureCache)
+// varsa o sınıf hiç çözülmez, BC1 verisi eşlenen dosyadan yüklenir.
+class TextureArrayLoader
+{
+public:
+    struct Slot {
+        GLuint texture;
+        GLint layer;
+    };
+
+    TextureArrayLoader();
+    ~TextureArrayLoader();
+
+    // dosyayı boyutuna göre bir sınıfa ekler; GL dokusu start() ile ayrılır
+    Slot add(const QString &fileName);
+    // dizileri ayırır ve çözme işlerini başlatır
+    void start(QOpenGLExtraFunctions *ef);
+    // çözülmüş en fazla maxLayers katmanı yükler, yüklenen sayıyı döndürür; PBO eşlenemezse
+    // katman kuyrukta kalır ve sonraki çağrıda yeniden denenir (o zamana kadar düz renk)
+    int uploadPending(QOpenGLExtraFunctions *ef, int maxLayers);
+    // tüm işlerin bitmesini bekleyip kalan katmanları yükler
+    void finish(QOpenGLExtraFunctions *ef);
+
+    bool isReady(GLuint texture, GLint layer) const;
+    bool isComplete() const { return remainingLayers == 0; }
+    int arrayCount() const;
+
+private:
+    struct ResolutionClass {
+        int width, height;
+        GLuint texture;
+        QStringList files;
+        std::vector<bool> ready;
+        int readyCount;
+        bool compressed;
+    };
+    struct DecodedLayer {
+        int classIndex;
+        int layer;
+        QImage image;
+        std::shared_ptr<TextureCache::Entry> cached;
+        int failedMaps = 0;
+    };
+
+    void decode(int classIndex, int layer);
+    bool uploadLayer(QOpenGLExtraFunctions *ef, DecodedLayer &decoded);
+
+    std::vector<ResolutionClass> classes;
+    int remainingLayers;
+
+    // işçi iş parçacıklarının doldurduğu kuyruk
+    QMutex decodedMutex;
+    std::vector<DecodedLayer> decoded;
+
+    GLuint pixelBuffers[2];
+    int nextPixelBuffer;
+
+    // son üye olduğu için ilk yok edilir; kuyruğa yazan işler bitmeden diğer üyeler silinmez
+    QThreadPool decodePool;
+};
+
+#endif // TEXTUREARRAYLOADER_H
@@ -0,0 +1,324 @@
+#include "texturecache.h"
+
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QtMath>
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+namespace {
+
+const uchar ktxIdentifier[12] = { 0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n' };
+const char fingerprintKey[] = "GnsSis.source";
+const int headerSize = 12 + 13 * 4;
+
+size_t levelByteSize(int width, int height)
+{
+    // BC1: 4x4 blok başına 8 bayt
+    return size_t(qMax(1, (width + 3) / 4)) * size_t(qMax(1, (height + 3) / 4)) * 8;
+}
+
+quint32 readU32(const uchar *p)
+{
+    quint32 value;
+    std::memcpy(&value, p, 4);
+    return value;
+}
+
+void appendU32(QByteArray &out, quint32 value)
+{
+    out.append(reinterpret_cast<const char *>(&value), 4);
+}
+
+quint16 packRGB565(const int rgb[3])
+{
+    return quint16(((rgb[0] * 31 + 127) / 255) << 11 | ((rgb[1] * 63 + 127) / 255) << 5 | ((rgb[2] * 31 + 127) / 255));
+}
+
+void unpackRGB565(quint16 c, int rgb[3])
+{
+    int r = (c >> 11) & 31, g = (c >> 5) & 63, b = c & 31;
+    rgb[0] = (r << 3) | (r >> 2);
+    rgb[1] = (g << 2) | (g >> 4);
+    rgb[2] = (b << 3) | (b >> 2);
+}
+
+// 4x4 bloğu BC1'e sıkıştırır: sınır kutusunun köşegeni uç renkler olarak seçilir,
+// köşegen yönü kanal kovaryansına göre çevrilir
+void compressBlock(const uchar pixels[16][3], uchar out[8])
+{
+    int minColor[3] = { 255, 255, 255 }, maxColor[3] = { 0, 0, 0 };
+    int mean[3] = { 0, 0, 0 };
+    for (int i = 0; i < 16; ++i)
+    {
+        for (int c = 0; c < 3; ++c)
+        {
+            minColor[c] = qMin(minColor[c], int(pixels[i][c]));
+            maxColor[c] = qMax(maxColor[c], int(pixels[i][c]));
+            mean[c] += pixels[i][c];
+        }
+    }
+
+    // referans kanal: en geniş aralıklı kanal
+    int reference = 0;
+    for (int c = 1; c < 3; ++c)
+        if (maxColor[c] - minColor[c] > maxColor[reference] - minColor[reference])
+            reference = c;
+
+    for (int c = 0; c < 3; ++c)
+    {
+        if (c == reference)
+            continue;
+        int covariance = 0;
+        for (int i = 0; i < 16; ++i)
+            covariance += (pixels[i][reference] * 16 - mean[reference]) * (pixels[i][c] * 16 - mean[c]);
+        if (covariance < 0)
+            std::swap(minColor[c], maxColor[c]);
+    }
+
+    // uçları 1/16 içeri çek, dış piksellere göre hatayı azaltır
+    for (int c = 0; c < 3; ++c)
+    {
+        int inset = (maxColor[c] - minColor[c]) / 16;
+        maxColor[c] = qBound(0, maxColor[c] - inset, 255);
+        minColor[c] = qBound(0, minColor[c] + inset, 255);
+    }
+
+    quint16 color0 = packRGB565(maxColor);
+    quint16 color1 = packRGB565(minColor);
+    if (color0 < color1)
+        std::swap(color0, color1);
+
+    int palette[4][3];
+    unpackRGB565(color0, palette[0]);
+    unpackRGB565(color1, palette[1]);
+    for (int c = 0; c < 3; ++c)
+    {
+        palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+        palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+    }
+
+    quint32 indices = 0;
+    if (color0 != color1)
+    {
+        for (int i = 0; i < 16; ++i)
+        {
+            int best = 0, bestDistance = INT_MAX;
+            for (int p = 0; p < 4; ++p)
+            {
+                int dr = pixels[i][0] - palette[p][0];
+                int dg = pixels[i][1] - palette[p][1];
+                int db = pixels[i][2] - palette[p][2];
+                int distance = dr * dr + dg * dg + db * db;
+                if (distance < bestDistance)
+                {
+                    bestDistance = distance;
+                    best = p;
+                }
+            }
+            indices |= quint32(best) << (2 * i);
+        }
+    }
+
+    std::memcpy(out, &color0, 2);
+    std::memcpy(out + 2, &color1, 2);
+    std::memcpy(out + 4, &indices, 4);
+}
+
+}
+
+QSize TextureCache::classSize(const QSize &source)
+{
+    // dokular eşdikdörtgen (2:1) haritalar; 8k güneş kendi sınıfında kalır
+    static const int classWidths[] = { 4096, 2048, 1024 };
+    for (int width : classWidths)
+    {
+        if (source.width() >= width)
+            return QSize(width, width / 2);
+    }
+    return QSize(1024, 512);
+}
+
+int TextureCache::levelCount(const QSize &size)
+{
+    return 1 + qFloor(std::log2(qMax(size.width(), size.height())));
+}
+
+QByteArray TextureCache::fingerprint(const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QFile::ReadOnly))
+        return QByteArray();
+
+    const qint64 chunk = 64 * 1024;
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(QByteArray::number(file.size()));
+    hash.addData(file.read(chunk));
+    if (file.size() > chunk)
+    {
+        file.seek(qMax(chunk, file.size() - chunk));
+        hash.addData(file.read(chunk));
+    }
+    return hash.result().toHex();
+}
+
+QString TextureCache::directory()
+{
+    // GNSSIS_TEXTURE_CACHE başka bir klasör seçer; varsayılan çalıştırılabilir dosyanın yanı
+    QString dir = qEnvironmentVariable("GNSSIS_TEXTURE_CACHE");
+    if (dir.isEmpty())
+        dir = QCoreApplication::applicationDirPath() + "/texturecache";
+    return dir;
+}
+
+QString TextureCache::cachePath(const QString &sourceFile, const QString &cacheDirectory)
+{
+    return cacheDirectory + "/" + QFileInfo(sourceFile).completeBaseName() + ".ktx";
+}
+
+bool TextureCache::write(const QString &path, const QImage &image, const QByteArray &sourceFingerprint)
+{
+    QImage level = image.convertToFormat(QImage::Format_RGB888);
+    const int levels = levelCount(level.size());
+
+    QByteArray keyValue(fingerprintKey, sizeof(fingerprintKey));
+    keyValue.append(sourceFingerprint);
+    QByteArray keyValueData;
+    appendU32(keyValueData, quint32(keyValue.size()));
+    keyValueData.append(keyValue);
+    while (keyValueData.size() % 4)
+        keyValueData.append('\0');
+
+    QByteArray out(reinterpret_cast<const char *>(ktxIdentifier), 12);
+    appendU32(out, 0x04030201);             // endianness
+    appendU32(out, 0);                      // glType: sıkıştırılmış
+    appendU32(out, 1);                      // glTypeSize
+    appendU32(out, 0);                      // glFormat: sıkıştırılmış
+    appendU32(out, compressedFormat);
+    appendU32(out, GL_RGB);                 // glBaseInternalFormat
+    appendU32(out, quint32(level.width()));
+    appendU32(out, quint32(level.height()));
+    appendU32(out, 0);                      // pixelDepth
+    appendU32(out, 0);                      // numberOfArrayElements
+    appendU32(out, 1);                      // numberOfFaces
+    appendU32(out, quint32(levels));
+    appendU32(out, quint32(keyValueData.size()));
+    out.append(keyValueData);
+
+    for (int i = 0; i < levels; ++i)
+    {
+        QByteArray blocks;
+        compressBC1(level, blocks);
+        appendU32(out, quint32(blocks.size()));
+        out.append(blocks);
+
+        level = level.scaled(qMax(1, level.width() / 2), qMax(1, level.height() / 2),
+                             Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    }
+
+    QSaveFile file(path);
+    if (!file.open(QFile::WriteOnly))
+        return false;
+    file.write(out);
+    return file.commit();
+}
+
+std::unique_ptr<TextureCache::Entry> TextureCache::map(const QString &path, const QByteArray &sourceFingerprint, const QSize &size)
+{
+    std::unique_ptr<Entry> entry(new Entry);
+    entry->file.reset(new QFile(path));
+    if (!entry->file->open(QFile::ReadOnly) || entry->file->size() < headerSize)
+        return nullptr;
+
+    const size_t fileSize = size_t(entry->file->size());
+    const uchar *data = entry->file->map(0, entry->file->size());
+    if (!data)
+        return nullptr;
+
+    const int levels = levelCount(size);
+    if (std::memcmp(data, ktxIdentifier, 12) != 0
+        || readU32(data + 12) != 0x04030201
+        || readU32(data + 28) != compressedFormat
+        || readU32(data + 36) != quint32(size.width())
+        || readU32(data + 40) != quint32(size.height())
+        || readU32(data + 48) > 1 || readU32(data + 52) != 1
+        || readU32(data + 56) != quint32(levels))
+        return nullptr;
+
+    // anahtar/değer verisinde kaynağın parmak izini ara
+    const size_t keyValueBytes = readU32(data + 60);
+    size_t offset = headerSize;
+    if (offset + keyValueBytes > fileSize)
+        return nullptr;
+
+    bool fresh = false;
+    const size_t keyValueEnd = offset + keyValueBytes;
+    while (offset + 4 <= keyValueEnd)
+    {
+        const size_t length = readU32(data + offset);
+        const char *pair = reinterpret_cast<const char *>(data + offset + 4);
+        if (offset + 4 + length > keyValueEnd)
+            break;
+        if (length >= sizeof(fingerprintKey) && std::memcmp(pair, fingerprintKey, sizeof(fingerprintKey)) == 0)
+            fresh = QByteArray(pair + sizeof(fingerprintKey), qsizetype(length - sizeof(fingerprintKey))) == sourceFingerprint;
+        offset += 4 + ((length + 3) & ~size_t(3));
+    }
+    if (!fresh)
+        return nullptr;
+
+    offset = keyValueEnd;
+    entry->payloadSize = 0;
+    int width = size.width(), height = size.height();
+    for (int i = 0; i < levels; ++i)
+    {
+        if (offset + 4 > fileSize)
+            return nullptr;
+        const size_t levelSize = readU32(data + offset);
+        offset += 4;
+        if (levelSize != levelByteSize(width, height) || offset + levelSize > fileSize)
+            return nullptr;
+
+        entry->levelOffsets.push_back(offset);
+        entry->levelSizes.push_back(levelSize);
+        entry->payloadSize += levelSize;
+        offset += (levelSize + 3) & ~size_t(3);
+
+        width = qMax(1, width / 2);
+        height = qMax(1, height / 2);
+    }
+
+    entry->data = data;
+    entry->width = size.width();
+    entry->height = size.height();
+    return entry;
+}
+
+void TextureCache::compressBC1(const QImage &rgb, QByteArray &out)
+{
+    const int width = rgb.width(), height = rgb.height();
+    const int blocksX = qMax(1, (width + 3) / 4), blocksY = qMax(1, (height + 3) / 4);
+    out.resize(qsizetype(levelByteSize(width, height)));
+
+    uchar *dst = reinterpret_cast<uchar *>(out.data());
+    uchar pixels[16][3];
+    for (int by = 0; by < blocksY; ++by)
+    {
+        for (int bx = 0; bx < blocksX; ++bx)
+        {
+            // 4'ten küçük seviyelerde kenar pikselleri tekrarlanır
+            for (int y = 0; y < 4; ++y)
+            {
+                const uchar *row = rgb.constScanLine(qMin(by * 4 + y, height - 1));
+                for (int x = 0; x < 4; ++x)
+                    std::memcpy(pixels[y * 4 + x], row + 3 * qMin(bx * 4 + x, width - 1), 3);
+            }
+            compressBlock(pixels, dst);
+            dst += 8;
+        }
+    }
+}
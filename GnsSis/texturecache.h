@@ -0,0 +1,50 @@
+#ifndef TEXTURECACHE_H
+#define TEXTURECACHE_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QImage>
+#include <QOpenGLFunctions>
+#include <QSize>
+#include <QString>
+
+#include <memory>
+#include <vector>
+
+// Yüzey dokularının önceden sıkıştırılmış (BC1/DXT1) ve tüm mipmap seviyeleri
+// hazır KTX 1.1 kopyaları. Dosyalar derleme sırasında TextureCacheBuilder ile
+// üretilir, çalışırken belleğe eşlenip (mmap) doğrudan GPU'ya yüklenir.
+class TextureCache
+{
+public:
+    // S3TC uzantısındaki GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+    static constexpr GLenum compressedFormat = 0x83F0;
+
+    struct Entry {
+        std::unique_ptr<QFile> file;
+        const uchar *data;
+        int width, height;
+        std::vector<size_t> levelOffsets;   // data içinde her seviyenin başlangıcı
+        std::vector<size_t> levelSizes;
+        size_t payloadSize;                 // tüm seviyelerin toplamı
+    };
+
+    // kaynak boyutuna göre dokunun yükleneceği çözünürlük sınıfı
+    static QSize classSize(const QSize &source);
+    static int levelCount(const QSize &size);
+
+    // kaynak dosyanın boyutu + ilk ve son 64 KB'ının özeti; önbellek bayatlığını anlamak için
+    static QByteArray fingerprint(const QString &fileName);
+
+    static QString directory();
+    static QString cachePath(const QString &sourceFile, const QString &cacheDirectory);
+
+    static bool write(const QString &path, const QImage &image, const QByteArray &sourceFingerprint);
+    // dosya yoksa, bozuksa ya da kaynak değişmişse nullptr döner
+    static std::unique_ptr<Entry> map(const QString &path, const QByteArray &sourceFingerprint, const QSize &size);
+
+private:
+    static void compressBC1(const QImage &rgb, QByteArray &out);
+};
+
+#endif // TEXTURECACHE_H
@@ -0,0 +1,48 @@
+// img/ altındaki yüzey dokularını BC1 sıkıştırılmış, mipmap'li KTX dosyalarına çevirir.
+// Kullanım: TextureCacheBuilder <çıktı klasörü> <görüntü>...
+#include "../texturecache.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QImage>
+
+#include <cstdio>
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    const QStringList args = app.arguments();
+    if (args.size() < 3)
+    {
+        std::fprintf(stderr, "usage: TextureCacheBuilder <output dir> <image>...\n");
+        return 1;
+    }
+
+    const QString outputDir = args[1];
+    QDir().mkpath(outputDir);
+
+    for (int i = 2; i < args.size(); ++i)
+    {
+        const QString source = args[i];
+        QImage image(source);
+        if (image.isNull())
+        {
+            std::fprintf(stderr, "cannot read %s\n", qPrintable(source));
+            return 1;
+        }
+
+        // çalışma anındaki yükleyiciyle aynı çözünürlük sınıfına örneklenir
+        const QSize size = TextureCache::classSize(image.size());
+        if (image.size() != size)
+            image = image.scaled(size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+
+        const QString output = TextureCache::cachePath(source, outputDir);
+        if (!TextureCache::write(output, image, TextureCache::fingerprint(source)))
+        {
+            std::fprintf(stderr, "cannot write %s\n", qPrintable(output));
+            return 1;
+        }
+        std::printf("%s -> %s (%dx%d)\n", qPrintable(source), qPrintable(output), size.width(), size.height());
+    }
+    return 0;
+}
@@ -0,0 +1,44 @@
+#ifndef TRIPLEBUFFER_H
+#define TRIPLEBUFFER_H
+
+#include <atomic>
+
+// Tek yazar ve tek okur arasında kilitsiz üçlü tampon. Yazar back() üzerinde çalışır ve
+// publish() ile onu ortadaki yuvayla değiştirir; okur acquire() ile ortadaki en yeni
+// yuvayı front() olarak alır. Hiçbir taraf beklemez: okur yetişemezse ara sürümler
+// atlanır, yazar yavaşsa okur son tamamlanan sürümü yeniden kullanır. Her yuvaya aynı anda
+// yalnızca bir taraf dokunur; değiş tokuşlar tek bir atomik tamsayı üzerinden yapılır.
+template <typename T>
+class TripleBuffer
+{
+public:
+    // yalnızca yazar
+    T &back() { return entries[backIndex]; }
+    void publish()
+    {
+        // release: back'e yazılanlar, yuvayı alan okura görünür
+        const int previous = middle.exchange(backIndex | freshBit, std::memory_order_acq_rel);
+        backIndex = previous & indexMask;
+    }
+
+    // yalnızca okur; yeni bir sürüm yoksa false ve front() değişmez
+    bool acquire()
+    {
+        if ((middle.load(std::memory_order_relaxed) & freshBit) == 0)
+            return false;
+        const int previous = middle.exchange(frontIndex, std::memory_order_acq_rel);
+        frontIndex = previous & indexMask;
+        return true;
+    }
+    T &front() { return entries[frontIndex]; }
+
+private:
+    static const int indexMask = 3, freshBit = 4;
+
+    T entries[3];
+    int backIndex = 0;                  // yazarın
+    std::atomic<int> middle { 1 };      // ortadaki yuva ve okunmamış işareti
+    int frontIndex = 2;                 // okurun
+};
+
+#endif // TRIPLEBUFFER_H